@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_assign_all.dir/test_assign_all.cxx.o"
+  "CMakeFiles/test_assign_all.dir/test_assign_all.cxx.o.d"
+  "test_assign_all"
+  "test_assign_all.pdb"
+  "test_assign_all[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_assign_all.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
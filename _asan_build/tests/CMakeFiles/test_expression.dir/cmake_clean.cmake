@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_expression.dir/test_expression.cxx.o"
+  "CMakeFiles/test_expression.dir/test_expression.cxx.o.d"
+  "test_expression"
+  "test_expression.pdb"
+  "test_expression[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_expression.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
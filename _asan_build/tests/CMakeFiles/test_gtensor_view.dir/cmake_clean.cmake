@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_gtensor_view.dir/test_gtensor_view.cxx.o"
+  "CMakeFiles/test_gtensor_view.dir/test_gtensor_view.cxx.o.d"
+  "test_gtensor_view"
+  "test_gtensor_view.pdb"
+  "test_gtensor_view[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_gtensor_view.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
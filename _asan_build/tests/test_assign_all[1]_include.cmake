@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_asan_build/tests/test_assign_all[1]_tests.cmake")
+  include("/root/repo/_asan_build/tests/test_assign_all[1]_tests.cmake")
+else()
+  add_test(test_assign_all_NOT_BUILT test_assign_all_NOT_BUILT)
+endif()
@@ -0,0 +1,11 @@
+add_test([=[banded.tridiagonal_shared]=]  /root/repo/_asan_build/tests/test_banded [==[--gtest_filter=banded.tridiagonal_shared]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[banded.tridiagonal_shared]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_asan_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[banded.tridiagonal_per_system]=]  /root/repo/_asan_build/tests/test_banded [==[--gtest_filter=banded.tridiagonal_per_system]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[banded.tridiagonal_per_system]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_asan_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[banded.banded]=]  /root/repo/_asan_build/tests/test_banded [==[--gtest_filter=banded.banded]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[banded.banded]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_asan_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[banded.many_systems]=]  /root/repo/_asan_build/tests/test_banded [==[--gtest_filter=banded.many_systems]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[banded.many_systems]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_asan_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[banded.fusion_scope]=]  /root/repo/_asan_build/tests/test_banded [==[--gtest_filter=banded.fusion_scope]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[banded.fusion_scope]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_asan_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  test_banded_TESTS banded.tridiagonal_shared banded.tridiagonal_per_system banded.banded banded.many_systems banded.fusion_scope)
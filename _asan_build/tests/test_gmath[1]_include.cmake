@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_asan_build/tests/test_gmath[1]_tests.cmake")
+  include("/root/repo/_asan_build/tests/test_gmath[1]_tests.cmake")
+else()
+  add_test(test_gmath_NOT_BUILT test_gmath_NOT_BUILT)
+endif()
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_asan_build/tests/test_stencil[1]_tests.cmake")
+  include("/root/repo/_asan_build/tests/test_stencil[1]_tests.cmake")
+else()
+  add_test(test_stencil_NOT_BUILT test_stencil_NOT_BUILT)
+endif()
@@ -0,0 +1,7 @@
+add_test([=[temporal_blocking.diffusion_1d]=]  /root/repo/_asan_build/tests/test_temporal_blocking [==[--gtest_filter=temporal_blocking.diffusion_1d]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[temporal_blocking.diffusion_1d]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_asan_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[temporal_blocking.stencil_radius_2]=]  /root/repo/_asan_build/tests/test_temporal_blocking [==[--gtest_filter=temporal_blocking.stencil_radius_2]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[temporal_blocking.stencil_radius_2]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_asan_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[temporal_blocking.jacobi_2d_launch]=]  /root/repo/_asan_build/tests/test_temporal_blocking [==[--gtest_filter=temporal_blocking.jacobi_2d_launch]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[temporal_blocking.jacobi_2d_launch]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_asan_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  test_temporal_blocking_TESTS temporal_blocking.diffusion_1d temporal_blocking.stencil_radius_2 temporal_blocking.jacobi_2d_launch)
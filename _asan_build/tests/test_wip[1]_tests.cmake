@@ -0,0 +1,3 @@
+add_test([=[gview.newaxis]=]  /root/repo/_asan_build/tests/test_wip [==[--gtest_filter=gview.newaxis]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gview.newaxis]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_asan_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  test_wip_TESTS gview.newaxis)
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_contract.dir/test_contract.cxx.o"
+  "CMakeFiles/test_contract.dir/test_contract.cxx.o.d"
+  "test_contract"
+  "test_contract.pdb"
+  "test_contract[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_contract.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_distributed.dir/test_distributed.cxx.o"
+  "CMakeFiles/test_distributed.dir/test_distributed.cxx.o.d"
+  "test_distributed"
+  "test_distributed.pdb"
+  "test_distributed[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_distributed.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_gtensor.dir/test_gtensor.cxx.o"
+  "CMakeFiles/test_gtensor.dir/test_gtensor.cxx.o.d"
+  "test_gtensor"
+  "test_gtensor.pdb"
+  "test_gtensor[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_gtensor.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
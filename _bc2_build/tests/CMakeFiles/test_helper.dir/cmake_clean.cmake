@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_helper.dir/test_helper.cxx.o"
+  "CMakeFiles/test_helper.dir/test_helper.cxx.o.d"
+  "test_helper"
+  "test_helper.pdb"
+  "test_helper[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_helper.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
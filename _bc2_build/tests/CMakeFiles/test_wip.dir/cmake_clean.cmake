@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_wip.dir/test_wip.cxx.o"
+  "CMakeFiles/test_wip.dir/test_wip.cxx.o.d"
+  "test_wip"
+  "test_wip.pdb"
+  "test_wip[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_wip.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
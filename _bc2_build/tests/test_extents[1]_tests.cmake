@@ -0,0 +1,11 @@
+add_test([=[extents.ctor]=]  /root/repo/_bc2_build/tests/test_extents [==[--gtest_filter=extents.ctor]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[extents.ctor]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[extents.static_extent]=]  /root/repo/_bc2_build/tests/test_extents [==[--gtest_filter=extents.static_extent]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[extents.static_extent]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[extents.strides]=]  /root/repo/_bc2_build/tests/test_extents [==[--gtest_filter=extents.strides]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[extents.strides]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[extents.gtensor]=]  /root/repo/_bc2_build/tests/test_extents [==[--gtest_filter=extents.gtensor]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[extents.gtensor]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[extents.gtensor_view]=]  /root/repo/_bc2_build/tests/test_extents [==[--gtest_filter=extents.gtensor_view]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[extents.gtensor_view]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  test_extents_TESTS extents.ctor extents.static_extent extents.strides extents.gtensor extents.gtensor_view)
@@ -0,0 +1,19 @@
+add_test([=[fusion.deferred]=]  /root/repo/_bc2_build/tests/test_fusion [==[--gtest_filter=fusion.deferred]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[fusion.deferred]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[fusion.sequence]=]  /root/repo/_bc2_build/tests/test_fusion [==[--gtest_filter=fusion.sequence]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[fusion.sequence]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[fusion.shifted]=]  /root/repo/_bc2_build/tests/test_fusion [==[--gtest_filter=fusion.shifted]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[fusion.shifted]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[fusion.temporary]=]  /root/repo/_bc2_build/tests/test_fusion [==[--gtest_filter=fusion.temporary]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[fusion.temporary]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[fusion.temporary_not_fusable]=]  /root/repo/_bc2_build/tests/test_fusion [==[--gtest_filter=fusion.temporary_not_fusable]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[fusion.temporary_not_fusable]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[fusion.construct]=]  /root/repo/_bc2_build/tests/test_fusion [==[--gtest_filter=fusion.construct]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[fusion.construct]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[fusion.flush]=]  /root/repo/_bc2_build/tests/test_fusion [==[--gtest_filter=fusion.flush]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[fusion.flush]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[fusion.flush_throws]=]  /root/repo/_bc2_build/tests/test_fusion [==[--gtest_filter=fusion.flush_throws]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[fusion.flush_throws]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[fusion.owned_operand]=]  /root/repo/_bc2_build/tests/test_fusion [==[--gtest_filter=fusion.owned_operand]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[fusion.owned_operand]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  test_fusion_TESTS fusion.deferred fusion.sequence fusion.shifted fusion.temporary fusion.temporary_not_fusable fusion.construct fusion.flush fusion.flush_throws fusion.owned_operand)
@@ -0,0 +1,9 @@
+add_test([=[ghosted.shapes]=]  /root/repo/_bc2_build/tests/test_ghosted [==[--gtest_filter=ghosted.shapes]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ghosted.shapes]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ghosted.interior_halo]=]  /root/repo/_bc2_build/tests/test_ghosted [==[--gtest_filter=ghosted.interior_halo]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ghosted.interior_halo]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ghosted.pack_unpack]=]  /root/repo/_bc2_build/tests/test_ghosted [==[--gtest_filter=ghosted.pack_unpack]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ghosted.pack_unpack]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ghosted.periodic_exchange]=]  /root/repo/_bc2_build/tests/test_ghosted [==[--gtest_filter=ghosted.periodic_exchange]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ghosted.periodic_exchange]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  test_ghosted_TESTS ghosted.shapes ghosted.interior_halo ghosted.pack_unpack ghosted.periodic_exchange)
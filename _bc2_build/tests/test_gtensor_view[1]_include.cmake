@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_bc2_build/tests/test_gtensor_view[1]_tests.cmake")
+  include("/root/repo/_bc2_build/tests/test_gtensor_view[1]_tests.cmake")
+else()
+  add_test(test_gtensor_view_NOT_BUILT test_gtensor_view_NOT_BUILT)
+endif()
@@ -0,0 +1,5 @@
+add_test([=[gtensor.ctor_init_2d]=]  /root/repo/_bc2_build/tests/test_gtensor_view [==[--gtest_filter=gtensor.ctor_init_2d]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gtensor.ctor_init_2d]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gtensor_adaptor.vector]=]  /root/repo/_bc2_build/tests/test_gtensor_view [==[--gtest_filter=gtensor_adaptor.vector]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gtensor_adaptor.vector]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  test_gtensor_view_TESTS gtensor.ctor_init_2d gtensor_adaptor.vector)
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_bc2_build/tests/test_temporal_blocking[1]_tests.cmake")
+  include("/root/repo/_bc2_build/tests/test_temporal_blocking[1]_tests.cmake")
+else()
+  add_test(test_temporal_blocking_NOT_BUILT test_temporal_blocking_NOT_BUILT)
+endif()
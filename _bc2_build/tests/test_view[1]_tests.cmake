@@ -0,0 +1,49 @@
+add_test([=[view.slice_all]=]  /root/repo/_bc2_build/tests/test_view [==[--gtest_filter=view.slice_all]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[view.slice_all]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[view.slice_descs]=]  /root/repo/_bc2_build/tests/test_view [==[--gtest_filter=view.slice_descs]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[view.slice_descs]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[view.slice_value]=]  /root/repo/_bc2_build/tests/test_view [==[--gtest_filter=view.slice_value]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[view.slice_value]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[view.slice_range]=]  /root/repo/_bc2_build/tests/test_view [==[--gtest_filter=view.slice_range]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[view.slice_range]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[view.slice_single_broadcast]=]  /root/repo/_bc2_build/tests/test_view [==[--gtest_filter=view.slice_single_broadcast]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[view.slice_single_broadcast]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[view.slice_out_of_range]=]  /root/repo/_bc2_build/tests/test_view [==[--gtest_filter=view.slice_out_of_range]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[view.slice_out_of_range]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[view.assign_shape_mismatch]=]  /root/repo/_bc2_build/tests/test_view [==[--gtest_filter=view.assign_shape_mismatch]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[view.assign_shape_mismatch]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[view.slice_missing]=]  /root/repo/_bc2_build/tests/test_view [==[--gtest_filter=view.slice_missing]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[view.slice_missing]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[view.assign]=]  /root/repo/_bc2_build/tests/test_view [==[--gtest_filter=view.assign]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[view.assign]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[view.reshape_view]=]  /root/repo/_bc2_build/tests/test_view [==[--gtest_filter=view.reshape_view]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[view.reshape_view]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[view.reshape_expression]=]  /root/repo/_bc2_build/tests/test_view [==[--gtest_filter=view.reshape_expression]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[view.reshape_expression]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gview.ownership]=]  /root/repo/_bc2_build/tests/test_view [==[--gtest_filter=gview.ownership]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gview.ownership]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gview.view_of_view]=]  /root/repo/_bc2_build/tests/test_view [==[--gtest_filter=gview.view_of_view]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gview.view_of_view]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gview.view_of_view_ownership]=]  /root/repo/_bc2_build/tests/test_view [==[--gtest_filter=gview.view_of_view_ownership]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gview.view_of_view_ownership]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gview.assign_overlap]=]  /root/repo/_bc2_build/tests/test_view [==[--gtest_filter=gview.assign_overlap]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gview.assign_overlap]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gview.assign_overlap_2d]=]  /root/repo/_bc2_build/tests/test_view [==[--gtest_filter=gview.assign_overlap_2d]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gview.assign_overlap_2d]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gview.assign_overlap_3d]=]  /root/repo/_bc2_build/tests/test_view [==[--gtest_filter=gview.assign_overlap_3d]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gview.assign_overlap_3d]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gview.noalias]=]  /root/repo/_bc2_build/tests/test_view [==[--gtest_filter=gview.noalias]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gview.noalias]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gview.assign_all]=]  /root/repo/_bc2_build/tests/test_view [==[--gtest_filter=gview.assign_all]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gview.assign_all]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gview.assign_sub]=]  /root/repo/_bc2_build/tests/test_view [==[--gtest_filter=gview.assign_sub]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gview.assign_sub]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gview.newaxis]=]  /root/repo/_bc2_build/tests/test_view [==[--gtest_filter=gview.newaxis]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gview.newaxis]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gview.expression_all]=]  /root/repo/_bc2_build/tests/test_view [==[--gtest_filter=gview.expression_all]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gview.expression_all]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gview.expression_sub]=]  /root/repo/_bc2_build/tests/test_view [==[--gtest_filter=gview.expression_sub]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gview.expression_sub]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gview.swapaxes_expression]=]  /root/repo/_bc2_build/tests/test_view [==[--gtest_filter=gview.swapaxes_expression]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gview.swapaxes_expression]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_bc2_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  test_view_TESTS view.slice_all view.slice_descs view.slice_value view.slice_range view.slice_single_broadcast view.slice_out_of_range view.assign_shape_mismatch view.slice_missing view.assign view.reshape_view view.reshape_expression gview.ownership gview.view_of_view gview.view_of_view_ownership gview.assign_overlap gview.assign_overlap_2d gview.assign_overlap_3d gview.noalias gview.assign_all gview.assign_sub gview.newaxis gview.expression_all gview.expression_sub gview.swapaxes_expression)
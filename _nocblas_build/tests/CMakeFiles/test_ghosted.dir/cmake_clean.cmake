@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_ghosted.dir/test_ghosted.cxx.o"
+  "CMakeFiles/test_ghosted.dir/test_ghosted.cxx.o.d"
+  "test_ghosted"
+  "test_ghosted.pdb"
+  "test_ghosted[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_ghosted.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
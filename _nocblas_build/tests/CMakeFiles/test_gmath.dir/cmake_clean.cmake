@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_gmath.dir/test_gmath.cxx.o"
+  "CMakeFiles/test_gmath.dir/test_gmath.cxx.o.d"
+  "test_gmath"
+  "test_gmath.pdb"
+  "test_gmath[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_gmath.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_stepper.dir/test_stepper.cxx.o"
+  "CMakeFiles/test_stepper.dir/test_stepper.cxx.o.d"
+  "test_stepper"
+  "test_stepper.pdb"
+  "test_stepper[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_stepper.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
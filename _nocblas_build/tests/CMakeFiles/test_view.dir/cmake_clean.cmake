@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_view.dir/test_view.cxx.o"
+  "CMakeFiles/test_view.dir/test_view.cxx.o.d"
+  "test_view"
+  "test_view.pdb"
+  "test_view[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_view.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+add_test([=[assign_all.two_outputs]=]  /root/repo/_nocblas_build/tests/test_assign_all [==[--gtest_filter=assign_all.two_outputs]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[assign_all.two_outputs]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[assign_all.views_and_broadcast]=]  /root/repo/_nocblas_build/tests/test_assign_all [==[--gtest_filter=assign_all.views_and_broadcast]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[assign_all.views_and_broadcast]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[assign_all.in_place]=]  /root/repo/_nocblas_build/tests/test_assign_all [==[--gtest_filter=assign_all.in_place]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[assign_all.in_place]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[assign_all.overlap]=]  /root/repo/_nocblas_build/tests/test_assign_all [==[--gtest_filter=assign_all.overlap]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[assign_all.overlap]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[assign_all.shape_mismatch]=]  /root/repo/_nocblas_build/tests/test_assign_all [==[--gtest_filter=assign_all.shape_mismatch]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[assign_all.shape_mismatch]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  test_assign_all_TESTS assign_all.two_outputs assign_all.views_and_broadcast assign_all.in_place assign_all.overlap assign_all.shape_mismatch)
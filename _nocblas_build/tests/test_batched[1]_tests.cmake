@@ -0,0 +1,9 @@
+add_test([=[batched.matmul]=]  /root/repo/_nocblas_build/tests/test_batched [==[--gtest_filter=batched.matmul]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[batched.matmul]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[batched.matvec]=]  /root/repo/_nocblas_build/tests/test_batched [==[--gtest_filter=batched.matvec]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[batched.matvec]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[batched.lu_solve]=]  /root/repo/_nocblas_build/tests/test_batched [==[--gtest_filter=batched.lu_solve]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[batched.lu_solve]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[batched.lu_singular]=]  /root/repo/_nocblas_build/tests/test_batched [==[--gtest_filter=batched.lu_singular]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[batched.lu_singular]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  test_batched_TESTS batched.matmul batched.matvec batched.lu_solve batched.lu_singular)
@@ -0,0 +1,15 @@
+add_test([=[contract.tensordot_matmul]=]  /root/repo/_nocblas_build/tests/test_contract [==[--gtest_filter=contract.tensordot_matmul]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[contract.tensordot_matmul]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[contract.tensordot_mixed_axes]=]  /root/repo/_nocblas_build/tests/test_contract [==[--gtest_filter=contract.tensordot_mixed_axes]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[contract.tensordot_mixed_axes]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[contract.tensordot_views_and_expressions]=]  /root/repo/_nocblas_build/tests/test_contract [==[--gtest_filter=contract.tensordot_views_and_expressions]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[contract.tensordot_views_and_expressions]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[contract.einsum]=]  /root/repo/_nocblas_build/tests/test_contract [==[--gtest_filter=contract.einsum]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[contract.einsum]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[contract.einsum_batched]=]  /root/repo/_nocblas_build/tests/test_contract [==[--gtest_filter=contract.einsum_batched]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[contract.einsum_batched]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[contract.einsum_errors]=]  /root/repo/_nocblas_build/tests/test_contract [==[--gtest_filter=contract.einsum_errors]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[contract.einsum_errors]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[contract.fusion_scope]=]  /root/repo/_nocblas_build/tests/test_contract [==[--gtest_filter=contract.fusion_scope]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[contract.fusion_scope]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  test_contract_TESTS contract.tensordot_matmul contract.tensordot_mixed_axes contract.tensordot_views_and_expressions contract.einsum contract.einsum_batched contract.einsum_errors contract.fusion_scope)
@@ -0,0 +1,11 @@
+add_test([=[distributed.decomposition]=]  /root/repo/_nocblas_build/tests/test_distributed [==[--gtest_filter=distributed.decomposition]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[distributed.decomposition]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[distributed.exchange_halos]=]  /root/repo/_nocblas_build/tests/test_distributed [==[--gtest_filter=distributed.exchange_halos]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[distributed.exchange_halos]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[distributed.exchange_halos_periodic]=]  /root/repo/_nocblas_build/tests/test_distributed [==[--gtest_filter=distributed.exchange_halos_periodic]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[distributed.exchange_halos_periodic]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[distributed.exchange_halos_async]=]  /root/repo/_nocblas_build/tests/test_distributed [==[--gtest_filter=distributed.exchange_halos_async]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[distributed.exchange_halos_async]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[distributed.exchange_halos_3d]=]  /root/repo/_nocblas_build/tests/test_distributed [==[--gtest_filter=distributed.exchange_halos_3d]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[distributed.exchange_halos_3d]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  test_distributed_TESTS distributed.decomposition distributed.exchange_halos distributed.exchange_halos_periodic distributed.exchange_halos_async distributed.exchange_halos_3d)
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_nocblas_build/tests/test_expression[1]_tests.cmake")
+  include("/root/repo/_nocblas_build/tests/test_expression[1]_tests.cmake")
+else()
+  add_test(test_expression_NOT_BUILT test_expression_NOT_BUILT)
+endif()
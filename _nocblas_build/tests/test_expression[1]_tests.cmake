@@ -0,0 +1,25 @@
+add_test([=[expression.member_t]=]  /root/repo/_nocblas_build/tests/test_expression [==[--gtest_filter=expression.member_t]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[expression.member_t]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[expression.space_t]=]  /root/repo/_nocblas_build/tests/test_expression [==[--gtest_filter=expression.space_t]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[expression.space_t]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[expression.forward]=]  /root/repo/_nocblas_build/tests/test_expression [==[--gtest_filter=expression.forward]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[expression.forward]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[expression.gfunction]=]  /root/repo/_nocblas_build/tests/test_expression [==[--gtest_filter=expression.gfunction]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[expression.gfunction]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[expression.shape_same]=]  /root/repo/_nocblas_build/tests/test_expression [==[--gtest_filter=expression.shape_same]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[expression.shape_same]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[expression.shape_first]=]  /root/repo/_nocblas_build/tests/test_expression [==[--gtest_filter=expression.shape_first]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[expression.shape_first]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[expression.shape_second]=]  /root/repo/_nocblas_build/tests/test_expression [==[--gtest_filter=expression.shape_second]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[expression.shape_second]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[expression.shape_nested]=]  /root/repo/_nocblas_build/tests/test_expression [==[--gtest_filter=expression.shape_nested]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[expression.shape_nested]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[expression.shape_broadcast_error]=]  /root/repo/_nocblas_build/tests/test_expression [==[--gtest_filter=expression.shape_broadcast_error]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[expression.shape_broadcast_error]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[shape.broadcast_same]=]  /root/repo/_nocblas_build/tests/test_expression [==[--gtest_filter=shape.broadcast_same]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[shape.broadcast_same]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[shape.broadcast_first]=]  /root/repo/_nocblas_build/tests/test_expression [==[--gtest_filter=shape.broadcast_first]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[shape.broadcast_first]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[shape.broadcast_second]=]  /root/repo/_nocblas_build/tests/test_expression [==[--gtest_filter=shape.broadcast_second]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[shape.broadcast_second]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  test_expression_TESTS expression.member_t expression.space_t expression.forward expression.gfunction expression.shape_same expression.shape_first expression.shape_second expression.shape_nested expression.shape_broadcast_error shape.broadcast_same shape.broadcast_first shape.broadcast_second)
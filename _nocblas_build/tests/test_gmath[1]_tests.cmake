@@ -0,0 +1,23 @@
+add_test([=[gmath.lazy]=]  /root/repo/_nocblas_build/tests/test_gmath [==[--gtest_filter=gmath.lazy]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gmath.lazy]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gmath.real_double]=]  /root/repo/_nocblas_build/tests/test_gmath [==[--gtest_filter=gmath.real_double]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gmath.real_double]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gmath.real_float]=]  /root/repo/_nocblas_build/tests/test_gmath [==[--gtest_filter=gmath.real_float]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gmath.real_float]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gmath.special_values]=]  /root/repo/_nocblas_build/tests/test_gmath [==[--gtest_filter=gmath.special_values]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gmath.special_values]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gmath.sin_cos_large]=]  /root/repo/_nocblas_build/tests/test_gmath [==[--gtest_filter=gmath.sin_cos_large]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gmath.sin_cos_large]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gmath.pow]=]  /root/repo/_nocblas_build/tests/test_gmath [==[--gtest_filter=gmath.pow]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gmath.pow]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gmath.pow_int]=]  /root/repo/_nocblas_build/tests/test_gmath [==[--gtest_filter=gmath.pow_int]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gmath.pow_int]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gmath.polyval]=]  /root/repo/_nocblas_build/tests/test_gmath [==[--gtest_filter=gmath.polyval]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gmath.polyval]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gmath.complex]=]  /root/repo/_nocblas_build/tests/test_gmath [==[--gtest_filter=gmath.complex]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gmath.complex]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gmath.real_imag_conj_of_real]=]  /root/repo/_nocblas_build/tests/test_gmath [==[--gtest_filter=gmath.real_imag_conj_of_real]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gmath.real_imag_conj_of_real]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gmath.views_and_generic_types]=]  /root/repo/_nocblas_build/tests/test_gmath [==[--gtest_filter=gmath.views_and_generic_types]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gmath.views_and_generic_types]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  test_gmath_TESTS gmath.lazy gmath.real_double gmath.real_float gmath.special_values gmath.sin_cos_large gmath.pow gmath.pow_int gmath.polyval gmath.complex gmath.real_imag_conj_of_real gmath.views_and_generic_types)
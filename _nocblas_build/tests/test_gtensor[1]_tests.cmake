@@ -0,0 +1,41 @@
+add_test([=[shape_type.ctor_args]=]  /root/repo/_nocblas_build/tests/test_gtensor [==[--gtest_filter=shape_type.ctor_args]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[shape_type.ctor_args]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gtensor.ctor_default]=]  /root/repo/_nocblas_build/tests/test_gtensor [==[--gtest_filter=gtensor.ctor_default]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gtensor.ctor_default]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gtensor.ctor_shape]=]  /root/repo/_nocblas_build/tests/test_gtensor [==[--gtest_filter=gtensor.ctor_shape]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gtensor.ctor_shape]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gtensor.ctor_from_expr]=]  /root/repo/_nocblas_build/tests/test_gtensor [==[--gtest_filter=gtensor.ctor_from_expr]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gtensor.ctor_from_expr]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gtensor.ctor_init_1d]=]  /root/repo/_nocblas_build/tests/test_gtensor [==[--gtest_filter=gtensor.ctor_init_1d]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gtensor.ctor_init_1d]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gtensor.ctor_init_2d]=]  /root/repo/_nocblas_build/tests/test_gtensor [==[--gtest_filter=gtensor.ctor_init_2d]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gtensor.ctor_init_2d]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gtensor.op_equal]=]  /root/repo/_nocblas_build/tests/test_gtensor [==[--gtest_filter=gtensor.op_equal]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gtensor.op_equal]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gtensor.empty_like]=]  /root/repo/_nocblas_build/tests/test_gtensor [==[--gtest_filter=gtensor.empty_like]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gtensor.empty_like]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gtensor.copy_ctor]=]  /root/repo/_nocblas_build/tests/test_gtensor [==[--gtest_filter=gtensor.copy_ctor]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gtensor.copy_ctor]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gtensor.move_ctor]=]  /root/repo/_nocblas_build/tests/test_gtensor [==[--gtest_filter=gtensor.move_ctor]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gtensor.move_ctor]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gtensor.copy_assign]=]  /root/repo/_nocblas_build/tests/test_gtensor [==[--gtest_filter=gtensor.copy_assign]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gtensor.copy_assign]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gtensor.move_assign]=]  /root/repo/_nocblas_build/tests/test_gtensor [==[--gtest_filter=gtensor.move_assign]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gtensor.move_assign]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gtensor.assign_expression_1d]=]  /root/repo/_nocblas_build/tests/test_gtensor [==[--gtest_filter=gtensor.assign_expression_1d]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gtensor.assign_expression_1d]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gtensor.assign_expression_2d]=]  /root/repo/_nocblas_build/tests/test_gtensor [==[--gtest_filter=gtensor.assign_expression_2d]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gtensor.assign_expression_2d]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gtensor.eval_lvalue]=]  /root/repo/_nocblas_build/tests/test_gtensor [==[--gtest_filter=gtensor.eval_lvalue]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gtensor.eval_lvalue]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gtensor.eval_rvalue]=]  /root/repo/_nocblas_build/tests/test_gtensor [==[--gtest_filter=gtensor.eval_rvalue]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gtensor.eval_rvalue]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gtensor.eval_expr]=]  /root/repo/_nocblas_build/tests/test_gtensor [==[--gtest_filter=gtensor.eval_expr]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gtensor.eval_expr]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gtensor.assign_expression_2d_resize]=]  /root/repo/_nocblas_build/tests/test_gtensor [==[--gtest_filter=gtensor.assign_expression_2d_resize]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gtensor.assign_expression_2d_resize]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gtensor.compound_assign]=]  /root/repo/_nocblas_build/tests/test_gtensor [==[--gtest_filter=gtensor.compound_assign]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gtensor.compound_assign]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gtensor.compound_assign_view]=]  /root/repo/_nocblas_build/tests/test_gtensor [==[--gtest_filter=gtensor.compound_assign_view]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gtensor.compound_assign_view]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  test_gtensor_TESTS shape_type.ctor_args gtensor.ctor_default gtensor.ctor_shape gtensor.ctor_from_expr gtensor.ctor_init_1d gtensor.ctor_init_2d gtensor.op_equal gtensor.empty_like gtensor.copy_ctor gtensor.move_ctor gtensor.copy_assign gtensor.move_assign gtensor.assign_expression_1d gtensor.assign_expression_2d gtensor.eval_lvalue gtensor.eval_rvalue gtensor.eval_expr gtensor.assign_expression_2d_resize gtensor.compound_assign gtensor.compound_assign_view)
@@ -0,0 +1,7 @@
+add_test([=[helper.tuple_max]=]  /root/repo/_nocblas_build/tests/test_helper [==[--gtest_filter=helper.tuple_max]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[helper.tuple_max]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[helper.fast_divider]=]  /root/repo/_nocblas_build/tests/test_helper [==[--gtest_filter=helper.fast_divider]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[helper.fast_divider]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[helper.unravel_fast_divider]=]  /root/repo/_nocblas_build/tests/test_helper [==[--gtest_filter=helper.unravel_fast_divider]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[helper.unravel_fast_divider]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  test_helper_TESTS helper.tuple_max helper.fast_divider helper.unravel_fast_divider)
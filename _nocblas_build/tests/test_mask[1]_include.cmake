@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_nocblas_build/tests/test_mask[1]_tests.cmake")
+  include("/root/repo/_nocblas_build/tests/test_mask[1]_tests.cmake")
+else()
+  add_test(test_mask_NOT_BUILT test_mask_NOT_BUILT)
+endif()
@@ -0,0 +1,13 @@
+add_test([=[stencil.stencil_1d]=]  /root/repo/_nocblas_build/tests/test_stencil [==[--gtest_filter=stencil.stencil_1d]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[stencil.stencil_1d]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[stencil.coeffs_array]=]  /root/repo/_nocblas_build/tests/test_stencil [==[--gtest_filter=stencil.coeffs_array]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[stencil.coeffs_array]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[stencil.stencil_2d_axis]=]  /root/repo/_nocblas_build/tests/test_stencil [==[--gtest_filter=stencil.stencil_2d_axis]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[stencil.stencil_2d_axis]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[stencil.stencil_4d]=]  /root/repo/_nocblas_build/tests/test_stencil [==[--gtest_filter=stencil.stencil_4d]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[stencil.stencil_4d]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[stencil.view]=]  /root/repo/_nocblas_build/tests/test_stencil [==[--gtest_filter=stencil.view]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[stencil.view]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[stencil.broadcast]=]  /root/repo/_nocblas_build/tests/test_stencil [==[--gtest_filter=stencil.broadcast]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[stencil.broadcast]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  test_stencil_TESTS stencil.stencil_1d stencil.coeffs_array stencil.stencil_2d_axis stencil.stencil_4d stencil.view stencil.broadcast)
@@ -0,0 +1,17 @@
+add_test([=[stepper.strided]=]  /root/repo/_nocblas_build/tests/test_stepper [==[--gtest_filter=stepper.strided]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[stepper.strided]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[stepper.boundscheck_level]=]  /root/repo/_nocblas_build/tests/test_stepper [==[--gtest_filter=stepper.boundscheck_level]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[stepper.boundscheck_level]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[stepper.function]=]  /root/repo/_nocblas_build/tests/test_stepper [==[--gtest_filter=stepper.function]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[stepper.function]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[stepper.advance]=]  /root/repo/_nocblas_build/tests/test_stepper [==[--gtest_filter=stepper.advance]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[stepper.advance]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[stepper.assign_4d]=]  /root/repo/_nocblas_build/tests/test_stepper [==[--gtest_filter=stepper.assign_4d]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[stepper.assign_4d]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[stepper.assign_5d]=]  /root/repo/_nocblas_build/tests/test_stepper [==[--gtest_filter=stepper.assign_5d]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[stepper.assign_5d]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[stepper.assign_6d_view]=]  /root/repo/_nocblas_build/tests/test_stepper [==[--gtest_filter=stepper.assign_6d_view]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[stepper.assign_6d_view]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[stepper.assign_broadcast]=]  /root/repo/_nocblas_build/tests/test_stepper [==[--gtest_filter=stepper.assign_broadcast]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[stepper.assign_broadcast]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_nocblas_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  test_stepper_TESTS stepper.strided stepper.boundscheck_level stepper.function stepper.advance stepper.assign_4d stepper.assign_5d stepper.assign_6d_view stepper.assign_broadcast)
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_banded.dir/test_banded.cxx.o"
+  "CMakeFiles/test_banded.dir/test_banded.cxx.o.d"
+  "test_banded"
+  "test_banded.pdb"
+  "test_banded[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_banded.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_temporal_blocking.dir/test_temporal_blocking.cxx.o"
+  "CMakeFiles/test_temporal_blocking.dir/test_temporal_blocking.cxx.o.d"
+  "test_temporal_blocking"
+  "test_temporal_blocking.pdb"
+  "test_temporal_blocking[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_temporal_blocking.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,28 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/tests
+# Build directory: /root/repo/_warn_build/tests
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+include("/root/repo/_warn_build/tests/test_expression[1]_include.cmake")
+include("/root/repo/_warn_build/tests/test_helper[1]_include.cmake")
+include("/root/repo/_warn_build/tests/test_gtensor[1]_include.cmake")
+include("/root/repo/_warn_build/tests/test_gtensor_view[1]_include.cmake")
+include("/root/repo/_warn_build/tests/test_view[1]_include.cmake")
+include("/root/repo/_warn_build/tests/test_stream[1]_include.cmake")
+include("/root/repo/_warn_build/tests/test_extents[1]_include.cmake")
+include("/root/repo/_warn_build/tests/test_stepper[1]_include.cmake")
+include("/root/repo/_warn_build/tests/test_assign_all[1]_include.cmake")
+include("/root/repo/_warn_build/tests/test_fusion[1]_include.cmake")
+include("/root/repo/_warn_build/tests/test_stencil[1]_include.cmake")
+include("/root/repo/_warn_build/tests/test_temporal_blocking[1]_include.cmake")
+include("/root/repo/_warn_build/tests/test_ghosted[1]_include.cmake")
+include("/root/repo/_warn_build/tests/test_distributed[1]_include.cmake")
+include("/root/repo/_warn_build/tests/test_gemm[1]_include.cmake")
+include("/root/repo/_warn_build/tests/test_batched[1]_include.cmake")
+include("/root/repo/_warn_build/tests/test_banded[1]_include.cmake")
+include("/root/repo/_warn_build/tests/test_fft[1]_include.cmake")
+include("/root/repo/_warn_build/tests/test_contract[1]_include.cmake")
+include("/root/repo/_warn_build/tests/test_gmath[1]_include.cmake")
+include("/root/repo/_warn_build/tests/test_mask[1]_include.cmake")
+include("/root/repo/_warn_build/tests/test_wip[1]_include.cmake")
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_warn_build/tests/test_contract[1]_tests.cmake")
+  include("/root/repo/_warn_build/tests/test_contract[1]_tests.cmake")
+else()
+  add_test(test_contract_NOT_BUILT test_contract_NOT_BUILT)
+endif()
@@ -0,0 +1,15 @@
+add_test([=[fft.lengths]=]  /root/repo/_warn_build/tests/test_fft [==[--gtest_filter=fft.lengths]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[fft.lengths]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[fft.many_lines]=]  /root/repo/_warn_build/tests/test_fft [==[--gtest_filter=fft.many_lines]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[fft.many_lines]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[fft.views_and_expressions]=]  /root/repo/_warn_build/tests/test_fft [==[--gtest_filter=fft.views_and_expressions]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[fft.views_and_expressions]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[fft.fusion_scope]=]  /root/repo/_warn_build/tests/test_fft [==[--gtest_filter=fft.fusion_scope]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[fft.fusion_scope]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[fft.rfft]=]  /root/repo/_warn_build/tests/test_fft [==[--gtest_filter=fft.rfft]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[fft.rfft]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[fft.float_type]=]  /root/repo/_warn_build/tests/test_fft [==[--gtest_filter=fft.float_type]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[fft.float_type]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[fft.higher_dimensions]=]  /root/repo/_warn_build/tests/test_fft [==[--gtest_filter=fft.higher_dimensions]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[fft.higher_dimensions]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  test_fft_TESTS fft.lengths fft.many_lines fft.views_and_expressions fft.fusion_scope fft.rfft fft.float_type fft.higher_dimensions)
@@ -0,0 +1,17 @@
+add_test([=[gemm.matmul]=]  /root/repo/_warn_build/tests/test_gemm [==[--gtest_filter=gemm.matmul]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gemm.matmul]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gemm.alpha_beta]=]  /root/repo/_warn_build/tests/test_gemm [==[--gtest_filter=gemm.alpha_beta]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gemm.alpha_beta]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gemm.strided_views]=]  /root/repo/_warn_build/tests/test_gemm [==[--gtest_filter=gemm.strided_views]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gemm.strided_views]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gemm.transposed]=]  /root/repo/_warn_build/tests/test_gemm [==[--gtest_filter=gemm.transposed]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gemm.transposed]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gemm.expressions]=]  /root/repo/_warn_build/tests/test_gemm [==[--gtest_filter=gemm.expressions]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gemm.expressions]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gemm.float_type]=]  /root/repo/_warn_build/tests/test_gemm [==[--gtest_filter=gemm.float_type]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gemm.float_type]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gemm.aliasing]=]  /root/repo/_warn_build/tests/test_gemm [==[--gtest_filter=gemm.aliasing]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gemm.aliasing]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[gemm.fusion_scope]=]  /root/repo/_warn_build/tests/test_gemm [==[--gtest_filter=gemm.fusion_scope]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[gemm.fusion_scope]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  test_gemm_TESTS gemm.matmul gemm.alpha_beta gemm.strided_views gemm.transposed gemm.expressions gemm.float_type gemm.aliasing gemm.fusion_scope)
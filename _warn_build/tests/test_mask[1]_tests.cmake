@@ -0,0 +1,23 @@
+add_test([=[mask.comparisons]=]  /root/repo/_warn_build/tests/test_mask [==[--gtest_filter=mask.comparisons]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[mask.comparisons]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[mask.logical]=]  /root/repo/_warn_build/tests/test_mask [==[--gtest_filter=mask.logical]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[mask.logical]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[mask.where]=]  /root/repo/_warn_build/tests/test_mask [==[--gtest_filter=mask.where]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[mask.where]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[mask.any_all]=]  /root/repo/_warn_build/tests/test_mask [==[--gtest_filter=mask.any_all]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[mask.any_all]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[mask.any_all_big]=]  /root/repo/_warn_build/tests/test_mask [==[--gtest_filter=mask.any_all_big]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[mask.any_all_big]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[mask.compress]=]  /root/repo/_warn_build/tests/test_mask [==[--gtest_filter=mask.compress]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[mask.compress]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[mask.nonzero]=]  /root/repo/_warn_build/tests/test_mask [==[--gtest_filter=mask.nonzero]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[mask.nonzero]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[mask.masked]=]  /root/repo/_warn_build/tests/test_mask [==[--gtest_filter=mask.masked]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[mask.masked]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[mask.big]=]  /root/repo/_warn_build/tests/test_mask [==[--gtest_filter=mask.big]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[mask.big]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[mask.thin_outer]=]  /root/repo/_warn_build/tests/test_mask [==[--gtest_filter=mask.thin_outer]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[mask.thin_outer]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[mask.masked_fusion_scope]=]  /root/repo/_warn_build/tests/test_mask [==[--gtest_filter=mask.masked_fusion_scope]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[mask.masked_fusion_scope]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  test_mask_TESTS mask.comparisons mask.logical mask.where mask.any_all mask.any_all_big mask.compress mask.nonzero mask.masked mask.big mask.thin_outer mask.masked_fusion_scope)
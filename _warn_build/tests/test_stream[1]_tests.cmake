@@ -0,0 +1,9 @@
+add_test([=[stream.file_roundtrip]=]  /root/repo/_warn_build/tests/test_stream [==[--gtest_filter=stream.file_roundtrip]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[stream.file_roundtrip]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[stream.stream_eval]=]  /root/repo/_warn_build/tests/test_stream [==[--gtest_filter=stream.stream_eval]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[stream.stream_eval]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[stream.shape_mismatch]=]  /root/repo/_warn_build/tests/test_stream [==[--gtest_filter=stream.shape_mismatch]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[stream.shape_mismatch]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[stream.stream_eval_in_fusion_scope]=]  /root/repo/_warn_build/tests/test_stream [==[--gtest_filter=stream.stream_eval_in_fusion_scope]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[stream.stream_eval_in_fusion_scope]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  test_stream_TESTS stream.file_roundtrip stream.stream_eval stream.shape_mismatch stream.stream_eval_in_fusion_scope)
@@ -28,41 +28,21 @@ using namespace std;
 // _s for gt::gslice
 using namespace gt::placeholders;
 
-static const gt::gtensor<double, 1> stencil3 = { -0.5, 0.0, 0.5 };
-static const gt::gtensor<double, 1> stencil5 = { 1.0/12.0, -2.0/3.0, 0.0,
-                                                 2.0/3.0 , -1.0/12.0 };
-static const gt::gtensor<double, 1> stencil7 = { -1.0/60.0, 3.0/20.0, -3.0/4.0, 0.0,
-                                                  3.0/4.0, -3.0/20.0, 1.0/60.0 };
-
-inline auto stencil1d_3(const gt::gtensor<double, 1> &y,
-                        const gt::gtensor<double, 1> &stencil)
-{
-      return stencil(0) * y.view(_s(0, -2)) +
-             stencil(1) * y.view(_s(1, -1)) +
-             stencil(2) * y.view(_s(2,  _));
-}
-
-inline auto stencil1d_5(const gt::gtensor<double, 1> &y,
-                        const gt::gtensor<double, 1> &stencil)
-{
-      return stencil(0) * y.view(_s(0, -4)) +
-             stencil(1) * y.view(_s(1, -3)) +
-             stencil(2) * y.view(_s(2, -2)) +
-             stencil(3) * y.view(_s(3, -1)) +
-             stencil(4) * y.view(_s(4,  _));
-}
-
-inline auto stencil1d_7(const gt::gtensor<double, 1> &y,
-                        const gt::gtensor<double, 1> &stencil)
-{
-      return stencil(0) * y.view(_s(0, -6)) +
-             stencil(1) * y.view(_s(1, -5)) +
-             stencil(2) * y.view(_s(2, -4)) +
-             stencil(3) * y.view(_s(3, -3)) +
-             stencil(4) * y.view(_s(4, -2)) +
-             stencil(5) * y.view(_s(5, -1)) +
-             stencil(6) * y.view(_s(6,  _));
-}
+// coefficients for centered first derivatives of 2nd, 4th and 6th order
+static const gt::sarray<double, 3> stencil3 = { -0.5, 0.0, 0.5 };
+static const gt::sarray<double, 5> stencil5 = { 1.0/12.0, -2.0/3.0, 0.0,
+                                                2.0/3.0 , -1.0/12.0 };
+static const gt::sarray<double, 7> stencil7 = { -1.0/60.0, 3.0/20.0, -3.0/4.0, 0.0,
+                                                 3.0/4.0, -3.0/20.0, 1.0/60.0 };
+
+// gt::stencil(y, coeffs) is the sum of coeffs[k] * y shifted by k, i.e.,
+// for 3 points the same as
+//
+//   stencil(0) * y.view(_s(0, -2)) +
+//   stencil(1) * y.view(_s(1, -1)) +
+//   stencil(2) * y.view(_s(2,  _))
+//
+// but evaluated in one pass over y rather than as separate shifted views.
 
 void test_stencils(int n, double dx,
                    double (*fn)(double), double (*dydx)(double))
@@ -85,19 +65,19 @@ void test_stencils(int n, double dx,
     cout << "dydx_analytic = " << dydx_analytic << endl;
 
     cout << endl;
-    dydx_numeric_3 = stencil1d_3(y, stencil3) / dx;
+    dydx_numeric_3 = gt::stencil(y, stencil3) / dx;
     cout << "dydx_numeric3 =   " << dydx_numeric_3 << endl;
     cout << "err 3         =   " 
          << dydx_analytic.view(_s(1, -1)) - dydx_numeric_3 << endl;
 
     cout << endl;
-    dydx_numeric_5 = stencil1d_5(y, stencil5) / dx;
+    dydx_numeric_5 = gt::stencil(y, stencil5) / dx;
     cout << "dydx_numeric5 =     " << dydx_numeric_5 << endl;
     cout << "err 5         =     " 
          << dydx_analytic.view(_s(2, -2)) - dydx_numeric_5 << endl;
 
     cout << endl;
-    dydx_numeric_7 = stencil1d_7(y, stencil7) / dx;
+    dydx_numeric_7 = gt::stencil(y, stencil7) / dx;
     cout << "dydx_numeric7 =     " << dydx_numeric_7 << endl;
     cout << "err 7         =     " 
          << dydx_analytic.view(_s(3, -3)) - dydx_numeric_7 << endl;
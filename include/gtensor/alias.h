@@ -0,0 +1,292 @@
+
+// ======================================================================
+// alias.h
+//
+// overlap analysis between the lhs and rhs of an assignment
+
+#ifndef GTENSOR_ALIAS_H
+#define GTENSOR_ALIAS_H
+
+#include "defs.h"
+#include "expression.h"
+#include "sarray.h"
+
+#include <cstddef>
+
+namespace gt
+{
+
+namespace detail
+{
+
+// ======================================================================
+// alias_layout
+//
+// memory touched by a leaf expression that has storage: the byte range
+// [lo, hi), and, if `exact`, the mapping of the (lhs) index space to
+// addresses, base + strides . idx, with strides in bytes.
+
+template <size_type N>
+struct alias_layout
+{
+  const char* lo = nullptr;
+  const char* hi = nullptr;
+  const char* base = nullptr;
+  sarray<std::ptrdiff_t, N> strides;
+  bool exact = false;
+};
+
+template <typename P>
+inline const char* raw_address(P p)
+{
+#ifdef GTENSOR_HAVE_DEVICE
+  return reinterpret_cast<const char*>(thrust::raw_pointer_cast(p));
+#else
+  return reinterpret_cast<const char*>(p);
+#endif
+}
+
+template <size_type N, typename S, typename ST>
+inline alias_layout<N> make_alias_layout(const char* base, size_type elem,
+                                         const S& shape, const ST& strides,
+                                         bool exact)
+{
+  alias_layout<N> l;
+  l.base = base;
+  l.lo = l.hi = base;
+  std::ptrdiff_t lo = 0, hi = 0;
+  for (int d = 0; d < int(S::size()); d++) {
+    if (shape[d] == 0) {
+      return l; // empty
+    }
+    std::ptrdiff_t ext = std::ptrdiff_t(strides[d]) * (shape[d] - 1) * elem;
+    if (ext < 0) {
+      lo += ext;
+    } else {
+      hi += ext;
+    }
+  }
+  l.lo = base + lo;
+  l.hi = base + hi + elem;
+  l.exact = exact && S::size() == N;
+  if (l.exact) {
+    for (int d = 0; d < int(N); d++) {
+      l.strides[d] = std::ptrdiff_t(strides[d]) * elem;
+    }
+  }
+  return l;
+}
+
+// ======================================================================
+// visit_alias_leaves
+//
+// calls f(alias_layout) for every leaf of the expression that refers to
+// storage. Leaves reached through a non-strided adaptor (e.g., reshape of an
+// expression) are reported with their full range only, since the mapping
+// of indices to addresses isn't known. Expressions without storage (scalars,
+// generators) are skipped.
+
+struct alias_tag0
+{};
+struct alias_tag1 : alias_tag0
+{};
+struct alias_tag2 : alias_tag1
+{};
+
+// no storage
+template <size_type N, typename E, typename F>
+inline void visit_alias_leaves(const E&, bool, F&, alias_tag0)
+{}
+
+// gtensor, gtensor_view
+template <size_type N, typename E, typename F>
+inline auto visit_alias_leaves(const E& e, bool exact, F& f, alias_tag2)
+  -> decltype(e.data(), void())
+{
+  f(make_alias_layout<N>(raw_address(e.data()), sizeof(expr_value_type<E>),
+                         e.shape(), e.strides(), exact));
+}
+
+// gview of an expression with storage
+template <size_type N, typename E, typename F>
+inline auto visit_view_inner(const E& e, bool exact, F& f, alias_tag1)
+  -> decltype(e.inner().data(), void())
+{
+  using T = expr_value_type<std::decay_t<decltype(e.inner())>>;
+  f(make_alias_layout<N>(raw_address(e.inner().data()) + e.offset() * sizeof(T),
+                         sizeof(T), e.shape(), e.strides(), exact));
+}
+
+// gview of an adaptor
+template <size_type N, typename E, typename F>
+inline void visit_view_inner(const E& e, bool, F& f, alias_tag0)
+{
+  visit_alias_leaves<N>(e.inner(), false, f, alias_tag2{});
+}
+
+template <size_type N, typename E, typename F>
+inline auto visit_alias_leaves(const E& e, bool exact, F& f, alias_tag1)
+  -> decltype(e.offset(), e.inner(), void())
+{
+  visit_view_inner<N>(e, exact, f, alias_tag1{});
+}
+
+// gview_adaptor, gstencil
+template <size_type N, typename E, typename F>
+inline auto visit_alias_leaves(const E& e, bool, F& f, alias_tag1)
+  -> decltype(e.adapted(), void())
+{
+  visit_alias_leaves<N>(e.adapted(), false, f, alias_tag2{});
+}
+
+// gfunction
+template <size_type N, typename TPL, typename F, size_type... I>
+inline void visit_alias_operands(const TPL& operands, bool exact, F& f,
+                                 std::index_sequence<I...>)
+{
+  int dummy[] = {
+    (visit_alias_leaves<N>(std::get<I>(operands), exact, f, alias_tag2{}),
+     0)...,
+    0};
+  (void)dummy;
+}
+
+template <size_type N, typename E, typename F>
+inline auto visit_alias_leaves(const E& e, bool exact, F& f, alias_tag1)
+  -> decltype(e.operands(), void())
+{
+  using TPL = std::decay_t<decltype(e.operands())>;
+  visit_alias_operands<N>(
+    e.operands(), exact, f,
+    std::make_index_sequence<std::tuple_size<TPL>::value>());
+}
+
+// ======================================================================
+// alias_check
+//
+// Determines how lhs = rhs can be evaluated safely:
+//
+// - alias_order::any: no rhs leaf overlaps the lhs in a harmful way, either
+//   because it is disjoint, or because it reads every element at the same
+//   index at which it is written (e.g., a = 2 * a).
+// - alias_order::reverse: every overlapping rhs leaf is the lhs shifted
+//   towards lower addresses (e.g., a[1:] = a[:-1]), so traversing in
+//   reverse order reads each element before it is overwritten.
+// - alias_order::buffer: otherwise, the rhs needs to be evaluated into a
+//   temporary first.
+//
+// Shifted overlaps are only resolved by ordering if the lhs traversal visits
+// addresses in increasing order, which is the case for col-major layouts
+// with positive strides.
+
+enum class alias_order
+{
+  any,
+  reverse,
+  buffer,
+};
+
+template <size_type N, typename S>
+inline bool is_increasing_layout(const alias_layout<N>& l, const S& shape)
+{
+  std::ptrdiff_t span = 0;
+  for (int d = 0; d < int(N); d++) {
+    if (shape[d] <= 1) {
+      continue;
+    }
+    if (l.strides[d] <= span) {
+      return false;
+    }
+    span += l.strides[d] * (shape[d] - 1);
+  }
+  return true;
+}
+
+template <typename E1, typename E2>
+inline alias_order alias_check(const E1& lhs, const E2& rhs)
+{
+  constexpr size_type N = expr_dimension<E1>();
+  const auto& shape = lhs.shape();
+
+  alias_layout<N> l;
+  int n_lhs = 0;
+  auto collect_lhs = [&](const alias_layout<N>& layout) {
+    l = layout;
+    n_lhs++;
+  };
+  visit_alias_leaves<N>(lhs, true, collect_lhs, alias_tag2{});
+  if (n_lhs != 1 || !l.exact || l.lo == l.hi) {
+    // not something we can analyze
+    return alias_order::any;
+  }
+
+  bool increasing = is_increasing_layout(l, shape);
+  bool need_forward = false, need_reverse = false, buffer = false;
+  auto check_rhs = [&](const alias_layout<N>& r) {
+    if (r.hi <= l.lo || l.hi <= r.lo) {
+      return; // disjoint
+    }
+    if (!r.exact) {
+      buffer = true;
+      return;
+    }
+    for (int d = 0; d < int(N); d++) {
+      if (shape[d] > 1 && r.strides[d] != l.strides[d]) {
+        buffer = true;
+        return;
+      }
+    }
+    std::ptrdiff_t delta = r.base - l.base;
+    if (delta == 0) {
+      return; // same element at the same index
+    }
+    if (!increasing) {
+      buffer = true;
+    } else if (delta < 0) {
+      need_reverse = true;
+    } else {
+      need_forward = true;
+    }
+  };
+  visit_alias_leaves<N>(rhs, true, check_rhs, alias_tag2{});
+
+  if (buffer || (need_forward && need_reverse)) {
+    return alias_order::buffer;
+  }
+  if (need_reverse) {
+    return alias_order::reverse;
+  }
+  return alias_order::any;
+}
+
+// ======================================================================
+// alias_same_index
+//
+// whether two leaves, which both map the index space `shape` to memory,
+// either don't overlap, or touch the same element at every index, so that
+// reading one after writing the other at a given index is safe independent
+// of the order in which indices are visited.
+
+template <size_type N, typename S>
+inline bool alias_same_index(const alias_layout<N>& a, const alias_layout<N>& b,
+                             const S& shape)
+{
+  if (a.hi <= b.lo || b.hi <= a.lo) {
+    return true;
+  }
+  if (!a.exact || !b.exact || a.base != b.base) {
+    return false;
+  }
+  for (int d = 0; d < int(N); d++) {
+    if (shape[d] > 1 && a.strides[d] != b.strides[d]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace detail
+
+} // namespace gt
+
+#endif
@@ -2,7 +2,13 @@
 #ifndef GTENSOR_ASSIGN_H
 #define GTENSOR_ASSIGN_H
 
+#include "alias.h"
 #include "defs.h"
+#include "gscalar.h"
+#include "stepper.h"
+#include "strides.h"
+
+#include <stdexcept>
 
 namespace gt
 {
@@ -22,82 +28,134 @@ struct assigner
   static_assert(!std::is_same<SP, SP>::value, "assigner not implemented.");
 };
 
-template <>
-struct assigner<1, space::host>
+// On the host, assignment traverses lhs and rhs using steppers, which
+// replaces the full index calculation per element by a single increment of
+// the position of each operand.
+
+template <size_type N>
+struct assigner<N, space::host>
 {
   template <typename E1, typename E2>
   static void run(E1& lhs, const E2& rhs)
   {
-    // printf("assigner<1, host>\n");
-    for (int i = 0; i < lhs.shape(0); i++) {
-      lhs(i) = rhs(i);
-    }
+    // printf("assigner<%d, host>\n", int(N));
+    const auto& shape = lhs.shape();
+    auto lhs_st = make_stepper(lhs, shape);
+    auto rhs_st = make_stepper(rhs, shape);
+    for_each_stepper(
+      shape, [](auto& lhs, auto& rhs) { *lhs = *rhs; }, lhs_st, rhs_st);
   }
 };
 
-template <>
-struct assigner<2, space::host>
+// ----------------------------------------------------------------------
+// noalias_assigner
+//
+// assignment where the caller guarantees that lhs and rhs don't overlap
+
+template <size_type N, typename SP>
+struct noalias_assigner
 {
   template <typename E1, typename E2>
   static void run(E1& lhs, const E2& rhs)
   {
-    // printf("assigner<2, host>\n");
-    for (int j = 0; j < lhs.shape(1); j++) {
-      for (int i = 0; i < lhs.shape(0); i++) {
-        lhs(i, j) = rhs(i, j);
-      }
-    }
+    assigner<N, SP>::run(lhs, rhs);
   }
 };
 
-template <>
-struct assigner<3, space::host>
+template <size_type N>
+struct noalias_assigner<N, space::host>
 {
   template <typename E1, typename E2>
   static void run(E1& lhs, const E2& rhs)
   {
-    // printf("assigner<3, host>\n");
-    for (int k = 0; k < lhs.shape(2); k++) {
-      for (int j = 0; j < lhs.shape(1); j++) {
-        for (int i = 0; i < lhs.shape(0); i++) {
-          lhs(i, j, k) = rhs(i, j, k);
-        }
-      }
-    }
+    const auto& shape = lhs.shape();
+    auto lhs_st = make_stepper(lhs, shape);
+    auto rhs_st = make_stepper(rhs, shape);
+    for_each_stepper_noalias(
+      shape, [](auto& lhs, auto& rhs) { *lhs = *rhs; }, lhs_st, rhs_st);
+  }
+};
+
+// ----------------------------------------------------------------------
+// reverse_assigner
+//
+// assignment traversing the index space in reverse order, for when the rhs
+// reads the lhs shifted towards lower addresses. Only used on the host,
+// since the device kernels have no defined order.
+
+template <typename SP>
+struct reverse_assigner
+{
+  template <typename E1, typename E2>
+  static bool run(E1&, const E2&)
+  {
+    return false;
   }
 };
 
 template <>
-struct assigner<6, space::host>
+struct reverse_assigner<space::host>
 {
   template <typename E1, typename E2>
-  static void run(E1& lhs, const E2& rhs)
+  static bool run(E1& lhs, const E2& rhs)
   {
-    // printf("assigner<6, host>\n");
-    for (int n = 0; n < lhs.shape(5); n++) {
-      for (int m = 0; m < lhs.shape(4); m++) {
-        for (int l = 0; l < lhs.shape(3); l++) {
-          for (int k = 0; k < lhs.shape(2); k++) {
-            for (int j = 0; j < lhs.shape(1); j++) {
-              for (int i = 0; i < lhs.shape(0); i++) {
-                lhs(i, j, k, l, m, n) = rhs(i, j, k, l, m, n);
-              }
-            }
-          }
-        }
-      }
-    }
+    const auto& shape = lhs.shape();
+    auto lhs_st = make_stepper(lhs, shape);
+    auto rhs_st = make_stepper(rhs, shape);
+    for_each_stepper_reverse(
+      shape, [](auto& lhs, auto& rhs) { *lhs = *rhs; }, lhs_st, rhs_st);
+    return true;
+  }
+};
+
+// ----------------------------------------------------------------------
+// compound_assigner
+//
+// lhs = op(lhs, rhs), done in place in a single pass
+
+template <size_type N, typename SP>
+struct compound_assigner
+{
+  static_assert(!std::is_same<SP, SP>::value,
+                "compound_assigner not implemented.");
+};
+
+template <size_type N>
+struct compound_assigner<N, space::host>
+{
+  template <typename E1, typename E2, typename F>
+  static void run(E1& lhs, const E2& rhs, F op)
+  {
+    const auto& shape = lhs.shape();
+    auto lhs_st = make_stepper(lhs, shape);
+    auto rhs_st = make_stepper(rhs, shape);
+    for_each_stepper(
+      shape, [&op](auto& lhs, auto& rhs) { *lhs = op(*lhs, *rhs); }, lhs_st,
+      rhs_st);
   }
 };
 
 #ifdef GTENSOR_HAVE_DEVICE
 
+// on the device, op(lhs, rhs) is assigned to lhs by the regular assignment
+// kernels, which also reads and writes every element once
+
+template <size_type N>
+struct compound_assigner<N, space::device>
+{
+  template <typename E1, typename E2, typename F>
+  static void run(E1& lhs, const E2& rhs, F op)
+  {
+    assigner<N, space::device>::run(lhs, function(op, lhs, rhs));
+  }
+};
+
 template <typename Elhs, typename Erhs>
 __global__ void kernel_assign_1(Elhs lhs, Erhs rhs)
 {
   int i = threadIdx.x + blockIdx.x * blockDim.x;
 
-  if (i < lhs.shape(0)) {
+  if (i < get<0>(lhs.shape())) {
     lhs(i) = rhs(i);
   }
 }
@@ -108,7 +166,7 @@ __global__ void kernel_assign_2(Elhs lhs, Erhs rhs)
   int i = threadIdx.x + blockIdx.x * BS_X;
   int j = threadIdx.y + blockIdx.y * BS_Y;
 
-  if (i < lhs.shape(0) && j < lhs.shape(1)) {
+  if (i < get<0>(lhs.shape()) && j < get<1>(lhs.shape())) {
     lhs(i, j) = rhs(i, j);
   }
 }
@@ -120,7 +178,7 @@ __global__ void kernel_assign_3(Elhs lhs, Erhs rhs)
   int j = threadIdx.y + blockIdx.y * BS_Y;
   int b = blockIdx.z;
 
-  if (i < lhs.shape(0) && j < lhs.shape(1)) {
+  if (i < get<0>(lhs.shape()) && j < get<1>(lhs.shape())) {
     lhs(i, j, b) = rhs(i, j, b);
   }
 }
@@ -131,11 +189,11 @@ __global__ void kernel_assign_4(Elhs lhs, Erhs rhs)
   int i = threadIdx.x + blockIdx.x * BS_X;
   int j = threadIdx.y + blockIdx.y * BS_Y;
   int b = blockIdx.z;
-  int l = b / lhs.shape(2);
-  b -= l * lhs.shape(2);
+  int l = b / get<2>(lhs.shape());
+  b -= l * get<2>(lhs.shape());
   int k = b;
 
-  if (i < lhs.shape(0) && j < lhs.shape(1)) {
+  if (i < get<0>(lhs.shape()) && j < get<1>(lhs.shape())) {
     lhs(i, j, k, l) = rhs(i, j, k, l);
   }
 }
@@ -146,10 +204,10 @@ __global__ void kernel_assign_5(Elhs lhs, Erhs rhs)
   int tidx = threadIdx.x + blockIdx.x * blockDim.x;
   int tidy = threadIdx.y + blockIdx.y * blockDim.y;
   int tidz = blockIdx.z;
-  if (tidx < lhs.shape(0) * lhs.shape(1) &&
-      tidy < lhs.shape(2) * lhs.shape(3)) {
-    int j = tidx / lhs.shape(0), i = tidx % lhs.shape(0);
-    int l = tidy / lhs.shape(2), k = tidy % lhs.shape(2);
+  if (tidx < get<0>(lhs.shape()) * get<1>(lhs.shape()) &&
+      tidy < get<2>(lhs.shape()) * get<3>(lhs.shape())) {
+    int j = tidx / get<0>(lhs.shape()), i = tidx % get<0>(lhs.shape());
+    int l = tidy / get<2>(lhs.shape()), k = tidy % get<2>(lhs.shape());
     int m = tidz;
 
     lhs(i, j, k, l, m) = rhs(i, j, k, l, m);
@@ -163,11 +221,11 @@ __global__ void kernel_assign_6(Elhs lhs, Erhs _rhs)
   int tidx = threadIdx.x + blockIdx.x * blockDim.x;
   int tidy = threadIdx.y + blockIdx.y * blockDim.y;
   int tidz = blockIdx.z;
-  if (tidx < lhs.shape(0) * lhs.shape(1) &&
-      tidy < lhs.shape(2) * lhs.shape(3)) {
-    int j = tidx / lhs.shape(0), i = tidx % lhs.shape(0);
-    int l = tidy / lhs.shape(2), k = tidy % lhs.shape(2);
-    int n = tidz / lhs.shape(4), m = tidz % lhs.shape(4);
+  if (tidx < get<0>(lhs.shape()) * get<1>(lhs.shape()) &&
+      tidy < get<2>(lhs.shape()) * get<3>(lhs.shape())) {
+    int j = tidx / get<0>(lhs.shape()), i = tidx % get<0>(lhs.shape());
+    int l = tidy / get<2>(lhs.shape()), k = tidy % get<2>(lhs.shape());
+    int n = tidz / get<4>(lhs.shape()), m = tidz % get<4>(lhs.shape());
 
     lhs(i, j, k, l, m, n) = rhs(i, j, k, l, m, n);
   }
@@ -292,32 +350,247 @@ struct assigner<6, space::device>
 
 #endif
 
+// ----------------------------------------------------------------------
+// check_assign_shape
+//
+// the rhs shape must match the lhs shape, or be 1 in dimensions that are
+// broadcast. Checking this once up front is what allows the assignment loops
+// to go without per-element bounds checks.
+
+template <typename S1, typename S2>
+inline void check_assign_shape(const S1& lhs_shape, const S2& rhs_shape)
+{
+  for (int d = 0; d < int(S1::size()); d++) {
+    if (rhs_shape[d] != lhs_shape[d] && rhs_shape[d] != 1) {
+      throw std::runtime_error("assign: cannot broadcast shape " +
+                               to_string(rhs_shape) + " to " +
+                               to_string(lhs_shape));
+    }
+  }
+}
+
+// ----------------------------------------------------------------------
+// assign_buffered
+//
+// evaluates rhs into a temporary first, for when it overlaps lhs
+
+template <typename E1, typename E2>
+inline auto make_assign_buffer(const E1& lhs, const E2& rhs)
+{
+  constexpr int N = expr_dimension<E1>();
+  using space_type = space_t<expr_space_type<E1>, expr_space_type<E2>>;
+  using buffer_type =
+    gtensor<std::decay_t<expr_value_type<E1>>, N, space_type,
+            typename default_shape_type<N>::type>;
+
+  buffer_type buf(lhs.shape());
+  assigner<N, space_type>::run(buf, rhs);
+  return buf;
+}
+
+// ----------------------------------------------------------------------
+// assign_op
+//
+// lhs = op(lhs, rhs) for plain assignment
+
+struct assign_op
+{
+  template <typename T, typename U>
+  GT_INLINE U operator()(const T&, U rhs) const
+  {
+    return rhs;
+  }
+};
+
+// ----------------------------------------------------------------------
+// deferred_assign
+//
+// hands lhs = op(lhs, rhs) to the active fusion_scope (see fusion.h), if
+// there is one, rather than executing it right away. Only host assignments
+// are deferred. flush() executes whatever has been deferred so far.
+
+template <typename SP>
+struct deferred_assign
+{
+  template <typename E1, typename E2, typename F>
+  static bool record(E1& lhs, const E2& rhs, F op)
+  {
+    return false;
+  }
+
+  static void flush() {}
+};
+
+template <>
+struct deferred_assign<space::host>
+{
+  template <typename E1, typename E2, typename F>
+  static bool record(E1& lhs, const E2& rhs, F op);
+
+  static void flush();
+};
+
+// ----------------------------------------------------------------------
+// assign_now, compound_assign_now
+//
+// the actual assignments, once the shapes have been checked
+
+template <typename E1, typename E2>
+void assign_now(E1& lhs, const E2& rhs)
+{
+  using space_type = space_t<expr_space_type<E1>, expr_space_type<E2>>;
+  constexpr size_type N = expr_dimension<E1>();
+
+  auto order = alias_check(lhs, rhs);
+  if (order == alias_order::reverse &&
+      reverse_assigner<space_type>::run(lhs, rhs)) {
+    return;
+  }
+  if (order != alias_order::any) {
+    auto buf = make_assign_buffer(lhs, rhs);
+    noalias_assigner<N, space_type>::run(lhs, buf);
+    return;
+  }
+  assigner<N, space_type>::run(lhs, rhs);
+}
+
+template <typename E1, typename E2, typename F>
+void compound_assign_now(E1& lhs, const E2& rhs, F op)
+{
+  using space_type = space_t<expr_space_type<E1>, expr_space_type<E2>>;
+  constexpr size_type N = expr_dimension<E1>();
+
+  if (alias_check(lhs, rhs) != alias_order::any) {
+    auto buf = make_assign_buffer(lhs, rhs);
+    compound_assigner<N, space_type>::run(lhs, buf, op);
+    return;
+  }
+  compound_assigner<N, space_type>::run(lhs, rhs, op);
+}
+
+template <typename E1, typename E2>
+void compound_assign_now(E1& lhs, const E2& rhs, assign_op)
+{
+  assign_now(lhs, rhs);
+}
+
 } // namespace detail
 
+// ======================================================================
+// assign
+//
+// lhs = rhs. If the storage of lhs overlaps the storage the rhs reads from,
+// the result is computed as if the rhs was fully evaluated before being
+// assigned, by traversing in reverse order or going through a temporary
+// where needed. Use noalias(lhs) = rhs to skip the check.
+
 template <typename E1, typename E2>
 void assign(E1& lhs, const E2& rhs)
 {
   static_assert(expr_dimension<E1>() == expr_dimension<E2>(),
                 "cannot assign expressions of different dimension");
-  // FIXME, need to check for brodcasting
-#if 0
-  if (lhs.shape() != rhs.shape()) {
-    std::cout << "not the same shape! " << lhs.shape() << rhs.shape() << "\n";
+#if GTENSOR_BOUNDSCHECK_LEVEL >= 1
+  detail::check_assign_shape(lhs.shape(), rhs.shape());
+#endif
+  using space_type = space_t<expr_space_type<E1>, expr_space_type<E2>>;
+  if (detail::deferred_assign<space_type>::record(lhs, rhs,
+                                                  detail::assign_op{})) {
+    return;
   }
-  assert(lhs.shape() == rhs.shape());
+  detail::assign_now(lhs, rhs);
+}
+
+template <typename E1, typename E2>
+void assign_noalias(E1& lhs, const E2& rhs)
+{
+  static_assert(expr_dimension<E1>() == expr_dimension<E2>(),
+                "cannot assign expressions of different dimension");
+#if GTENSOR_BOUNDSCHECK_LEVEL >= 1
+  detail::check_assign_shape(lhs.shape(), rhs.shape());
 #endif
-  detail::assigner<expr_dimension<E1>(),
-                   space_t<expr_space_type<E1>, expr_space_type<E2>>>::run(lhs,
-                                                                           rhs);
+  using space_type = space_t<expr_space_type<E1>, expr_space_type<E2>>;
+  if (detail::deferred_assign<space_type>::record(lhs, rhs,
+                                                  detail::assign_op{})) {
+    return;
+  }
+  detail::noalias_assigner<expr_dimension<E1>(), space_type>::run(lhs, rhs);
 }
 
 template <typename E1, typename T>
 void assign(E1& lhs, const gscalar<T>& val)
 {
+  using space_type =
+    space_t<expr_space_type<E1>, expr_space_type<gscalar<T>>>;
+  // the scalar is copied, as val may refer to a temporary
+  if (detail::deferred_assign<space_type>::record(lhs, val.to_kernel(),
+                                                  detail::assign_op{})) {
+    return;
+  }
   // FIXME, make more efficient
-  detail::assigner<
-    expr_dimension<E1>(),
-    space_t<expr_space_type<E1>, expr_space_type<gscalar<T>>>>::run(lhs, val);
+  detail::assigner<expr_dimension<E1>(), space_type>::run(lhs, val);
+}
+
+// ======================================================================
+// compound_assign
+//
+// lhs = op(lhs, rhs) in place, as used by operator+= etc. Unlike assigning
+// the expression `lhs + rhs`, this doesn't resize lhs and only traverses
+// lhs once.
+
+template <typename E1, typename E2, typename F>
+void compound_assign(E1& lhs, const E2& rhs, F op)
+{
+  static_assert(expr_dimension<E1>() == expr_dimension<E2>(),
+                "cannot assign expressions of different dimension");
+#if GTENSOR_BOUNDSCHECK_LEVEL >= 1
+  detail::check_assign_shape(lhs.shape(), rhs.shape());
+#endif
+  using space_type = space_t<expr_space_type<E1>, expr_space_type<E2>>;
+  if (detail::deferred_assign<space_type>::record(lhs, rhs, op)) {
+    return;
+  }
+  detail::compound_assign_now(lhs, rhs, op);
+}
+
+template <typename E1, typename T, typename F>
+void compound_assign(E1& lhs, const gscalar<T>& val, F op)
+{
+  using space_type =
+    space_t<expr_space_type<E1>, expr_space_type<gscalar<T>>>;
+  if (detail::deferred_assign<space_type>::record(lhs, val.to_kernel(), op)) {
+    return;
+  }
+  detail::compound_assigner<expr_dimension<E1>(), space_type>::run(lhs, val,
+                                                                   op);
+}
+
+// ======================================================================
+// noalias
+//
+// noalias(lhs) = rhs assigns without checking for overlap between lhs and
+// rhs, and lets the compiler assume that there is none.
+
+template <typename E>
+class noalias_proxy
+{
+public:
+  noalias_proxy(E&& e) : e_(std::forward<E>(e)) {}
+
+  template <typename E2>
+  noalias_proxy& operator=(const expression<E2>& rhs)
+  {
+    assign_noalias(e_, rhs.derived());
+    return *this;
+  }
+
+private:
+  E e_;
+};
+
+template <typename E>
+inline noalias_proxy<E> noalias(E&& e)
+{
+  return noalias_proxy<E>(std::forward<E>(e));
 }
 
 } // namespace gt
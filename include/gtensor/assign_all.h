@@ -0,0 +1,243 @@
+
+// ======================================================================
+// assign_all.h
+//
+// assign_all : assignment of several expressions in a single traversal
+
+#ifndef GTENSOR_ASSIGN_ALL_H
+#define GTENSOR_ASSIGN_ALL_H
+
+#include "assign.h"
+#include "defs.h"
+#include "helper.h"
+#include "stepper.h"
+
+#include <stdexcept>
+#include <tuple>
+
+namespace gt
+{
+
+namespace detail
+{
+
+// ======================================================================
+// multi_ref
+//
+// a tuple of element references, that assigns a tuple of values to them.
+// All values are evaluated before any is stored, so that leaves shared
+// between the expressions only need to be loaded once per element.
+
+template <typename... R>
+class multi_ref
+{
+public:
+  GT_INLINE multi_ref(R... r) : r_(r...) {}
+
+  template <typename... T>
+  GT_INLINE multi_ref& operator=(const std::tuple<T...>& vals)
+  {
+    assign(vals, std::make_index_sequence<sizeof...(R)>());
+    return *this;
+  }
+
+private:
+  template <typename TPL, size_type... I>
+  GT_INLINE void assign(const TPL& vals, std::index_sequence<I...>)
+  {
+    int dummy[] = {(std::get<I>(r_) = std::get<I>(vals), 0)..., 0};
+    (void)dummy;
+  }
+
+  std::tuple<R...> r_;
+};
+
+struct make_multi_ref
+{
+  template <typename... R>
+  GT_INLINE multi_ref<R...> operator()(R&&... r) const
+  {
+    return multi_ref<R...>(std::forward<R>(r)...);
+  }
+};
+
+struct make_multi_value
+{
+  template <typename... T>
+  GT_INLINE std::tuple<std::decay_t<T>...> operator()(T&&... vals) const
+  {
+    return std::tuple<std::decay_t<T>...>(std::forward<T>(vals)...);
+  }
+};
+
+// ======================================================================
+// multi_expression
+//
+// presents several expressions of the same dimension as one, whose elements
+// are tuples of the individual elements (rhs), or a multi_ref (lhs), so that
+// they can go through the regular host and device assigners
+
+template <typename F, typename... E>
+class multi_expression
+{
+public:
+  using space_type = space_t<expr_space_type<E>...>;
+  using shape_type = expr_shape_type<
+    std::tuple_element_t<0, std::tuple<std::decay_t<E>...>>>;
+
+  constexpr static size_type dimension() { return shape_type::size(); }
+
+  GT_INLINE multi_expression(E&&... e) : e_(std::forward<E>(e)...) {}
+
+  GT_INLINE const shape_type& shape() const { return shape_; }
+  GT_INLINE int shape(int i) const { return shape_[i]; }
+
+  template <typename... Args>
+  GT_INLINE auto operator()(Args... args) const
+  {
+    return access(std::make_index_sequence<sizeof...(E)>(), args...);
+  }
+
+  template <typename... Args>
+  GT_INLINE auto operator()(Args... args)
+  {
+    return access(std::make_index_sequence<sizeof...(E)>(), args...);
+  }
+
+  auto to_kernel() const
+  {
+    return to_kernel(std::make_index_sequence<sizeof...(E)>());
+  }
+
+  template <typename S>
+  auto stepper(const S& shape) const
+  {
+    return stepper(std::make_index_sequence<sizeof...(E)>(), shape);
+  }
+
+  template <typename S>
+  auto stepper(const S& shape)
+  {
+    return stepper(std::make_index_sequence<sizeof...(E)>(), shape);
+  }
+
+  void set_shape(const shape_type& shape) { shape_ = shape; }
+
+private:
+  template <size_type... I, typename... Args>
+  GT_INLINE auto access(std::index_sequence<I...>, Args... args) const
+  {
+    return F{}(std::get<I>(e_)(args...)...);
+  }
+
+  template <size_type... I, typename... Args>
+  GT_INLINE auto access(std::index_sequence<I...>, Args... args)
+  {
+    return F{}(std::get<I>(e_)(args...)...);
+  }
+
+  template <size_type... I>
+  auto to_kernel(std::index_sequence<I...>) const
+  {
+    multi_expression<F, to_kernel_t<E>...> k(std::get<I>(e_).to_kernel()...);
+    k.set_shape(shape_);
+    return k;
+  }
+
+  template <size_type... I, typename S>
+  auto stepper(std::index_sequence<I...>, const S& shape) const
+  {
+    return make_function_stepper(f_, make_stepper(std::get<I>(e_), shape)...);
+  }
+
+  template <size_type... I, typename S>
+  auto stepper(std::index_sequence<I...>, const S& shape)
+  {
+    return make_function_stepper(f_, make_stepper(std::get<I>(e_), shape)...);
+  }
+
+  F f_;
+  std::tuple<E...> e_;
+  shape_type shape_;
+};
+
+template <typename F, typename... E, size_type... I>
+inline auto make_multi_expression(std::tuple<E...>& e,
+                                  std::index_sequence<I...>)
+{
+  return multi_expression<F, E&...>(std::get<I>(e)...);
+}
+
+} // namespace detail
+
+// ======================================================================
+// assign_all
+//
+// assigns each expression to the corresponding output, e.g.,
+//
+//   gt::assign_all(std::tie(re, im), std::make_tuple(a * c - b * d,
+//                                                    a * d + b * c));
+//
+// in a single traversal of the index space, on the host or the device. All
+// outputs need to have the same shape, and each expression needs to match
+// (or broadcast to) that shape.
+
+template <typename... O, typename... E>
+void assign_all(std::tuple<O&...> outs, std::tuple<E...> exprs)
+{
+  static_assert(sizeof...(O) == sizeof...(E),
+                "assign_all: need as many expressions as outputs");
+  static_assert(sizeof...(O) > 0, "assign_all: nothing to assign");
+  using indices = std::make_index_sequence<sizeof...(O)>;
+
+  using space_type =
+    space_t<expr_space_type<O>..., expr_space_type<E>...>;
+  // runs right away, after whatever is pending in a fusion_scope
+  detail::deferred_assign<space_type>::flush();
+
+  auto lhs = detail::make_multi_expression<detail::make_multi_ref>(outs,
+                                                                   indices());
+  auto rhs =
+    detail::make_multi_expression<detail::make_multi_value>(exprs, indices());
+  const auto& shape = std::get<0>(outs).shape();
+  lhs.set_shape(shape);
+  rhs.set_shape(shape);
+
+  constexpr size_type N = expr_dimension<decltype(lhs)>();
+  bool overlap = false;
+  helper::for_each_pair(outs, exprs, [&](const auto& out, const auto& expr) {
+    static_assert(expr_dimension<decltype(out)>() == N &&
+                    expr_dimension<decltype(expr)>() == N,
+                  "assign_all: expressions need to have the same dimension");
+    if (out.shape() != shape) {
+      throw std::runtime_error("assign_all: outputs need to have the same "
+                               "shape");
+    }
+#if GTENSOR_BOUNDSCHECK_LEVEL >= 1
+    detail::check_assign_shape(out.shape(), expr.shape());
+#endif
+  });
+  // writing one output must not change what another expression reads
+  helper::for_each(outs, [&](const auto& out) {
+    helper::for_each(exprs, [&](const auto& expr) {
+      if (detail::alias_check(out, expr) != detail::alias_order::any) {
+        overlap = true;
+      }
+    });
+  });
+  if (overlap) {
+    auto bufs = helper::transform(exprs, [](const auto& expr) {
+      return detail::make_assign_buffer(expr, expr);
+    });
+    helper::for_each_pair(outs, bufs, [](auto& out, const auto& buf) {
+      assign(out, buf);
+    });
+    return;
+  }
+
+  detail::assigner<N, space_type>::run(lhs, rhs);
+}
+
+} // namespace gt
+
+#endif
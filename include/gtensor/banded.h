@@ -0,0 +1,338 @@
+
+// ======================================================================
+// banded.h
+//
+// solve_tridiagonal, solve_banded : many banded linear systems along an
+// axis of an array at once
+
+#ifndef GTENSOR_BANDED_H
+#define GTENSOR_BANDED_H
+
+#include "batched.h"
+#include "defs.h"
+#include "fusion.h"
+#include "gtensor.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace gt
+{
+
+namespace detail
+{
+
+// the systems a worker solves at a time, so that they stay in cache
+constexpr const int BANDED_LANES = 512;
+
+// ----------------------------------------------------------------------
+// band_systems
+//
+// The systems along `axis` of a col-major array of shape `shape`, seen as
+// lanes: each system is a lane, element i of lane l (of repeat r) is at
+// r * rs + l * ls + i * as. Along an inner axis, the lanes are the
+// contiguous indices before the axis, repeated for each index after it.
+// Along axis 0, the systems are contiguous and the lanes are strided.
+
+struct band_systems
+{
+  int n;
+  int lanes;
+  int repeats;
+  std::ptrdiff_t as;
+  std::ptrdiff_t ls;
+  std::ptrdiff_t rs;
+
+  int blocks_per_repeat() const
+  {
+    return (lanes + BANDED_LANES - 1) / BANDED_LANES;
+  }
+  int n_blocks() const { return repeats * blocks_per_repeat(); }
+
+  // first element and number of lanes of block k
+  void block(int k, std::ptrdiff_t& base, int& count) const
+  {
+    const int r = k / blocks_per_repeat();
+    const int l0 = (k % blocks_per_repeat()) * BANDED_LANES;
+    base = r * rs + l0 * ls;
+    count = std::min(BANDED_LANES, lanes - l0);
+  }
+};
+
+template <typename S>
+inline band_systems make_band_systems(const S& shape, int axis)
+{
+  const int N = shape.size();
+  if (axis < 0 || axis >= N) {
+    throw std::runtime_error("banded: axis out of range");
+  }
+  std::ptrdiff_t inner = 1, outer = 1;
+  for (int d = 0; d < axis; d++) {
+    inner *= shape[d];
+  }
+  for (int d = axis + 1; d < N; d++) {
+    outer *= shape[d];
+  }
+  const int n = shape[axis];
+  if (axis == 0) {
+    return {n, int(outer), 1, 1, n, 0};
+  }
+  return {n, int(inner), int(outer), inner, 1, inner * n};
+}
+
+// runs f(base, count) for every block of systems, spread across threads
+template <typename F>
+inline void for_each_band_block(const band_systems& sys, size_type work,
+                                F&& f)
+{
+  batched_parallel(sys.n_blocks(), work * BANDED_LANES, 1,
+                   [&](int k0, int k1) {
+                     for (int k = k0; k < k1; k++) {
+                       std::ptrdiff_t base;
+                       int count;
+                       sys.block(k, base, count);
+                       f(base, count);
+                     }
+                   });
+}
+
+// ----------------------------------------------------------------------
+// band_lu
+//
+// LU factorization without pivoting of a matrix in LAPACK band storage,
+// ab(ku + i - j, j) = A(i, j), which stays within the band. The factors are
+// kept the same way, with the reciprocals of the diagonal.
+
+template <typename T>
+class band_lu
+{
+public:
+  band_lu(const gtensor<T, 2>& ab, int kl, int ku)
+    : n_(ab.shape(1)), kl_(kl), ku_(ku), lu_(ab), rdiag_(n_)
+  {
+    if (kl < 0 || ku < 0 || ab.shape(0) != kl + ku + 1) {
+      throw std::runtime_error("solve_banded: band storage needs kl + ku + 1 "
+                               "rows");
+    }
+    for (int k = 0; k < n_; k++) {
+      if ((*this)(k, k) == T(0)) {
+        throw std::runtime_error("solve_banded: zero pivot in row " +
+                                 std::to_string(k));
+      }
+      rdiag_[k] = T(1) / (*this)(k, k);
+      for (int i = k + 1; i <= std::min(n_ - 1, k + kl_); i++) {
+        (*this)(i, k) *= rdiag_[k];
+        for (int j = k + 1; j <= std::min(n_ - 1, k + ku_); j++) {
+          (*this)(i, j) -= (*this)(i, k) * (*this)(k, j);
+        }
+      }
+    }
+  }
+
+  // x = A^-1 x for `count` systems, element i of lane l at x[l * ls + i * as]
+  template <int LS>
+  void solve(T* x, int count, std::ptrdiff_t ls, std::ptrdiff_t as) const
+  {
+    if (LS != 0) {
+      ls = LS;
+    }
+    for (int i = 0; i < n_; i++) {
+      T* xi = x + i * as;
+      for (int j = std::max(0, i - kl_); j < i; j++) {
+        const T lij = (*this)(i, j);
+        const T* xj = x + j * as;
+        GT_NOALIAS_LOOP
+        for (int l = 0; l < count; l++) {
+          xi[l * ls] -= lij * xj[l * ls];
+        }
+      }
+    }
+    for (int i = n_ - 1; i >= 0; i--) {
+      T* xi = x + i * as;
+      for (int j = i + 1; j <= std::min(n_ - 1, i + ku_); j++) {
+        const T uij = (*this)(i, j);
+        const T* xj = x + j * as;
+        GT_NOALIAS_LOOP
+        for (int l = 0; l < count; l++) {
+          xi[l * ls] -= uij * xj[l * ls];
+        }
+      }
+      const T r = rdiag_[i];
+      for (int l = 0; l < count; l++) {
+        xi[l * ls] *= r;
+      }
+    }
+  }
+
+  int n() const { return n_; }
+  int bandwidth() const { return kl_ + ku_ + 1; }
+
+private:
+  T& operator()(int i, int j) { return lu_(ku_ + i - j, j); }
+  const T& operator()(int i, int j) const { return lu_(ku_ + i - j, j); }
+
+  int n_, kl_, ku_;
+  gtensor<T, 2> lu_;
+  std::vector<T> rdiag_;
+};
+
+template <typename T, int N>
+inline void band_solve(const band_lu<T>& lu, gtensor<T, N>& d, int axis)
+{
+  auto sys = make_band_systems(d.shape(), axis);
+  if (sys.n != lu.n()) {
+    throw std::runtime_error("solve_banded: matrix of size " +
+                             std::to_string(lu.n()) + ", but " +
+                             std::to_string(sys.n) + " points along axis");
+  }
+  // reads and writes d in place
+  deferred_assign<space::host>::flush();
+  T* data = d.data();
+  for_each_band_block(sys, size_type(sys.n) * lu.bandwidth() * 2,
+                      [&](std::ptrdiff_t base, int count) {
+                        if (sys.ls == 1) {
+                          lu.template solve<1>(data + base, count, 1, sys.as);
+                        } else {
+                          lu.template solve<0>(data + base, count, sys.ls,
+                                               sys.as);
+                        }
+                      });
+}
+
+// ----------------------------------------------------------------------
+// thomas_solve
+//
+// Thomas' algorithm for `count` tridiagonal systems with their own
+// coefficients, stored like d, using cp (n * count) as scratch
+
+template <int LS, typename T>
+inline void thomas_solve(const T* a, const T* b, const T* c, T* d, T* cp,
+                         int n, int count, std::ptrdiff_t ls,
+                         std::ptrdiff_t as)
+{
+  if (LS != 0) {
+    ls = LS;
+  }
+  for (int l = 0; l < count; l++) {
+    const T m = T(1) / b[l * ls];
+    cp[l] = c[l * ls] * m;
+    d[l * ls] *= m;
+  }
+  for (int i = 1; i < n; i++) {
+    const std::ptrdiff_t o = i * as, o1 = o - as;
+    T* cpi = cp + i * count;
+    const T* cpi1 = cpi - count;
+    GT_NOALIAS_LOOP
+    for (int l = 0; l < count; l++) {
+      const T m = T(1) / (b[o + l * ls] - a[o + l * ls] * cpi1[l]);
+      cpi[l] = c[o + l * ls] * m;
+      d[o + l * ls] = (d[o + l * ls] - a[o + l * ls] * d[o1 + l * ls]) * m;
+    }
+  }
+  for (int i = n - 2; i >= 0; i--) {
+    const std::ptrdiff_t o = i * as, o1 = o + as;
+    const T* cpi = cp + i * count;
+    GT_NOALIAS_LOOP
+    for (int l = 0; l < count; l++) {
+      d[o + l * ls] -= cpi[l] * d[o1 + l * ls];
+    }
+  }
+}
+
+} // namespace detail
+
+// ======================================================================
+// solve_tridiagonal
+//
+// Solves the tridiagonal systems
+//
+//   a[i] x[i-1] + b[i] x[i] + c[i] x[i+1] = d[i],  i = 0 .. n - 1
+//
+// along `axis` of d, for all other indices at once, overwriting d with x
+// (a[0] and c[n-1] are ignored). The coefficients are either 1-d arrays of
+// length n, shared by all systems, or arrays of the same shape as d, one
+// set per system. No pivoting is done, so the systems should be, e.g.,
+// diagonally dominant, as for implicit diffusion.
+//
+// The systems are solved side by side, with the innermost loops running
+// across systems rather than along them, and blocks of systems are spread
+// across threads. Shared coefficients are factored only once.
+
+template <typename T, int N>
+void solve_tridiagonal(const gtensor<T, 1>& a, const gtensor<T, 1>& b,
+                       const gtensor<T, 1>& c, gtensor<T, N>& d, int axis = 0)
+{
+  const int n = b.shape(0);
+  if (a.shape(0) != n || c.shape(0) != n) {
+    throw std::runtime_error("solve_tridiagonal: coefficients of different "
+                             "lengths");
+  }
+  // reads the coefficients directly
+  detail::deferred_assign<space::host>::flush();
+  gtensor<T, 2> ab(gt::shape(3, n));
+  for (int i = 0; i < n; i++) {
+    if (i > 0) {
+      ab(2, i - 1) = a(i);
+      ab(0, i) = c(i - 1);
+    }
+    ab(1, i) = b(i);
+  }
+  detail::band_solve(detail::band_lu<T>(ab, 1, 1), d, axis);
+}
+
+template <typename T, int N, typename = std::enable_if_t<(N > 1)>>
+void solve_tridiagonal(const gtensor<T, N>& a, const gtensor<T, N>& b,
+                       const gtensor<T, N>& c, gtensor<T, N>& d, int axis = 0)
+{
+  if (a.shape() != d.shape() || b.shape() != d.shape() ||
+      c.shape() != d.shape()) {
+    throw std::runtime_error("solve_tridiagonal: coefficients of shape " +
+                             to_string(b.shape()) + " for " +
+                             to_string(d.shape()));
+  }
+  auto sys = detail::make_band_systems(d.shape(), axis);
+  if (sys.n == 0) {
+    return;
+  }
+  detail::deferred_assign<space::host>::flush();
+  T* data = d.data();
+  detail::for_each_band_block(
+    sys, size_type(sys.n) * 8, [&](std::ptrdiff_t base, int count) {
+      std::vector<T> cp(size_type(sys.n) * count);
+      if (sys.ls == 1) {
+        detail::thomas_solve<1>(a.data() + base, b.data() + base,
+                                c.data() + base, data + base, cp.data(),
+                                sys.n, count, 1, sys.as);
+      } else {
+        detail::thomas_solve<0>(a.data() + base, b.data() + base,
+                                c.data() + base, data + base, cp.data(),
+                                sys.n, count, sys.ls, sys.as);
+      }
+    });
+}
+
+// ======================================================================
+// solve_banded
+//
+// Solves A x = d along `axis` of d for all other indices at once,
+// overwriting d with x, where A is an n x n band matrix with kl
+// sub-diagonals and ku super-diagonals, shared by all systems, given in
+// LAPACK band storage: ab has shape (kl + ku + 1, n), and
+// ab(ku + i - j, j) = A(i, j). A is factored once, without pivoting, and
+// the systems are then solved side by side as in solve_tridiagonal().
+
+template <typename T, int N>
+void solve_banded(const gtensor<T, 2>& ab, int kl, int ku, gtensor<T, N>& d,
+                  int axis = 0)
+{
+  // reads ab directly
+  detail::deferred_assign<space::host>::flush();
+  detail::band_solve(detail::band_lu<T>(ab, kl, ku), d, axis);
+}
+
+} // namespace gt
+
+#endif
@@ -0,0 +1,556 @@
+
+// ======================================================================
+// batched.h
+//
+// batched_matmul, batched_matvec, batched_lu_factor, batched_lu_solve :
+// operations on many independent small matrices at once
+
+#ifndef GTENSOR_BATCHED_H
+#define GTENSOR_BATCHED_H
+
+#include "defs.h"
+#include "fusion.h"
+#include "gtensor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace gt
+{
+
+// ======================================================================
+// batch_layout
+//
+// Where the batch dimension of a stack of matrices (or vectors) is:
+//
+// - trailing: a(i, j, b), each matrix is contiguous, and the operations
+//   loop over the matrices, vectorizing within each one.
+// - interleaved: a(b, i, j), element (i, j) of consecutive matrices is
+//   contiguous, and the innermost loop of every operation runs across the
+//   batch, so that the SIMD lanes work on different matrices. That's the
+//   layout of choice for matrices too small to vectorize on their own, and
+//   it lets LU factorization vectorize even though each matrix pivots
+//   differently.
+
+enum class batch_layout
+{
+  trailing,
+  interleaved
+};
+
+namespace detail
+{
+
+// below this many multiply-adds, batched operations run on the calling
+// thread only
+constexpr const size_type BATCHED_PARALLEL_MIN = 64 * 64 * 64;
+
+// in interleaved layout, the batch entries worked on together, so that
+// their matrices stay in cache
+constexpr const int BATCHED_LANES = 64;
+
+// a stack of matrices with element (i, j) of batch entry b at
+// data[b * sb + i * si + j * sj]
+template <typename T>
+struct batch_ref
+{
+  T* data;
+  int batch;
+  int rows;
+  int cols;
+  std::ptrdiff_t sb;
+  std::ptrdiff_t si;
+  std::ptrdiff_t sj;
+
+  T& operator()(int b, int i, int j) const
+  {
+    return data[b * sb + i * si + j * sj];
+  }
+
+  // in interleaved layout (sb == 1), element (i, j) of consecutive entries
+  // is at lane(i, j)[b]
+  T* lane(int i, int j) const { return data + i * si + j * sj; }
+};
+
+// the batch_ref of a stack of matrices (N = 3) or vectors (N = 2)
+template <int N, typename T, typename A>
+inline batch_ref<T> make_batch_ref(T* data, const A& a, batch_layout layout)
+{
+  const auto& s = a.strides();
+  const int bd = layout == batch_layout::trailing ? N - 1 : 0;
+  const int id = layout == batch_layout::trailing ? 0 : 1;
+  batch_ref<T> r{data, a.shape(bd), a.shape(id), 1, s[bd], s[id], 0};
+  if (N == 3) {
+    r.cols = a.shape(id + 1);
+    r.sj = s[id + 1];
+  }
+  return r;
+}
+
+// runs f(b0, b1) on ranges of [0, n) that together cover it, on as many
+// threads as useful given the work per batch entry
+template <typename F>
+inline void batched_parallel(int n, size_type work_per_entry, int granule,
+                             F&& f)
+{
+  int n_threads = 1;
+  if (size_type(n) * work_per_entry >= BATCHED_PARALLEL_MIN) {
+    n_threads = std::max(1u, std::thread::hardware_concurrency());
+    n_threads = std::min(n_threads, (n + granule - 1) / granule);
+  }
+  const int chunk = (n + n_threads - 1) / n_threads;
+  std::vector<std::future<void>> others;
+  for (int t = 1; t < n_threads; t++) {
+    const int b0 = std::min(n, t * chunk), b1 = std::min(n, b0 + chunk);
+    others.push_back(std::async(std::launch::async, f, b0, b1));
+  }
+  f(0, std::min(n, chunk));
+  for (auto& other : others) {
+    other.get();
+  }
+}
+
+// ----------------------------------------------------------------------
+// kernels
+//
+// Each kernel works on batch entries [b0, b1). The trailing ones loop over
+// the entries and have the row index innermost, the interleaved ones have
+// the batch index innermost.
+
+template <typename T>
+inline void batched_matmul_trailing(const batch_ref<const T>& a,
+                                    const batch_ref<const T>& b,
+                                    const batch_ref<T>& c, int b0, int b1)
+{
+  for (int e = b0; e < b1; e++) {
+    for (int j = 0; j < c.cols; j++) {
+      for (int i = 0; i < c.rows; i++) {
+        c(e, i, j) = T(0);
+      }
+      for (int p = 0; p < a.cols; p++) {
+        const T bpj = b(e, p, j);
+        for (int i = 0; i < c.rows; i++) {
+          c(e, i, j) += a(e, i, p) * bpj;
+        }
+      }
+    }
+  }
+}
+
+// c(i, j) for lanes [e0, e0 + V), accumulated in registers
+template <int V, typename T>
+inline void batched_dot_lanes(const batch_ref<const T>& a,
+                              const batch_ref<const T>& b,
+                              const batch_ref<T>& c, int i, int j, int e0)
+{
+  T acc[V] = {};
+  for (int p = 0; p < a.cols; p++) {
+    const T* aip = a.lane(i, p) + e0;
+    const T* bpj = b.lane(p, j) + e0;
+    for (int v = 0; v < V; v++) {
+      acc[v] += aip[v] * bpj[v];
+    }
+  }
+  T* cij = c.lane(i, j) + e0;
+  for (int v = 0; v < V; v++) {
+    cij[v] = acc[v];
+  }
+}
+
+template <typename T>
+inline void batched_matmul_interleaved(const batch_ref<const T>& a,
+                                       const batch_ref<const T>& b,
+                                       const batch_ref<T>& c, int b0, int b1)
+{
+  constexpr int V = 8;
+  for (int l0 = b0; l0 < b1; l0 += BATCHED_LANES) {
+    const int l1 = std::min(b1, l0 + BATCHED_LANES);
+    for (int j = 0; j < c.cols; j++) {
+      for (int i = 0; i < c.rows; i++) {
+        int e = l0;
+        for (; e + V <= l1; e += V) {
+          batched_dot_lanes<V>(a, b, c, i, j, e);
+        }
+        for (; e < l1; e++) {
+          batched_dot_lanes<1>(a, b, c, i, j, e);
+        }
+      }
+    }
+  }
+}
+
+// vectors are batch_refs with one column
+
+template <typename T>
+inline void batched_matvec_trailing(const batch_ref<const T>& a,
+                                    const batch_ref<const T>& x,
+                                    const batch_ref<T>& y, int b0, int b1)
+{
+  for (int e = b0; e < b1; e++) {
+    for (int i = 0; i < a.rows; i++) {
+      y(e, i, 0) = T(0);
+    }
+    for (int j = 0; j < a.cols; j++) {
+      const T xj = x(e, j, 0);
+      for (int i = 0; i < a.rows; i++) {
+        y(e, i, 0) += a(e, i, j) * xj;
+      }
+    }
+  }
+}
+
+template <typename T>
+inline void batched_matvec_interleaved(const batch_ref<const T>& a,
+                                       const batch_ref<const T>& x,
+                                       const batch_ref<T>& y, int b0, int b1)
+{
+  for (int l0 = b0; l0 < b1; l0 += BATCHED_LANES) {
+    const int l1 = std::min(b1, l0 + BATCHED_LANES);
+    for (int i = 0; i < a.rows; i++) {
+      T* yi = y.lane(i, 0);
+      for (int e = l0; e < l1; e++) {
+        yi[e] = T(0);
+      }
+    }
+    for (int j = 0; j < a.cols; j++) {
+      const T* xj = x.lane(j, 0);
+      for (int i = 0; i < a.rows; i++) {
+        const T* aij = a.lane(i, j);
+        T* yi = y.lane(i, 0);
+        GT_NOALIAS_LOOP
+        for (int e = l0; e < l1; e++) {
+          yi[e] += aij[e] * xj[e];
+        }
+      }
+    }
+  }
+}
+
+inline void batched_singular(int e, int k)
+{
+  throw std::runtime_error("batched_lu_factor: matrix " + std::to_string(e) +
+                           " is singular (zero pivot in column " +
+                           std::to_string(k) + ")");
+}
+
+// LU factorization with partial pivoting, as LAPACK's getrf: afterwards,
+// the unit lower and the upper triangle of P a are stored in a, and row k
+// was swapped with row piv(k) at step k (0-based)
+
+template <typename T>
+inline void batched_lu_factor_trailing(const batch_ref<T>& a,
+                                       const batch_ref<int>& piv, int b0,
+                                       int b1)
+{
+  const int n = a.rows;
+  for (int e = b0; e < b1; e++) {
+    for (int k = 0; k < n; k++) {
+      int p = k;
+      for (int i = k + 1; i < n; i++) {
+        if (std::abs(a(e, i, k)) > std::abs(a(e, p, k))) {
+          p = i;
+        }
+      }
+      piv(e, k, 0) = p;
+      if (a(e, p, k) == T(0)) {
+        batched_singular(e, k);
+      }
+      if (p != k) {
+        for (int j = 0; j < n; j++) {
+          std::swap(a(e, k, j), a(e, p, j));
+        }
+      }
+
+      const T rdiag = T(1) / a(e, k, k);
+      for (int i = k + 1; i < n; i++) {
+        a(e, i, k) *= rdiag;
+      }
+      for (int j = k + 1; j < n; j++) {
+        const T akj = a(e, k, j);
+        for (int i = k + 1; i < n; i++) {
+          a(e, i, j) -= a(e, i, k) * akj;
+        }
+      }
+    }
+  }
+}
+
+template <typename T>
+inline void batched_lu_factor_interleaved(const batch_ref<T>& a,
+                                          const batch_ref<int>& piv, int b0,
+                                          int b1)
+{
+  const int n = a.rows;
+  for (int l0 = b0; l0 < b1; l0 += BATCHED_LANES) {
+    const int l1 = std::min(b1, l0 + BATCHED_LANES);
+    int p[BATCHED_LANES];
+    T pmax[BATCHED_LANES];
+    for (int k = 0; k < n; k++) {
+      // pivot search and row swaps, per lane
+      const T* akk = a.lane(k, k);
+      for (int e = l0; e < l1; e++) {
+        p[e - l0] = k;
+        pmax[e - l0] = std::abs(akk[e]);
+      }
+      for (int i = k + 1; i < n; i++) {
+        const T* aik = a.lane(i, k);
+        for (int e = l0; e < l1; e++) {
+          const T v = std::abs(aik[e]);
+          p[e - l0] = v > pmax[e - l0] ? i : p[e - l0];
+          pmax[e - l0] = v > pmax[e - l0] ? v : pmax[e - l0];
+        }
+      }
+      int* pivk = piv.lane(k, 0);
+      for (int e = l0; e < l1; e++) {
+        pivk[e] = p[e - l0];
+        if (pmax[e - l0] == T(0)) {
+          batched_singular(e, k);
+        }
+        if (p[e - l0] != k) {
+          for (int j = 0; j < n; j++) {
+            std::swap(a(e, k, j), a(e, p[e - l0], j));
+          }
+        }
+      }
+
+      // elimination, across lanes
+      T* lk = a.lane(k, k);
+      for (int i = k + 1; i < n; i++) {
+        T* aik = a.lane(i, k);
+        GT_NOALIAS_LOOP
+        for (int e = l0; e < l1; e++) {
+          aik[e] /= lk[e];
+        }
+      }
+      for (int j = k + 1; j < n; j++) {
+        const T* akj = a.lane(k, j);
+        for (int i = k + 1; i < n; i++) {
+          const T* aik = a.lane(i, k);
+          T* aij = a.lane(i, j);
+          GT_NOALIAS_LOOP
+          for (int e = l0; e < l1; e++) {
+            aij[e] -= aik[e] * akj[e];
+          }
+        }
+      }
+    }
+  }
+}
+
+template <typename T>
+inline void batched_lu_solve_trailing(const batch_ref<const T>& lu,
+                                      const batch_ref<const int>& piv,
+                                      const batch_ref<T>& x, int b0, int b1)
+{
+  const int n = lu.rows;
+  for (int e = b0; e < b1; e++) {
+    for (int k = 0; k < n; k++) {
+      std::swap(x(e, k, 0), x(e, piv(e, k, 0), 0));
+    }
+    for (int k = 0; k < n; k++) {
+      const T xk = x(e, k, 0);
+      for (int i = k + 1; i < n; i++) {
+        x(e, i, 0) -= lu(e, i, k) * xk;
+      }
+    }
+    for (int k = n - 1; k >= 0; k--) {
+      x(e, k, 0) /= lu(e, k, k);
+      const T xk = x(e, k, 0);
+      for (int i = 0; i < k; i++) {
+        x(e, i, 0) -= lu(e, i, k) * xk;
+      }
+    }
+  }
+}
+
+template <typename T>
+inline void batched_lu_solve_interleaved(const batch_ref<const T>& lu,
+                                         const batch_ref<const int>& piv,
+                                         const batch_ref<T>& x, int b0,
+                                         int b1)
+{
+  const int n = lu.rows;
+  for (int l0 = b0; l0 < b1; l0 += BATCHED_LANES) {
+    const int l1 = std::min(b1, l0 + BATCHED_LANES);
+    for (int k = 0; k < n; k++) {
+      const int* pivk = piv.lane(k, 0);
+      for (int e = l0; e < l1; e++) {
+        std::swap(x(e, k, 0), x(e, pivk[e], 0));
+      }
+    }
+    for (int k = 0; k < n; k++) {
+      const T* xk = x.lane(k, 0);
+      for (int i = k + 1; i < n; i++) {
+        const T* lik = lu.lane(i, k);
+        T* xi = x.lane(i, 0);
+        GT_NOALIAS_LOOP
+        for (int e = l0; e < l1; e++) {
+          xi[e] -= lik[e] * xk[e];
+        }
+      }
+    }
+    for (int k = n - 1; k >= 0; k--) {
+      const T* ukk = lu.lane(k, k);
+      T* xk = x.lane(k, 0);
+      for (int e = l0; e < l1; e++) {
+        xk[e] /= ukk[e];
+      }
+      for (int i = 0; i < k; i++) {
+        const T* uik = lu.lane(i, k);
+        T* xi = x.lane(i, 0);
+        GT_NOALIAS_LOOP
+        for (int e = l0; e < l1; e++) {
+          xi[e] -= uik[e] * xk[e];
+        }
+      }
+    }
+  }
+}
+
+template <typename T>
+inline batch_ref<const T> as_const(const batch_ref<T>& r)
+{
+  return {r.data, r.batch, r.rows, r.cols, r.sb, r.si, r.sj};
+}
+
+inline void batched_check(bool ok, const char* what)
+{
+  if (!ok) {
+    throw std::runtime_error(std::string("batched: ") + what);
+  }
+}
+
+} // namespace detail
+
+// ======================================================================
+// batched operations
+//
+// Matrices come as 3-d gtensors, vectors as 2-d gtensors, with the batch
+// dimension last (batch_layout::trailing, the default) or first
+// (batch_layout::interleaved), e.g., for trailing layout, batched_matmul()
+// of shapes (m, k, nb) and (k, n, nb) gives shape (m, n, nb), and
+// batched_matvec() of (m, n, nb) and (n, nb) gives (m, nb). Batch entries
+// are spread across threads if there's enough work.
+//
+// batched_lu_factor() factorizes square matrices in place, returning the
+// pivots in an int array of vector shape, and throws if a matrix is
+// singular. batched_lu_solve() then solves for one right-hand side vector
+// per matrix, in place.
+
+template <typename T>
+gtensor<T, 3> batched_matmul(const gtensor<T, 3>& a, const gtensor<T, 3>& b,
+                             batch_layout layout = batch_layout::trailing)
+{
+  using namespace detail;
+  deferred_assign<space::host>::flush();
+  const bool tr = layout == batch_layout::trailing;
+  auto ar = make_batch_ref<3>(a.data(), a, layout);
+  auto br = make_batch_ref<3>(b.data(), b, layout);
+  batched_check(ar.batch == br.batch && ar.cols == br.rows,
+                "batched_matmul: shapes don't match");
+
+  gtensor<T, 3> c(tr ? gt::shape(ar.rows, br.cols, ar.batch)
+                     : gt::shape(ar.batch, ar.rows, br.cols));
+  auto cr = make_batch_ref<3>(c.data(), c, layout);
+  batched_parallel(ar.batch, size_type(ar.rows) * ar.cols * br.cols,
+                   tr ? 1 : BATCHED_LANES, [&](int b0, int b1) {
+                     if (tr) {
+                       batched_matmul_trailing(as_const(ar), as_const(br), cr,
+                                               b0, b1);
+                     } else {
+                       batched_matmul_interleaved(as_const(ar), as_const(br),
+                                                  cr, b0, b1);
+                     }
+                   });
+  return c;
+}
+
+template <typename T>
+gtensor<T, 2> batched_matvec(const gtensor<T, 3>& a, const gtensor<T, 2>& x,
+                             batch_layout layout = batch_layout::trailing)
+{
+  using namespace detail;
+  deferred_assign<space::host>::flush();
+  const bool tr = layout == batch_layout::trailing;
+  auto ar = make_batch_ref<3>(a.data(), a, layout);
+  auto xr = make_batch_ref<2>(x.data(), x, layout);
+  batched_check(ar.batch == xr.batch && ar.cols == xr.rows,
+                "batched_matvec: shapes don't match");
+
+  gtensor<T, 2> y(tr ? gt::shape(ar.rows, ar.batch)
+                     : gt::shape(ar.batch, ar.rows));
+  auto yr = make_batch_ref<2>(y.data(), y, layout);
+  batched_parallel(ar.batch, size_type(ar.rows) * ar.cols,
+                   tr ? 1 : BATCHED_LANES, [&](int b0, int b1) {
+                     if (tr) {
+                       batched_matvec_trailing(as_const(ar), as_const(xr), yr,
+                                               b0, b1);
+                     } else {
+                       batched_matvec_interleaved(as_const(ar), as_const(xr),
+                                                  yr, b0, b1);
+                     }
+                   });
+  return y;
+}
+
+template <typename T>
+gtensor<int, 2> batched_lu_factor(gtensor<T, 3>& a,
+                                  batch_layout layout = batch_layout::trailing)
+{
+  using namespace detail;
+  deferred_assign<space::host>::flush();
+  const bool tr = layout == batch_layout::trailing;
+  auto ar = make_batch_ref<3>(a.data(), a, layout);
+  batched_check(ar.rows == ar.cols, "batched_lu_factor: needs square matrices");
+
+  gtensor<int, 2> piv(tr ? gt::shape(ar.rows, ar.batch)
+                         : gt::shape(ar.batch, ar.rows));
+  auto pr = make_batch_ref<2>(piv.data(), piv, layout);
+  batched_parallel(ar.batch, size_type(ar.rows) * ar.rows * ar.rows / 3 + 1,
+                   tr ? 1 : BATCHED_LANES, [&](int b0, int b1) {
+                     if (tr) {
+                       batched_lu_factor_trailing(ar, pr, b0, b1);
+                     } else {
+                       batched_lu_factor_interleaved(ar, pr, b0, b1);
+                     }
+                   });
+  return piv;
+}
+
+template <typename T>
+void batched_lu_solve(const gtensor<T, 3>& lu, const gtensor<int, 2>& piv,
+                      gtensor<T, 2>& x,
+                      batch_layout layout = batch_layout::trailing)
+{
+  using namespace detail;
+  deferred_assign<space::host>::flush();
+  const bool tr = layout == batch_layout::trailing;
+  auto lr = make_batch_ref<3>(lu.data(), lu, layout);
+  auto pr = make_batch_ref<2>(piv.data(), piv, layout);
+  auto xr = make_batch_ref<2>(x.data(), x, layout);
+  batched_check(lr.rows == lr.cols && lr.batch == xr.batch &&
+                  lr.rows == xr.rows && pr.batch == lr.batch &&
+                  pr.rows == lr.rows,
+                "batched_lu_solve: shapes don't match");
+
+  batched_parallel(lr.batch, size_type(lr.rows) * lr.rows,
+                   tr ? 1 : BATCHED_LANES, [&](int b0, int b1) {
+                     if (tr) {
+                       batched_lu_solve_trailing(as_const(lr), as_const(pr),
+                                                 xr, b0, b1);
+                     } else {
+                       batched_lu_solve_interleaved(as_const(lr),
+                                                    as_const(pr), xr, b0, b1);
+                     }
+                   });
+}
+
+} // namespace gt
+
+#endif
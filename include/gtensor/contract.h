@@ -0,0 +1,616 @@
+
+// ======================================================================
+// contract.h
+//
+// tensordot, einsum : contractions of arrays over one or more indices
+
+#ifndef GTENSOR_CONTRACT_H
+#define GTENSOR_CONTRACT_H
+
+#include "batched.h"
+#include "defs.h"
+#include "fusion.h"
+#include "gemm.h"
+#include "gtensor.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace gt
+{
+
+namespace detail
+{
+
+// above this many multiply-adds, operands that can't be seen as matrices
+// in place are copied so that the contraction can go to gemm
+constexpr const size_type CONTRACT_GEMM_MIN = 32 * 32 * 32;
+
+// ----------------------------------------------------------------------
+// contract_index
+//
+// One index of a contraction c = sum a * b: its extent, and its strides in
+// a, b and c, which are 0 where it doesn't appear. An index that appears
+// more than once in an operand has the sum of its strides there, which
+// walks the diagonal.
+
+struct contract_index
+{
+  int extent;
+  std::ptrdiff_t sa;
+  std::ptrdiff_t sb;
+  std::ptrdiff_t sc;
+  int na; // how often it appears in a
+  int nb; // how often it appears in b
+  bool in_c;
+};
+
+using contract_stride = std::ptrdiff_t contract_index::*;
+
+// walks the points of indices g in col-major order, keeping track of the
+// offsets in a, b and c
+class contract_walker
+{
+public:
+  contract_walker(const std::vector<contract_index>& g, size_type start)
+    : g_(g), pos_(g.size())
+  {
+    for (size_type d = 0; d < g_.size(); d++) {
+      const int extent = std::max(1, g_[d].extent);
+      pos_[d] = start % extent;
+      start /= extent;
+      oa += pos_[d] * g_[d].sa;
+      ob += pos_[d] * g_[d].sb;
+      oc += pos_[d] * g_[d].sc;
+    }
+  }
+
+  void next()
+  {
+    for (size_type d = 0; d < g_.size(); d++) {
+      auto& i = g_[d];
+      if (++pos_[d] < i.extent) {
+        oa += i.sa;
+        ob += i.sb;
+        oc += i.sc;
+        return;
+      }
+      pos_[d] = 0;
+      oa -= (i.extent - 1) * i.sa;
+      ob -= (i.extent - 1) * i.sb;
+      oc -= (i.extent - 1) * i.sc;
+    }
+  }
+
+  std::ptrdiff_t oa = 0, ob = 0, oc = 0;
+
+private:
+  const std::vector<contract_index>& g_;
+  std::vector<int> pos_;
+};
+
+inline size_type contract_size(const std::vector<contract_index>& g)
+{
+  size_type n = 1;
+  for (auto& i : g) {
+    n *= i.extent;
+  }
+  return n;
+}
+
+// whether the indices g, in this order, can be fused into a single one
+// with strides s, and its stride if so
+inline bool contract_fuse(const std::vector<contract_index>& g,
+                          contract_stride s, std::ptrdiff_t& stride)
+{
+  bool first = true;
+  std::ptrdiff_t next = 0;
+  stride = 1;
+  for (auto& i : g) {
+    if (i.extent == 1) {
+      continue;
+    }
+    if (first) {
+      stride = i.*s;
+      first = false;
+    } else if (i.*s != next) {
+      return false;
+    }
+    next = i.*s * i.extent;
+  }
+  return true;
+}
+
+inline void contract_sort(std::vector<contract_index>& g, contract_stride s)
+{
+  std::stable_sort(g.begin(), g.end(),
+                   [&](const contract_index& x, const contract_index& y) {
+                     return std::abs(x.*s) < std::abs(y.*s);
+                   });
+}
+
+// copies the points of g (strides s) into tmp in order, and makes s the
+// strides of tmp
+template <typename T>
+inline const T* contract_pack(const T* data,
+                              std::vector<std::vector<contract_index>*> gs,
+                              contract_stride s, std::vector<T>& tmp)
+{
+  std::vector<contract_index> all;
+  for (auto g : gs) {
+    all.insert(all.end(), g->begin(), g->end());
+  }
+  tmp.resize(contract_size(all));
+  std::vector<contract_index> walk = all;
+  for (auto& i : walk) {
+    i.sa = i.*s;
+  }
+  contract_walker w(walk, 0);
+  for (size_type p = 0; p < tmp.size(); p++, w.next()) {
+    tmp[p] = data[w.oa];
+  }
+  std::ptrdiff_t stride = 1;
+  for (auto g : gs) {
+    for (auto& i : *g) {
+      i.*s = stride;
+      stride *= i.extent;
+    }
+  }
+  return tmp.data();
+}
+
+// c = a * b as a matrix product: the free indices of a are the rows, those
+// of b the columns, and the shared ones are summed over. Operands whose
+// indices don't fuse in place are copied first, c is written through a
+// temporary if its don't.
+template <typename T>
+inline void contract_gemm(const T* a, const T* b, T* c,
+                          std::vector<contract_index> fa,
+                          std::vector<contract_index> fb,
+                          std::vector<contract_index> k)
+{
+  std::ptrdiff_t ars, acs, brs, bcs, crs, ccs;
+  std::vector<T> a_tmp, b_tmp, c_tmp;
+  if (!contract_fuse(fa, &contract_index::sa, ars) ||
+      !contract_fuse(k, &contract_index::sa, acs)) {
+    a = contract_pack(a, {&fa, &k}, &contract_index::sa, a_tmp);
+    contract_fuse(fa, &contract_index::sa, ars);
+    contract_fuse(k, &contract_index::sa, acs);
+  }
+  if (!contract_fuse(k, &contract_index::sb, brs) ||
+      !contract_fuse(fb, &contract_index::sb, bcs)) {
+    b = contract_pack(b, {&k, &fb}, &contract_index::sb, b_tmp);
+    contract_fuse(k, &contract_index::sb, brs);
+    contract_fuse(fb, &contract_index::sb, bcs);
+  }
+  const int m = contract_size(fa), n = contract_size(fb);
+  const int kk = contract_size(k);
+  T* cc = c;
+  std::vector<contract_index> c_walk;
+  if (!contract_fuse(fa, &contract_index::sc, crs) ||
+      !contract_fuse(fb, &contract_index::sc, ccs)) {
+    c_walk = fa;
+    c_walk.insert(c_walk.end(), fb.begin(), fb.end());
+    c_tmp.resize(size_type(m) * n);
+    cc = c_tmp.data();
+    crs = 1;
+    ccs = m;
+  }
+
+  matrix_ref<const T> am{a, m, kk, ars, acs};
+  matrix_ref<const T> bm{b, kk, n, brs, bcs};
+  matrix_ref<T> cm{cc, m, n, crs, ccs};
+  if (kk == 0) {
+    gemm_scale(T(0), cm);
+  } else if (!gemm_cblas(T(1), am, bm, T(0), cm)) {
+    gemm_blocked(T(1), am, bm, T(0), cm);
+  }
+
+  if (cc != c) {
+    contract_walker w(c_walk, 0);
+    for (size_type p = 0; p < c_tmp.size(); p++, w.next()) {
+      c[w.oc] = c_tmp[p];
+    }
+  }
+}
+
+// c = sum a * b over the indices not in c, as a loop nest: threads take
+// the points of c apart from its innermost index, and for each, loop over
+// the summed indices, with the innermost index of c innermost
+template <typename T>
+inline void contract_direct(const T* a, const T* b, T* c,
+                            const std::vector<contract_index>& idx)
+{
+  std::vector<contract_index> outer, sum;
+  contract_index inner{1, 0, 0, 0, 0, 0, true};
+  for (auto& i : idx) {
+    if (!i.in_c) {
+      sum.push_back(i);
+    } else if (i.extent > 1 &&
+               (inner.extent == 1 || std::abs(i.sc) < std::abs(inner.sc))) {
+      if (inner.extent > 1) {
+        outer.push_back(inner);
+      }
+      inner = i;
+    } else {
+      outer.push_back(i);
+    }
+  }
+
+  // offsets of the summed points in a and b
+  const size_type n_sum = contract_size(sum);
+  std::vector<std::ptrdiff_t> sum_a(n_sum), sum_b(n_sum);
+  contract_walker ws(sum, 0);
+  for (size_type s = 0; s < n_sum; s++, ws.next()) {
+    sum_a[s] = ws.oa;
+    sum_b[s] = ws.ob;
+  }
+
+  const size_type n_outer = contract_size(outer);
+  const int ni = inner.extent;
+  const std::ptrdiff_t ia = inner.sa, ib = inner.sb, ic = inner.sc;
+  batched_parallel(n_outer, n_sum * ni, 1, [&](int p0, int p1) {
+    contract_walker w(outer, p0);
+    for (int p = p0; p < p1; p++, w.next()) {
+      T* pc = c + w.oc;
+      for (int i = 0; i < ni; i++) {
+        pc[i * ic] = T(0);
+      }
+      for (size_type s = 0; s < n_sum; s++) {
+        const T* pa = a + w.oa + sum_a[s];
+        const T* pb = b + w.ob + sum_b[s];
+        if (ic == 1) {
+          GT_NOALIAS_LOOP
+          for (int i = 0; i < ni; i++) {
+            pc[i] += pa[i * ia] * pb[i * ib];
+          }
+        } else {
+          GT_NOALIAS_LOOP
+          for (int i = 0; i < ni; i++) {
+            pc[i * ic] += pa[i * ia] * pb[i * ib];
+          }
+        }
+      }
+    }
+  });
+}
+
+// c = sum a * b over the indices not in c, by gemm where each index is
+// either summed over, appearing once in each of a and b, or free, appearing
+// once in just one of them and in c, and the operands can be used as
+// matrices in place or are big enough to make copying worthwhile; by a
+// direct loop nest otherwise
+template <typename T>
+inline void contract(const T* a, const T* b, T* c,
+                     const std::vector<contract_index>& idx)
+{
+  std::vector<contract_index> fa, fb, k;
+  bool gemm = true;
+  for (auto& i : idx) {
+    if (i.na == 1 && i.nb == 1 && !i.in_c) {
+      k.push_back(i);
+    } else if (i.na == 1 && i.nb == 0 && i.in_c) {
+      fa.push_back(i);
+    } else if (i.na == 0 && i.nb == 1 && i.in_c) {
+      fb.push_back(i);
+    } else {
+      gemm = false;
+    }
+  }
+  if (gemm) {
+    // the order of the free indices is up to c, the summed ones are lined
+    // up with a, or b if that doesn't work for a
+    contract_sort(fa, &contract_index::sc);
+    contract_sort(fb, &contract_index::sc);
+    contract_sort(k, &contract_index::sa);
+    std::ptrdiff_t s;
+    if (!contract_fuse(k, &contract_index::sb, s)) {
+      auto kb = k;
+      contract_sort(kb, &contract_index::sb);
+      if (contract_fuse(kb, &contract_index::sa, s)) {
+        k = kb;
+      }
+    }
+    const bool in_place = contract_fuse(fa, &contract_index::sa, s) &&
+                          contract_fuse(k, &contract_index::sa, s) &&
+                          contract_fuse(k, &contract_index::sb, s) &&
+                          contract_fuse(fb, &contract_index::sb, s) &&
+                          contract_fuse(fa, &contract_index::sc, s) &&
+                          contract_fuse(fb, &contract_index::sc, s);
+    const size_type work = contract_size(fa) * contract_size(fb) *
+                           std::max(size_type(1), contract_size(k));
+    gemm = in_place || work >= CONTRACT_GEMM_MIN;
+  }
+  if (gemm) {
+    contract_gemm(a, b, c, fa, fb, k);
+  } else {
+    contract_direct(a, b, c, idx);
+  }
+}
+
+template <typename EA, typename EB>
+using contract_value_type =
+  std::decay_t<decltype(std::declval<expr_value_type<EA>>() *
+                        std::declval<expr_value_type<EB>>())>;
+
+// einsum on operands given as pointer, shape and strides
+template <typename T, int R, size_type N>
+inline gtensor<T, R> einsum(const std::string& spec, const T* const (&data)[N],
+                            const std::vector<int> (&shapes)[N],
+                            const std::vector<int> (&strides)[N])
+{
+  auto fail = [&](const std::string& what) {
+    throw std::runtime_error("einsum: \"" + spec + "\": " + what);
+  };
+  const auto arrow = spec.find("->");
+  const std::string lhs = spec.substr(0, arrow);
+  std::vector<std::string> terms(1);
+  for (char ch : lhs) {
+    if (ch == ',') {
+      terms.emplace_back();
+    } else if (ch != ' ') {
+      terms.back() += ch;
+    }
+  }
+  if (terms.size() != N) {
+    fail("needs " + std::to_string(N) + " operands");
+  }
+
+  // the indices by letter
+  std::vector<contract_index> idx;
+  std::string letters;
+  auto find = [&](char ch) -> contract_index& {
+    if (!std::isalpha(static_cast<unsigned char>(ch))) {
+      fail(std::string("bad index '") + ch + "'");
+    }
+    auto pos = letters.find(ch);
+    if (pos == std::string::npos) {
+      letters += ch;
+      idx.push_back({-1, 0, 0, 0, 0, 0, false});
+      pos = idx.size() - 1;
+    }
+    return idx[pos];
+  };
+  for (size_type t = 0; t < N; t++) {
+    if (terms[t].size() != shapes[t].size()) {
+      fail("operand " + std::to_string(t) + " has " +
+           std::to_string(shapes[t].size()) + " dimensions");
+    }
+    for (size_type d = 0; d < terms[t].size(); d++) {
+      auto& i = find(terms[t][d]);
+      if (i.extent >= 0 && i.extent != shapes[t][d]) {
+        fail(std::string("extents of '") + terms[t][d] + "' don't match");
+      }
+      i.extent = shapes[t][d];
+      (t == 0 ? i.sa : i.sb) += strides[t][d];
+      (t == 0 ? i.na : i.nb)++;
+    }
+  }
+
+  // the result's indices, by default those appearing just once, sorted
+  std::string out;
+  if (arrow != std::string::npos) {
+    for (char ch : spec.substr(arrow + 2)) {
+      if (ch != ' ') {
+        out += ch;
+      }
+    }
+  } else {
+    for (size_type l = 0; l < letters.size(); l++) {
+      if (idx[l].na + idx[l].nb == 1) {
+        out += letters[l];
+      }
+    }
+    std::sort(out.begin(), out.end());
+  }
+  if (out.size() != R) {
+    fail("result has " + std::to_string(out.size()) + " indices, not " +
+         std::to_string(R));
+  }
+  shape_type<R> shape;
+  for (int d = 0; d < R; d++) {
+    auto pos = letters.find(out[d]);
+    if (pos == std::string::npos || out.find(out[d]) != size_type(d)) {
+      fail(std::string("bad result index '") + out[d] + "'");
+    }
+    shape[d] = idx[pos].extent;
+  }
+
+  gtensor<T, R> c(shape);
+  for (int d = 0; d < R; d++) {
+    auto& i = idx[letters.find(out[d])];
+    i.sc = c.strides()[d];
+    i.in_c = true;
+  }
+  // a single operand is multiplied by one
+  const T one = T(1);
+  if (c.size() > 0) {
+    contract(data[0], N > 1 ? data[N - 1] : &one, c.data(), idx);
+  }
+  return c;
+}
+
+template <typename T, size_type N>
+inline std::vector<int> to_vector(const sarray<T, N>& a)
+{
+  std::vector<int> v(N);
+  for (int d = 0; d < int(N); d++) {
+    v[d] = a[d];
+  }
+  return v;
+}
+
+} // namespace detail
+
+// ======================================================================
+// tensordot
+//
+// Contracts axes_a of a with axes_b of b, that is, sums a * b over those
+// pairs of indices, e.g.,
+//
+//   tensordot(a, b, gt::shape(1, 2), gt::shape(0, 1))
+//
+// for c(i, l) = sum_jk a(i, j, k) * b(j, k, l). The result's indices are
+// the remaining ones of a, then those of b, in order. Without axes, the
+// last K axes of a are contracted with the first K of b.
+//
+// The contraction is done by gemm where the operands can be seen as
+// matrices in place (e.g., gtensors contracted over leading or trailing
+// axes), or if it's big enough to be worth copying them so that they can.
+// Otherwise, and for small cases, it's done by a loop nest spread across
+// threads. Operands are read in place if they're stored in memory (as
+// gtensors and their views are); other expressions are evaluated first.
+
+template <size_type K, typename EA, typename EB>
+auto tensordot(const EA& a, const EB& b, const sarray<int, K>& axes_a,
+               const sarray<int, K>& axes_b)
+{
+  using T = detail::contract_value_type<EA, EB>;
+  constexpr int NA = expr_dimension<EA>(), NB = expr_dimension<EB>();
+  constexpr int R = NA + NB - 2 * int(K);
+  static_assert(R >= 1, "tensordot: result needs at least one dimension");
+  static_assert(std::is_same<expr_space_type<EA>, space::host>::value &&
+                  std::is_same<expr_space_type<EB>, space::host>::value,
+                "tensordot: only implemented on the host");
+
+  bool used_a[NA] = {}, used_b[NB] = {};
+  for (int q = 0; q < int(K); q++) {
+    const int da = axes_a[q], db = axes_b[q];
+    if (da < 0 || da >= NA || db < 0 || db >= NB || used_a[da] ||
+        used_b[db] || a.shape(da) != b.shape(db)) {
+      throw std::runtime_error("tensordot: can't contract axes " +
+                               to_string(axes_a) + " of " +
+                               to_string(a.shape()) + " with " +
+                               to_string(axes_b) + " of " +
+                               to_string(b.shape()));
+    }
+    used_a[da] = used_b[db] = true;
+  }
+
+  // reads the data of a and b directly
+  detail::deferred_assign<space::host>::flush();
+  gtensor<T, NA> a_tmp;
+  gtensor<T, NB> b_tmp;
+  shape_type<NA> as;
+  shape_type<NB> bs;
+  auto pa = detail::stored_data(a, a_tmp, as);
+  auto pb = detail::stored_data(b, b_tmp, bs);
+
+  shape_type<R> shape;
+  int r = 0;
+  for (int d = 0; d < NA; d++) {
+    if (!used_a[d]) {
+      shape[r++] = a.shape(d);
+    }
+  }
+  for (int d = 0; d < NB; d++) {
+    if (!used_b[d]) {
+      shape[r++] = b.shape(d);
+    }
+  }
+  gtensor<T, R> c(shape);
+  if (c.size() == 0) {
+    return c;
+  }
+
+  std::vector<detail::contract_index> idx;
+  r = 0;
+  for (int d = 0; d < NA; d++) {
+    if (!used_a[d]) {
+      idx.push_back({a.shape(d), as[d], 0, c.strides()[r++], 1, 0, true});
+    }
+  }
+  for (int d = 0; d < NB; d++) {
+    if (!used_b[d]) {
+      idx.push_back({b.shape(d), 0, bs[d], c.strides()[r++], 0, 1, true});
+    }
+  }
+  for (int q = 0; q < int(K); q++) {
+    idx.push_back({a.shape(axes_a[q]), as[axes_a[q]], bs[axes_b[q]], 0, 1, 1,
+                   false});
+  }
+  detail::contract(pa, pb, c.data(), idx);
+  return c;
+}
+
+template <size_type K, typename EA, typename EB>
+auto tensordot(const EA& a, const EB& b)
+{
+  constexpr int NA = expr_dimension<EA>();
+  sarray<int, K> axes_a, axes_b;
+  for (int q = 0; q < int(K); q++) {
+    axes_a[q] = NA - int(K) + q;
+    axes_b[q] = q;
+  }
+  return tensordot(a, b, axes_a, axes_b);
+}
+
+// ======================================================================
+// einsum
+//
+// Contractions written in Einstein summation notation, as in numpy, with
+// one letter per index and the R indices of the result after "->", e.g.,
+//
+//   einsum<2>("ij,jk->ik", a, b)     matrix product
+//   einsum<1>("ijk,jk->i", a, b)     contraction over two indices
+//   einsum<2>("bi,bj->ij", a, b)     sum of outer products
+//   einsum<1>("ii->i", a)            diagonal
+//   einsum<2>("ij->ji", a)           transpose
+//
+// Indices that don't appear in the result are summed over; without "->",
+// the result's indices are those that appear just once, in alphabetical
+// order. Indices can repeat within an operand, which takes its diagonal.
+// Contractions that tensordot could do go the same way (see above), any
+// others by the loop nest.
+
+template <int R, typename EA, typename EB>
+auto einsum(const std::string& spec, const EA& a, const EB& b)
+{
+  using T = detail::contract_value_type<EA, EB>;
+  constexpr int NA = expr_dimension<EA>(), NB = expr_dimension<EB>();
+  static_assert(R >= 1, "einsum: result needs at least one dimension");
+  static_assert(std::is_same<expr_space_type<EA>, space::host>::value &&
+                  std::is_same<expr_space_type<EB>, space::host>::value,
+                "einsum: only implemented on the host");
+
+  // reads the data of a and b directly
+  detail::deferred_assign<space::host>::flush();
+  gtensor<T, NA> a_tmp;
+  gtensor<T, NB> b_tmp;
+  shape_type<NA> as;
+  shape_type<NB> bs;
+  const T* const data[2] = {detail::stored_data(a, a_tmp, as),
+                            detail::stored_data(b, b_tmp, bs)};
+  const std::vector<int> shapes[2] = {detail::to_vector(a.shape()),
+                                      detail::to_vector(b.shape())};
+  const std::vector<int> strides[2] = {detail::to_vector(as),
+                                       detail::to_vector(bs)};
+  return detail::einsum<T, R>(spec, data, shapes, strides);
+}
+
+template <int R, typename EA>
+auto einsum(const std::string& spec, const EA& a)
+{
+  using T = std::decay_t<expr_value_type<EA>>;
+  constexpr int NA = expr_dimension<EA>();
+  static_assert(R >= 1, "einsum: result needs at least one dimension");
+  static_assert(std::is_same<expr_space_type<EA>, space::host>::value,
+                "einsum: only implemented on the host");
+
+  detail::deferred_assign<space::host>::flush();
+  gtensor<T, NA> a_tmp;
+  shape_type<NA> as;
+  const T* const data[1] = {detail::stored_data(a, a_tmp, as)};
+  const std::vector<int> shapes[1] = {detail::to_vector(a.shape())};
+  const std::vector<int> strides[1] = {detail::to_vector(as)};
+  return detail::einsum<T, R>(spec, data, shapes, strides);
+}
+
+} // namespace gt
+
+#endif
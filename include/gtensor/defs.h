@@ -19,6 +19,20 @@ class sarray;
 template <size_type N>
 using shape_type = sarray<int, N>;
 
+namespace detail
+{
+
+// default shape type for gtensor<T, N>, gtensor_view<T, N>. Going through a
+// nested type keeps it a non-deduced context, so that function templates
+// taking gtensor<T, N> with `int N` can still deduce N.
+template <int N>
+struct default_shape_type
+{
+  using type = shape_type<N>;
+};
+
+} // namespace detail
+
 } // namespace gt
 
 #endif
@@ -0,0 +1,371 @@
+
+// ======================================================================
+// distributed.h
+//
+// distributed_gtensor : a global array decomposed into ghosted subdomains,
+// with halo exchange between neighbouring subdomains
+
+#ifndef GTENSOR_DISTRIBUTED_H
+#define GTENSOR_DISTRIBUTED_H
+
+#include "defs.h"
+#include "ghosted.h"
+#include "gtensor.h"
+
+#include <algorithm>
+#include <future>
+#include <map>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+namespace gt
+{
+
+// ======================================================================
+// message
+//
+// One face's worth of halo data travelling from rank `from` to rank `to`.
+// The tag tells apart the messages between the same two ranks within one
+// exchange.
+
+template <typename T>
+struct message
+{
+  int from;
+  int to;
+  int tag;
+  T* data;
+  size_type size;
+};
+
+// ======================================================================
+// thread_transport
+//
+// Transport for subdomains that all live in this process, each worked on
+// by its own thread. A transport provides
+//
+//   std::vector<int> local_ranks(int n_ranks)
+//
+// the ranks of the subdomains held by this process, and
+//
+//   template <typename T>
+//   void exchange(std::vector<message<T>>& sends,
+//                 std::vector<message<T>>& recvs)
+//
+// which delivers the data of each send to the recv with the same from, to
+// and tag. It may either copy the data into the recv's buffer, or point
+// the recv's data at where it can be read until the next exchange. Since
+// the sends are all in this process, the thread transport does the latter,
+// so a face is copied only by pack() and unpack().
+
+class thread_transport
+{
+public:
+  std::vector<int> local_ranks(int n_ranks) const
+  {
+    std::vector<int> ranks(n_ranks);
+    for (int r = 0; r < n_ranks; r++) {
+      ranks[r] = r;
+    }
+    return ranks;
+  }
+
+  template <typename T>
+  void exchange(std::vector<message<T>>& sends,
+                std::vector<message<T>>& recvs) const
+  {
+    std::map<std::tuple<int, int, int>, const message<T>*> posted;
+    for (const auto& s : sends) {
+      posted[std::make_tuple(s.from, s.to, s.tag)] = &s;
+    }
+    for (auto& r : recvs) {
+      auto it = posted.find(std::make_tuple(r.from, r.to, r.tag));
+      if (it == posted.end() || it->second->size != r.size) {
+        throw std::runtime_error("thread_transport: unmatched message");
+      }
+      r.data = it->second->data;
+    }
+  }
+};
+
+// ======================================================================
+// distributed_gtensor
+//
+// A host array of shape `global_shape`, decomposed on a grid of `procs`
+// subdomains, each stored as a ghosted_gtensor with `ghosts` ghost points
+// per side. Along each dimension, the subdomains split the global extent
+// as evenly as possible, and they are numbered (ranked) in col-major order
+// of their grid coordinates. Along dimensions where `periodic` is set, the
+// first and last subdomains are neighbours; elsewhere, the halos at the
+// global boundary are left alone by the exchange.
+//
+// The Transport (thread_transport by default, mpi_transport from
+// mpi_transport.h) decides which subdomains this process holds: all of them
+// with threads, one per MPI rank with MPI. The local subdomains are indexed
+// 0 .. n_local() - 1:
+//
+//   gt::distributed_gtensor<double, 2> u(gt::shape(nx, ny), gt::shape(2, 2),
+//                                        gt::shape(1, 1));
+//   u.for_each_local([&](int i) { init(u.local(i), u.offset(i)); });
+//   u.exchange_halos();
+//
+// exchange_halos() exchanges dimension by dimension, including the halos of
+// the previous dimensions in the faces, so that edge and corner ghosts are
+// filled, too. Within a dimension, the subdomains pack and unpack their
+// faces in parallel. exchange_halos_async() runs the same in the
+// background, so that the points which don't depend on the halos, core(i),
+// can be computed in the meantime. Until the returned future is ready, the
+// interiors may be read but not written.
+
+template <typename T, int N, typename Transport = thread_transport>
+class distributed_gtensor
+{
+public:
+  using value_type = T;
+  using shape_type = gt::shape_type<N>;
+  using local_type = ghosted_gtensor<T, N>;
+  using view_type = typename local_type::view_type;
+
+  distributed_gtensor(const shape_type& global_shape, const shape_type& procs,
+                      const shape_type& ghosts,
+                      const sarray<bool, N>& periodic = {},
+                      Transport transport = {});
+
+  distributed_gtensor(const distributed_gtensor&) = delete;
+  distributed_gtensor& operator=(const distributed_gtensor&) = delete;
+
+  const shape_type& shape() const { return global_shape_; }
+  int shape(int d) const { return global_shape_[d]; }
+  const shape_type& procs() const { return procs_; }
+  const shape_type& ghosts() const { return ghosts_; }
+  int n_ranks() const { return calc_size(procs_); }
+  int n_local() const { return local_.size(); }
+
+  local_type& local(int i) { return local_[i]; }
+  const local_type& local(int i) const { return local_[i]; }
+  int rank(int i) const { return ranks_[i]; }
+  const shape_type& offset(int i) const { return offsets_[i]; }
+  view_type core(int i) const;
+
+  Transport& transport() { return transport_; }
+
+  template <typename F>
+  void for_each_local(F&& f) const;
+
+  void exchange_halos();
+  std::future<void> exchange_halos_async();
+
+private:
+  shape_type coords(int rank) const;
+  int neighbor(int rank, int d, int side) const;
+  void exchange_dim(int d);
+
+  shape_type global_shape_;
+  shape_type procs_;
+  shape_type ghosts_;
+  sarray<bool, N> periodic_;
+  Transport transport_;
+
+  std::vector<int> ranks_;
+  std::vector<shape_type> offsets_;
+  std::vector<local_type> local_;
+  // per local subdomain, dimension and side
+  std::vector<std::vector<T>> send_bufs_;
+  std::vector<std::vector<T>> recv_bufs_;
+};
+
+// ----------------------------------------------------------------------
+// distributed_gtensor implementation
+
+namespace detail
+{
+
+// runs f(0), ..., f(n - 1) concurrently, f(0) on the calling thread
+template <typename F>
+inline void parallel_for_each(int n, F&& f)
+{
+  std::vector<std::future<void>> others;
+  for (int i = 1; i < n; i++) {
+    others.push_back(std::async(std::launch::async, f, i));
+  }
+  if (n > 0) {
+    f(0);
+  }
+  for (auto& other : others) {
+    other.get();
+  }
+}
+
+// the part of [0, n) out of p parts that part c gets
+inline void split_extent(int n, int p, int c, int& offset, int& size)
+{
+  offset = c * (n / p) + std::min(c, n % p);
+  size = n / p + (c < n % p ? 1 : 0);
+}
+
+} // namespace detail
+
+template <typename T, int N, typename Transport>
+inline distributed_gtensor<T, N, Transport>::distributed_gtensor(
+  const shape_type& global_shape, const shape_type& procs,
+  const shape_type& ghosts, const sarray<bool, N>& periodic,
+  Transport transport)
+  : global_shape_(global_shape),
+    procs_(procs),
+    ghosts_(ghosts),
+    periodic_(periodic),
+    transport_(std::move(transport))
+{
+  for (int d = 0; d < N; d++) {
+    if (procs[d] < 1 || procs[d] > global_shape[d]) {
+      throw std::runtime_error("distributed_gtensor: cannot split " +
+                               to_string(global_shape) + " on " +
+                               to_string(procs) + " subdomains");
+    }
+  }
+
+  ranks_ = transport_.local_ranks(n_ranks());
+  for (auto rank : ranks_) {
+    auto c = coords(rank);
+    shape_type offset, shape;
+    for (int d = 0; d < N; d++) {
+      detail::split_extent(global_shape[d], procs[d], c[d], offset[d],
+                           shape[d]);
+      if (shape[d] < ghosts[d] && (procs[d] > 1 || periodic[d])) {
+        throw std::runtime_error(
+          "distributed_gtensor: subdomains thinner than ghosts");
+      }
+    }
+    offsets_.push_back(offset);
+    local_.emplace_back(shape, ghosts);
+    for (int d = 0; d < N; d++) {
+      for (int side = 0; side < 2; side++) {
+        send_bufs_.emplace_back(local_.back().face_size(d));
+        recv_bufs_.emplace_back(local_.back().face_size(d));
+      }
+    }
+  }
+}
+
+template <typename T, int N, typename Transport>
+inline auto distributed_gtensor<T, N, Transport>::coords(int rank) const
+  -> shape_type
+{
+  shape_type c;
+  for (int d = 0; d < N; d++) {
+    c[d] = rank % procs_[d];
+    rank /= procs_[d];
+  }
+  return c;
+}
+
+template <typename T, int N, typename Transport>
+inline int distributed_gtensor<T, N, Transport>::neighbor(int rank, int d,
+                                                          int side) const
+{
+  auto c = coords(rank);
+  c[d] += side == 0 ? -1 : 1;
+  if (c[d] < 0 || c[d] >= procs_[d]) {
+    if (!periodic_[d]) {
+      return -1;
+    }
+    c[d] = (c[d] + procs_[d]) % procs_[d];
+  }
+  int nb = 0;
+  for (int e = N - 1; e >= 0; e--) {
+    nb = nb * procs_[e] + c[e];
+  }
+  return nb;
+}
+
+template <typename T, int N, typename Transport>
+inline auto distributed_gtensor<T, N, Transport>::core(int i) const
+  -> view_type
+{
+  const auto& l = local_[i];
+  auto in = l.interior();
+  auto shape = in.shape();
+  size_type offset = 0;
+  for (int d = 0; d < N; d++) {
+    shape[d] = std::max(0, shape[d] - 2 * ghosts_[d]);
+    offset += ghosts_[d] * in.strides()[d];
+  }
+  return view_type(in.data() + offset, shape, in.strides());
+}
+
+template <typename T, int N, typename Transport>
+template <typename F>
+inline void distributed_gtensor<T, N, Transport>::for_each_local(F&& f) const
+{
+  detail::parallel_for_each(n_local(), f);
+}
+
+template <typename T, int N, typename Transport>
+inline void distributed_gtensor<T, N, Transport>::exchange_dim(int d)
+{
+  // the face on side s goes to the neighbour on side s, where it arrives in
+  // the halo on side 1 - s, so it's tagged with the sender's side
+  std::vector<message<T>> sends, recvs;
+  for (int i = 0; i < n_local(); i++) {
+    for (int side = 0; side < 2; side++) {
+      int nb = neighbor(ranks_[i], d, side);
+      if (nb < 0) {
+        continue;
+      }
+      int buf = (i * N + d) * 2 + side;
+      auto size = local_[i].face_size(d);
+      sends.push_back({ranks_[i], nb, 2 * d + side,
+                       send_bufs_[buf].data(), size});
+      recvs.push_back({nb, ranks_[i], 2 * d + 1 - side,
+                       recv_bufs_[buf].data(), size});
+    }
+  }
+
+  detail::parallel_for_each(n_local(), [&](int i) {
+    for (int side = 0; side < 2; side++) {
+      if (neighbor(ranks_[i], d, side) >= 0) {
+        local_[i].pack(d, side, send_bufs_[(i * N + d) * 2 + side].data());
+      }
+    }
+  });
+
+  transport_.exchange(sends, recvs);
+
+  // the recvs are in order of local subdomain and side
+  std::vector<int> first(n_local() + 1, 0);
+  for (int i = 0, m = 0; i < n_local(); i++) {
+    first[i] = m;
+    for (int side = 0; side < 2; side++) {
+      m += neighbor(ranks_[i], d, side) >= 0 ? 1 : 0;
+    }
+    first[i + 1] = m;
+  }
+  detail::parallel_for_each(n_local(), [&](int i) {
+    int m = first[i];
+    for (int side = 0; side < 2; side++) {
+      if (neighbor(ranks_[i], d, side) >= 0) {
+        local_[i].unpack(d, side, recvs[m++].data);
+      }
+    }
+  });
+}
+
+template <typename T, int N, typename Transport>
+inline void distributed_gtensor<T, N, Transport>::exchange_halos()
+{
+  for (int d = 0; d < N; d++) {
+    exchange_dim(d);
+  }
+}
+
+template <typename T, int N, typename Transport>
+inline std::future<void>
+distributed_gtensor<T, N, Transport>::exchange_halos_async()
+{
+  return std::async(std::launch::async, [this]() { exchange_halos(); });
+}
+
+} // namespace gt
+
+#endif
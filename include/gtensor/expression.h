@@ -11,11 +11,11 @@ namespace gt
 {
 
 // fwd decl FIXME?
-template <typename T, int N, typename S>
-struct gtensor;
+template <typename T, int N, typename S, typename X>
+class gtensor;
 
-template <typename T, int N, typename S>
-struct gtensor_view;
+template <typename T, int N, typename S, typename X>
+class gtensor_view;
 
 // ======================================================================
 // expression
@@ -74,6 +74,27 @@ using has_expression = disjunction<is_expression<Args>...>;
 template <typename EC>
 using to_kernel_t = decltype(std::declval<std::decay_t<EC>>().to_kernel());
 
+// ======================================================================
+// owns_operand_storage
+//
+// whether an expression holds an operand with storage of its own by value,
+// e.g., a + f() where f() returns a gtensor. Its kernel view then refers to
+// storage that goes away together with the expression. owned_storage<O> is
+// whether an operand stored as O is, or holds, such storage. The expression
+// types that keep operands specialize owns_operand_storage.
+
+template <typename E>
+struct owns_operand_storage : std::false_type
+{};
+
+template <typename O>
+struct owned_storage : owns_operand_storage<O>
+{};
+
+template <typename T, int N, typename S, typename X>
+struct owned_storage<gtensor<T, N, S, X>> : std::true_type
+{};
+
 // ----------------------------------------------------------------------
 // 1-d, 2-d ostream output
 
@@ -0,0 +1,260 @@
+
+// ======================================================================
+// extents.h
+//
+// extents<E...> : shape type mixing compile-time and runtime extents
+
+#ifndef GTENSOR_EXTENTS_H
+#define GTENSOR_EXTENTS_H
+
+#include "defs.h"
+#include "gtl.h"
+#include "sarray.h"
+
+#include <string>
+#include <utility>
+
+namespace gt
+{
+
+constexpr const int dynamic_extent = -1;
+
+// ======================================================================
+// extents
+//
+// Drop-in replacement for shape_type<N>, where each extent is either fixed at
+// compile time or given as `dynamic_extent` and set at runtime, e.g.,
+// extents<2, dynamic_extent, 3>. Runtime access via operator[] works for all
+// extents, while get<I>() returns a compile-time constant for fixed extents,
+// so index calculations and loops over those dimensions can be folded and
+// unrolled by the compiler.
+
+template <int... E>
+class extents
+{
+public:
+  using value_type = int;
+
+  GT_INLINE extents();
+
+  // construct from exactly N extents, fixed ones need to match
+  template <typename... U,
+            std::enable_if_t<sizeof...(U) == sizeof...(E) &&
+                               conjunction<std::is_convertible<U, int>...>::value,
+                             int> = 0>
+  GT_INLINE extents(U... args);
+  GT_INLINE extents(const sarray<int, sizeof...(E)>& arr);
+
+  template <typename O>
+  bool operator==(const O& o) const;
+  template <typename O>
+  bool operator!=(const O& o) const;
+
+  GT_INLINE constexpr static std::size_t size();
+  GT_INLINE constexpr static int static_extent(std::size_t i);
+  GT_INLINE constexpr static bool is_static(std::size_t i);
+  GT_INLINE constexpr static int static_stride(std::size_t i);
+
+  GT_INLINE int operator[](int i) const;
+  template <size_type I>
+  GT_INLINE constexpr int get() const;
+
+  GT_INLINE const int* begin() const;
+  GT_INLINE const int* end() const;
+
+  GT_INLINE operator sarray<int, sizeof...(E)>() const;
+
+private:
+  GT_INLINE void check() const;
+
+  sarray<int, sizeof...(E)> data_;
+};
+
+// ======================================================================
+// get
+//
+// compile-time indexed access to shape / strides, returns a constant for
+// fixed extents
+
+template <size_type I, typename T, size_type N>
+GT_INLINE const T& get(const sarray<T, N>& arr)
+{
+  return arr[I];
+}
+
+template <size_type I, int... E>
+GT_INLINE constexpr int get(const extents<E...>& ext)
+{
+  return ext.template get<I>();
+}
+
+// ======================================================================
+// strides_t
+//
+// type for the col-major strides corresponding to a given shape type. For
+// extents, the stride of a dimension is fixed if its own and all lower
+// extents are fixed.
+
+namespace detail
+{
+
+template <typename S>
+struct strides_type
+{
+  using type = S;
+};
+
+template <typename X, typename I>
+struct extents_strides;
+
+template <int... E, size_type... I>
+struct extents_strides<extents<E...>, std::index_sequence<I...>>
+{
+  using type = extents<extents<E...>::static_stride(I)...>;
+};
+
+template <int... E>
+struct strides_type<extents<E...>>
+{
+  using type = typename extents_strides<
+    extents<E...>, std::make_index_sequence<sizeof...(E)>>::type;
+};
+
+} // namespace detail
+
+template <typename S>
+using strides_t = typename detail::strides_type<S>::type;
+
+// ======================================================================
+// extents implementation
+
+template <int... E>
+inline extents<E...>::extents()
+  : data_(int(E == dynamic_extent ? 0 : E)...)
+{}
+
+template <int... E>
+template <typename... U,
+          std::enable_if_t<sizeof...(U) == sizeof...(E) &&
+                             conjunction<std::is_convertible<U, int>...>::value,
+                           int>>
+inline extents<E...>::extents(U... args) : data_(int(args)...)
+{
+  check();
+}
+
+template <int... E>
+inline extents<E...>::extents(const sarray<int, sizeof...(E)>& arr)
+  : data_(arr)
+{
+  check();
+}
+
+template <int... E>
+inline void extents<E...>::check() const
+{
+  for (int i = 0; i < int(size()); i++) {
+    assert(!is_static(i) || data_[i] == static_extent(i));
+  }
+}
+
+template <int... E>
+template <typename O>
+inline bool extents<E...>::operator==(const O& o) const
+{
+  return data_ == o;
+}
+
+template <int... E>
+template <typename O>
+inline bool extents<E...>::operator!=(const O& o) const
+{
+  return !(*this == o);
+}
+
+template <int... E>
+inline constexpr std::size_t extents<E...>::size()
+{
+  return sizeof...(E);
+}
+
+template <int... E>
+inline constexpr int extents<E...>::static_extent(std::size_t i)
+{
+  constexpr int ext[] = {E..., 0};
+  return ext[i];
+}
+
+template <int... E>
+inline constexpr bool extents<E...>::is_static(std::size_t i)
+{
+  return static_extent(i) != dynamic_extent;
+}
+
+template <int... E>
+inline constexpr int extents<E...>::static_stride(std::size_t i)
+{
+  // strides of extent 1 dimensions are set to zero to support broadcasting,
+  // so the extent itself needs to be known, too
+  if (!is_static(i)) {
+    return dynamic_extent;
+  }
+  if (static_extent(i) == 1) {
+    return 0;
+  }
+  int stride = 1;
+  for (std::size_t d = 0; d < i; d++) {
+    if (!is_static(d)) {
+      return dynamic_extent;
+    }
+    stride *= static_extent(d);
+  }
+  return stride;
+}
+
+template <int... E>
+inline int extents<E...>::operator[](int i) const
+{
+  return data_[i];
+}
+
+template <int... E>
+template <size_type I>
+inline constexpr int extents<E...>::get() const
+{
+  return is_static(I) ? static_extent(I) : data_[I];
+}
+
+template <int... E>
+inline const int* extents<E...>::begin() const
+{
+  return data_.begin();
+}
+
+template <int... E>
+inline const int* extents<E...>::end() const
+{
+  return data_.end();
+}
+
+template <int... E>
+inline extents<E...>::operator sarray<int, sizeof...(E)>() const
+{
+  return data_;
+}
+
+template <int... E>
+inline std::string to_string(const extents<E...>& ext)
+{
+  return to_string(sarray<int, sizeof...(E)>(ext));
+}
+
+template <int... E>
+inline std::ostream& operator<<(std::ostream& os, const extents<E...>& ext)
+{
+  return os << to_string(ext);
+}
+
+} // namespace gt
+
+#endif
@@ -0,0 +1,102 @@
+
+// ======================================================================
+// fastdiv.h
+//
+// fast_divider : division by a runtime-invariant divisor using a
+// precomputed multiply-shift
+
+#ifndef GTENSOR_FASTDIV_H
+#define GTENSOR_FASTDIV_H
+
+#include "defs.h"
+#include "sarray.h"
+
+#include <cassert>
+#include <cstdint>
+
+namespace gt
+{
+
+// ======================================================================
+// fast_divider
+//
+// Replaces n / d by a multiply-high, an add and a shift, for a divisor d
+// that is known ahead of time and any 32-bit unsigned n (Granlund /
+// Montgomery, as used by libdivide). With l = ceil(log2(d)) and
+// m = floor(2^32 * (2^l - d) / d) + 1, the quotient is
+// (mulhi(m, n) + n) >> l, where the sum is formed in 64 bits so it can't
+// overflow. A divisor of 0 is allowed and gives a quotient of 0, which is
+// what unravel needs for broadcast dimensions.
+
+class fast_divider
+{
+public:
+  fast_divider() = default;
+
+  GT_INLINE explicit fast_divider(std::uint32_t d) : d_(d)
+  {
+    if (d == 0) {
+      return;
+    }
+    while ((std::uint64_t(1) << shift_) < d) {
+      shift_++;
+    }
+    multiplier_ = std::uint32_t(
+      ((std::uint64_t(1) << 32) * ((std::uint64_t(1) << shift_) - d)) / d +
+      1);
+  }
+
+  GT_INLINE std::uint32_t divisor() const { return d_; }
+
+  GT_INLINE std::uint32_t divide(std::uint32_t n) const
+  {
+    if (d_ == 0) {
+      return 0;
+    }
+    std::uint32_t hi = (std::uint64_t(multiplier_) * n) >> 32;
+    return std::uint32_t((std::uint64_t(hi) + n) >> shift_);
+  }
+
+private:
+  std::uint32_t d_ = 0;
+  std::uint32_t multiplier_ = 0;
+  std::uint32_t shift_ = 0;
+};
+
+GT_INLINE std::uint32_t operator/(std::uint32_t n, const fast_divider& div)
+{
+  return div.divide(n);
+}
+
+// ======================================================================
+// unravel
+//
+// given 1-d index and the dividers for the strides as calculated by
+// make_dividers(), calculate multi-d index without integer divisions
+
+template <size_type N, typename S>
+GT_INLINE sarray<fast_divider, N> make_dividers(const S& strides)
+{
+  sarray<fast_divider, N> div;
+  for (int d = 0; d < int(N); d++) {
+    div[d] = fast_divider(std::uint32_t(strides[d]));
+  }
+  return div;
+}
+
+template <typename S, size_type N>
+GT_INLINE S unravel(size_type i, const sarray<fast_divider, N>& div)
+{
+  assert(i <= UINT32_MAX);
+  S idx;
+  std::uint32_t n = i;
+  for (int d = N - 1; d >= 0; d--) {
+    idx[d] = n / div[d];
+    n -= idx[d] * div[d].divisor();
+  }
+  return idx;
+}
+
+} // namespace gt
+
+#endif
@@ -0,0 +1,815 @@
+
+// ======================================================================
+// fft.h
+//
+// fft, ifft, rfft, irfft : discrete Fourier transforms along an axis of an
+// array
+
+#ifndef GTENSOR_FFT_H
+#define GTENSOR_FFT_H
+
+#include "batched.h"
+#include "complex.h"
+#include "defs.h"
+#include "fusion.h"
+#include "gtensor.h"
+
+#ifdef GTENSOR_HAVE_FFTW
+#include <fftw3.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace gt
+{
+
+namespace detail
+{
+
+// lines are transformed in blocks of up to FFT_LANES, side by side, with
+// at most FFT_BLOCK complex values per block, so that a block and its
+// scratch stay in L2
+constexpr const int FFT_LANES = 256;
+constexpr const int FFT_BLOCK = 8192;
+
+constexpr const double FFT_2PI = 6.28318530717958647693;
+
+// the real type of real and complex values
+template <typename V>
+struct fft_real
+{
+  using type = V;
+};
+
+template <typename R>
+struct fft_real<complex<R>>
+{
+  using type = R;
+};
+
+template <typename V>
+using fft_real_t = typename fft_real<std::decay_t<V>>::type;
+
+// ----------------------------------------------------------------------
+// fft_plan
+//
+// A mixed-radix Stockham FFT of length n, with sign -1 (forward) or +1
+// (backward, unnormalized). n is factored into radices 4, 2, 3, and then
+// any other primes, which take O(p^2) each, so lengths with large prime
+// factors are slow.
+//
+// Stage t, with L = p_1 * ... * p_t and r = n / L, takes X[j', k + q r] to
+//
+//   X[j' + s L / p, k] = sum_q w_p^(s q) w_L^(j' q) X[j', k + q r]
+//
+// where X[j, k] is at j * r + k, which leaves the result in natural order.
+// The transform works on `lanes` sequences side by side, and since k and
+// the lane together are contiguous, the innermost loops run over r * lanes
+// values, across sequences.
+
+template <typename T>
+class fft_plan
+{
+public:
+  fft_plan(int n, int sign) : n_(n), sign_(sign)
+  {
+    int m = n, L = 1;
+    while (m > 1) {
+      int p = m % 4 == 0 ? 4 : m % 2 == 0 ? 2 : 3;
+      while (m % p != 0) {
+        p += 2;
+      }
+      stage st{p, L, n / (L * p), twr_.size(), rootr_.size()};
+      L *= p;
+      m /= p;
+      for (int j = 0; j < st.m; j++) {
+        for (int q = 1; q < p; q++) {
+          push(twr_, twi_, double(j) * q / L);
+        }
+      }
+      if (p > 4) {
+        for (int q = 0; q < p; q++) {
+          push(rootr_, rooti_, double(q) / p);
+        }
+      }
+      stages_.push_back(st);
+    }
+  }
+
+  int n() const { return n_; }
+  int n_stages() const { return stages_.size(); }
+
+  // transforms `lanes` sequences, split into real and imaginary parts:
+  // element i of lane l is at buf[i * lanes + l] and
+  // buf[(n + i) * lanes + l]. buf holds 4 * n * lanes values, the second
+  // half being scratch. Returns the buffer that holds the result, either buf
+  // or buf + 2 * n * lanes, in the same layout.
+  T* execute(T* buf, int lanes) const
+  {
+    const std::ptrdiff_t nl = std::ptrdiff_t(n_) * lanes;
+    T* a = buf;
+    T* b = buf + 2 * nl;
+    for (auto& st : stages_) {
+      switch (st.p) {
+        case 2: run<2>(st, a, a + nl, b, b + nl, lanes); break;
+        case 3: run<3>(st, a, a + nl, b, b + nl, lanes); break;
+        case 4: run<4>(st, a, a + nl, b, b + nl, lanes); break;
+        default: run<0>(st, a, a + nl, b, b + nl, lanes); break;
+      }
+      std::swap(a, b);
+    }
+    return a;
+  }
+
+private:
+  struct stage
+  {
+    int p;     // radix
+    int m;     // L / p
+    int r;     // n / L
+    size_type tw;
+    size_type root;
+  };
+
+  // exp(sign 2 pi i f)
+  void push(std::vector<T>& re, std::vector<T>& im, double f) const
+  {
+    const double phi = sign_ * FFT_2PI * f;
+    re.push_back(T(std::cos(phi)));
+    im.push_back(T(std::sin(phi)));
+  }
+
+  template <int P>
+  void run(const stage& st, T* ar, T* ai, T* br, T* bi, int lanes) const
+  {
+    const int p = P != 0 ? P : st.p;
+    const std::ptrdiff_t rc = std::ptrdiff_t(st.r) * lanes;
+    for (int j = 0; j < st.m; j++) {
+      const T* wr = &twr_[st.tw + j * (p - 1)];
+      const T* wi = &twi_[st.tw + j * (p - 1)];
+      T* xr = ar + j * p * rc;
+      T* xi = ai + j * p * rc;
+      T* yr = br + j * rc;
+      T* yi = bi + j * rc;
+      const std::ptrdiff_t ys = st.m * rc;
+      if (j == 0) {
+        butterfly<P, false>(st, xr, xi, yr, yi, ys, wr, wi, rc);
+      } else {
+        butterfly<P, true>(st, xr, xi, yr, yi, ys, wr, wi, rc);
+      }
+    }
+  }
+
+  // inputs x[q * rc + u], twiddled by w[q - 1] unless TW is false, outputs
+  // y[s * ys + u], for u in [0, rc)
+  template <int P, bool TW>
+  std::enable_if_t<P == 2> butterfly(const stage&, const T* xr, const T* xi,
+                                     T* yr, T* yi, std::ptrdiff_t ys,
+                                     const T* wr, const T* wi,
+                                     std::ptrdiff_t rc) const
+  {
+    GT_NOALIAS_LOOP
+    for (std::ptrdiff_t u = 0; u < rc; u++) {
+      T a1r = xr[rc + u], a1i = xi[rc + u];
+      if (TW) {
+        const T t = a1r * wr[0] - a1i * wi[0];
+        a1i = a1r * wi[0] + a1i * wr[0];
+        a1r = t;
+      }
+      yr[u] = xr[u] + a1r;
+      yi[u] = xi[u] + a1i;
+      yr[ys + u] = xr[u] - a1r;
+      yi[ys + u] = xi[u] - a1i;
+    }
+  }
+
+  template <int P, bool TW>
+  std::enable_if_t<P == 3> butterfly(const stage&, const T* xr, const T* xi,
+                                     T* yr, T* yi, std::ptrdiff_t ys,
+                                     const T* wr, const T* wi,
+                                     std::ptrdiff_t rc) const
+  {
+    // sign * sin(2 pi / 3)
+    const T s3 = T(sign_ * 0.86602540378443864676);
+    GT_NOALIAS_LOOP
+    for (std::ptrdiff_t u = 0; u < rc; u++) {
+      T a1r = xr[rc + u], a1i = xi[rc + u];
+      T a2r = xr[2 * rc + u], a2i = xi[2 * rc + u];
+      if (TW) {
+        T t = a1r * wr[0] - a1i * wi[0];
+        a1i = a1r * wi[0] + a1i * wr[0];
+        a1r = t;
+        t = a2r * wr[1] - a2i * wi[1];
+        a2i = a2r * wi[1] + a2i * wr[1];
+        a2r = t;
+      }
+      const T tr = a1r + a2r, ti = a1i + a2i;
+      const T dr = s3 * (a1r - a2r), di = s3 * (a1i - a2i);
+      const T mr = xr[u] - T(.5) * tr, mi = xi[u] - T(.5) * ti;
+      yr[u] = xr[u] + tr;
+      yi[u] = xi[u] + ti;
+      yr[ys + u] = mr - di;
+      yi[ys + u] = mi + dr;
+      yr[2 * ys + u] = mr + di;
+      yi[2 * ys + u] = mi - dr;
+    }
+  }
+
+  template <int P, bool TW>
+  std::enable_if_t<P == 4> butterfly(const stage&, const T* xr, const T* xi,
+                                     T* yr, T* yi, std::ptrdiff_t ys,
+                                     const T* wr, const T* wi,
+                                     std::ptrdiff_t rc) const
+  {
+    const T sg = T(sign_);
+    GT_NOALIAS_LOOP
+    for (std::ptrdiff_t u = 0; u < rc; u++) {
+      T a1r = xr[rc + u], a1i = xi[rc + u];
+      T a2r = xr[2 * rc + u], a2i = xi[2 * rc + u];
+      T a3r = xr[3 * rc + u], a3i = xi[3 * rc + u];
+      if (TW) {
+        T t = a1r * wr[0] - a1i * wi[0];
+        a1i = a1r * wi[0] + a1i * wr[0];
+        a1r = t;
+        t = a2r * wr[1] - a2i * wi[1];
+        a2i = a2r * wi[1] + a2i * wr[1];
+        a2r = t;
+        t = a3r * wr[2] - a3i * wi[2];
+        a3i = a3r * wi[2] + a3i * wr[2];
+        a3r = t;
+      }
+      const T t0r = xr[u] + a2r, t0i = xi[u] + a2i;
+      const T t1r = xr[u] - a2r, t1i = xi[u] - a2i;
+      const T t2r = a1r + a3r, t2i = a1i + a3i;
+      // (a1 - a3) * w_4, w_4 = sign * i
+      const T t3r = -sg * (a1i - a3i), t3i = sg * (a1r - a3r);
+      yr[u] = t0r + t2r;
+      yi[u] = t0i + t2i;
+      yr[ys + u] = t1r + t3r;
+      yi[ys + u] = t1i + t3i;
+      yr[2 * ys + u] = t0r - t2r;
+      yi[2 * ys + u] = t0i - t2i;
+      yr[3 * ys + u] = t1r - t3r;
+      yi[3 * ys + u] = t1i - t3i;
+    }
+  }
+
+  // any other radix, as a plain DFT, twiddling the inputs in place
+  template <int P, bool TW>
+  std::enable_if_t<P == 0> butterfly(const stage& st, T* xr, T* xi, T* yr,
+                                     T* yi, std::ptrdiff_t ys, const T* wr,
+                                     const T* wi, std::ptrdiff_t rc) const
+  {
+    const int p = st.p;
+    if (TW) {
+      for (int q = 1; q < p; q++) {
+        T* xqr = xr + q * rc;
+        T* xqi = xi + q * rc;
+        GT_NOALIAS_LOOP
+        for (std::ptrdiff_t u = 0; u < rc; u++) {
+          const T t = xqr[u] * wr[q - 1] - xqi[u] * wi[q - 1];
+          xqi[u] = xqr[u] * wi[q - 1] + xqi[u] * wr[q - 1];
+          xqr[u] = t;
+        }
+      }
+    }
+    const T* rr = &rootr_[st.root];
+    const T* ri = &rooti_[st.root];
+    for (int s = 0; s < p; s++) {
+      T* ysr = yr + s * ys;
+      T* ysi = yi + s * ys;
+      std::copy(xr, xr + rc, ysr);
+      std::copy(xi, xi + rc, ysi);
+      for (int q = 1; q < p; q++) {
+        const T cr = rr[s * q % p], ci = ri[s * q % p];
+        const T* xqr = xr + q * rc;
+        const T* xqi = xi + q * rc;
+        GT_NOALIAS_LOOP
+        for (std::ptrdiff_t u = 0; u < rc; u++) {
+          ysr[u] += xqr[u] * cr - xqi[u] * ci;
+          ysi[u] += xqr[u] * ci + xqi[u] * cr;
+        }
+      }
+    }
+  }
+
+  int n_;
+  int sign_;
+  std::vector<stage> stages_;
+  std::vector<T> twr_, twi_;
+  std::vector<T> rootr_, rooti_;
+};
+
+// ----------------------------------------------------------------------
+// fft_for_each_block
+//
+// Runs f(io, oo, count, buf) for blocks of the lines along `axis` of an
+// array of shape `shape`, spread across threads, where io[l] and oo[l] are
+// the offsets of line l of the block in the input and output, given their
+// strides, and buf is scratch for an fft_plan of length n_plan.
+
+template <typename T, size_type N, typename F>
+inline void fft_for_each_block(const shape_type<N>& shape, int axis,
+                               const shape_type<N>& is,
+                               const shape_type<N>& os, int n_plan, F&& f)
+{
+  size_type n_lines = 1;
+  for (int d = 0; d < int(N); d++) {
+    if (d != axis) {
+      n_lines *= shape[d];
+    }
+  }
+  const int lanes =
+    std::max(1, std::min(FFT_LANES, FFT_BLOCK / std::max(1, n_plan)));
+  const int n_blocks = (n_lines + lanes - 1) / lanes;
+  const size_type work = size_type(lanes) * n_plan * 16;
+  batched_parallel(n_blocks, work, 1, [&](int k0, int k1) {
+    std::vector<T> buf(4 * size_type(n_plan) * lanes);
+    std::vector<std::ptrdiff_t> io(lanes), oo(lanes);
+    for (int k = k0; k < k1; k++) {
+      const size_type g0 = size_type(k) * lanes;
+      const int count = std::min(size_type(lanes), n_lines - g0);
+      // index of the first line, then counting up
+      shape_type<N> idx;
+      size_type rem = g0;
+      for (int d = 0; d < int(N); d++) {
+        idx[d] = 0;
+        if (d != axis) {
+          idx[d] = rem % shape[d];
+          rem /= shape[d];
+        }
+      }
+      for (int l = 0; l < count; l++) {
+        io[l] = 0;
+        oo[l] = 0;
+        for (int d = 0; d < int(N); d++) {
+          io[l] += std::ptrdiff_t(idx[d]) * is[d];
+          oo[l] += std::ptrdiff_t(idx[d]) * os[d];
+        }
+        for (int d = 0; d < int(N); d++) {
+          if (d != axis && ++idx[d] < shape[d]) {
+            break;
+          }
+          if (d != axis) {
+            idx[d] = 0;
+          }
+        }
+      }
+      f(io.data(), oo.data(), count, buf.data());
+    }
+  });
+}
+
+// ----------------------------------------------------------------------
+// fft_source
+//
+// The input of a transform, read directly if it is stored in memory as V,
+// like gtensors and their (strided) views, otherwise evaluated first
+
+template <int N, typename V>
+struct fft_source
+{
+  const V* data;
+  shape_type<N> strides;
+};
+
+template <typename V, int N, typename E>
+inline fft_source<N, V> make_fft_source(const E& e, gtensor<V, N>& tmp,
+                                        int axis, const char* name)
+{
+  static_assert(std::is_same<expr_space_type<E>, space::host>::value,
+                "fft: only implemented on the host");
+  if (axis < 0 || axis >= int(N)) {
+    throw std::runtime_error(std::string(name) + ": axis " +
+                             std::to_string(axis) + " out of range");
+  }
+  // reads the data of e directly
+  deferred_assign<space::host>::flush();
+  fft_source<N, V> src;
+  src.data = stored_data(e, tmp, src.strides);
+  return src;
+}
+
+// ----------------------------------------------------------------------
+// fft_fftw
+//
+// Hands off to FFTW, if it was found at configure time, for float and
+// double. Returns false if it didn't. `shape` is that of the logical
+// (complex, or real) data, is and os the strides of input and output, in
+// their own elements. c2r transforms overwrite their input.
+
+enum class fft_kind
+{
+  c2c,
+  r2c,
+  c2r
+};
+
+template <typename T>
+struct fftw_dispatch
+{
+  static constexpr bool available = false;
+
+  template <size_type N>
+  static bool run(fft_kind, int, const shape_type<N>&, int, void*,
+                  const shape_type<N>&, void*, const shape_type<N>&)
+  {
+    return false;
+  }
+};
+
+#ifdef GTENSOR_HAVE_FFTW
+
+template <typename API>
+struct fftw_dispatch_impl
+{
+  static constexpr bool available = true;
+  using iodim = typename API::iodim;
+
+  template <size_type N>
+  static bool run(fft_kind kind, int sign, const shape_type<N>& shape,
+                  int axis, void* in, const shape_type<N>& is, void* out,
+                  const shape_type<N>& os)
+  {
+    iodim dim{shape[axis], is[axis], os[axis]};
+    std::vector<iodim> howmany;
+    for (int d = 0; d < int(N); d++) {
+      if (d != axis) {
+        howmany.push_back({shape[d], is[d], os[d]});
+      }
+    }
+    auto plan = API::plan(kind, sign, dim, howmany, in, out);
+    if (!plan) {
+      return false;
+    }
+    API::execute(plan);
+    API::destroy(plan);
+    return true;
+  }
+};
+
+#define GTENSOR_FFTW_API(NAME, REAL, PREFIX)                                   \
+  struct NAME                                                                  \
+  {                                                                            \
+    using iodim = PREFIX##_iodim;                                              \
+    using plan_type = PREFIX##_plan;                                           \
+    using cplx = PREFIX##_complex;                                             \
+                                                                               \
+    static plan_type plan(fft_kind kind, int sign, const iodim& dim,           \
+                          const std::vector<iodim>& howmany, void* in,         \
+                          void* out)                                           \
+    {                                                                          \
+      const int hr = howmany.size();                                           \
+      switch (kind) {                                                          \
+        case fft_kind::c2c:                                                    \
+          return PREFIX##_plan_guru_dft(1, &dim, hr, howmany.data(),           \
+                                        static_cast<cplx*>(in),                \
+                                        static_cast<cplx*>(out), sign,         \
+                                        FFTW_ESTIMATE);                        \
+        case fft_kind::r2c:                                                    \
+          return PREFIX##_plan_guru_dft_r2c(1, &dim, hr, howmany.data(),       \
+                                            static_cast<REAL*>(in),            \
+                                            static_cast<cplx*>(out),           \
+                                            FFTW_ESTIMATE);                    \
+        default:                                                               \
+          return PREFIX##_plan_guru_dft_c2r(1, &dim, hr, howmany.data(),       \
+                                            static_cast<cplx*>(in),            \
+                                            static_cast<REAL*>(out),           \
+                                            FFTW_ESTIMATE);                    \
+      }                                                                        \
+    }                                                                          \
+    static void execute(plan_type p) { PREFIX##_execute(p); }                  \
+    static void destroy(plan_type p) { PREFIX##_destroy_plan(p); }             \
+  }
+
+GTENSOR_FFTW_API(fftw_api_double, double, fftw);
+GTENSOR_FFTW_API(fftw_api_float, float, fftwf);
+
+#undef GTENSOR_FFTW_API
+
+template <>
+struct fftw_dispatch<double> : fftw_dispatch_impl<fftw_api_double>
+{};
+
+template <>
+struct fftw_dispatch<float> : fftw_dispatch_impl<fftw_api_float>
+{};
+
+#endif
+
+// ----------------------------------------------------------------------
+// fft_c2c
+//
+// out = DFT of src along axis, times scale, with out contiguous
+
+template <typename T, int N>
+inline void fft_c2c(const fft_source<N, complex<T>>& src,
+                    gtensor<complex<T>, N>& out, int axis, int sign, T scale)
+{
+  const auto shape = out.shape();
+  const int n = shape[axis];
+  if (out.size() == 0) {
+    return;
+  }
+  if (fftw_dispatch<T>::run(fft_kind::c2c, sign, shape, axis,
+                            const_cast<complex<T>*>(src.data), src.strides,
+                            out.data(), out.strides())) {
+    if (scale != T(1)) {
+      for (size_type i = 0; i < out.size(); i++) {
+        out.data()[i] *= scale;
+      }
+    }
+    return;
+  }
+  const fft_plan<T> plan(n, sign);
+  const std::ptrdiff_t is = src.strides[axis], os = out.strides()[axis];
+  const complex<T>* x = src.data;
+  complex<T>* y = out.data();
+  fft_for_each_block<T>(
+    shape, axis, src.strides, out.strides(), n,
+    [&](const std::ptrdiff_t* io, const std::ptrdiff_t* oo, int count,
+        T* buf) {
+      const std::ptrdiff_t nc = std::ptrdiff_t(n) * count;
+      for (int i = 0; i < n; i++) {
+        for (int l = 0; l < count; l++) {
+          const complex<T> v = x[io[l] + i * is];
+          buf[i * count + l] = v.real();
+          buf[nc + i * count + l] = v.imag();
+        }
+      }
+      const T* z = plan.execute(buf, count);
+      for (int i = 0; i < n; i++) {
+        for (int l = 0; l < count; l++) {
+          y[oo[l] + i * os] = complex<T>(scale * z[i * count + l],
+                                         scale * z[nc + i * count + l]);
+        }
+      }
+    });
+}
+
+// ----------------------------------------------------------------------
+// fft_r2c
+//
+// out = the first n / 2 + 1 terms of the DFT of real src along axis. For
+// even n, the n real values are transformed as n / 2 complex ones,
+// z[m] = x[2m] + i x[2m+1], Z = DFT(z), and then
+//
+//   X[k] = (Z[k] + Z*[M-k]) / 2 - i w_n^k (Z[k] - Z*[M-k]) / 2,  M = n / 2
+
+template <typename T, int N>
+inline void fft_r2c(const fft_source<N, T>& src, int n,
+                    gtensor<complex<T>, N>& out, int axis)
+{
+  auto shape = out.shape();
+  shape[axis] = n;
+  if (out.size() == 0 || n == 0) {
+    return;
+  }
+  if (fftw_dispatch<T>::run(fft_kind::r2c, -1, shape, axis,
+                            const_cast<T*>(src.data), src.strides, out.data(),
+                            out.strides())) {
+    return;
+  }
+  const bool half = n % 2 == 0;
+  const int np = half ? n / 2 : n, M = n / 2;
+  const fft_plan<T> plan(np, -1);
+  std::vector<T> wr(M + 1), wi(M + 1);
+  for (int k = 0; k <= M; k++) {
+    wr[k] = T(std::cos(FFT_2PI * k / n));
+    wi[k] = T(-std::sin(FFT_2PI * k / n));
+  }
+  const std::ptrdiff_t is = src.strides[axis], os = out.strides()[axis];
+  const T* x = src.data;
+  complex<T>* y = out.data();
+  fft_for_each_block<T>(
+    shape, axis, src.strides, out.strides(), np,
+    [&](const std::ptrdiff_t* io, const std::ptrdiff_t* oo, int count,
+        T* buf) {
+      const std::ptrdiff_t nc = std::ptrdiff_t(np) * count;
+      T* br = buf;
+      T* bi = buf + nc;
+      for (int i = 0; i < np; i++) {
+        for (int l = 0; l < count; l++) {
+          if (half) {
+            br[i * count + l] = x[io[l] + 2 * i * is];
+            bi[i * count + l] = x[io[l] + (2 * i + 1) * is];
+          } else {
+            br[i * count + l] = x[io[l] + i * is];
+            bi[i * count + l] = T(0);
+          }
+        }
+      }
+      const T* zr = plan.execute(buf, count);
+      const T* zi = zr + nc;
+      if (!half) {
+        for (int k = 0; k <= M; k++) {
+          for (int l = 0; l < count; l++) {
+            y[oo[l] + k * os] =
+              complex<T>(zr[k * count + l], zi[k * count + l]);
+          }
+        }
+        return;
+      }
+      for (int k = 0; k <= M; k++) {
+        const T* ar = zr + (k % M) * count;
+        const T* ai = zi + (k % M) * count;
+        const T* cr = zr + ((M - k) % M) * count;
+        const T* ci = zi + ((M - k) % M) * count;
+        for (int l = 0; l < count; l++) {
+          // even and odd parts, Fe = (Z[k] + Z*[M-k]) / 2, and
+          // Fo = -i (Z[k] - Z*[M-k]) / 2
+          const T er = T(.5) * (ar[l] + cr[l]), ei = T(.5) * (ai[l] - ci[l]);
+          const T or_ = T(.5) * (ai[l] + ci[l]), oi = -T(.5) * (ar[l] - cr[l]);
+          y[oo[l] + k * os] = complex<T>(er + wr[k] * or_ - wi[k] * oi,
+                                         ei + wr[k] * oi + wi[k] * or_);
+        }
+      }
+    });
+}
+
+// ----------------------------------------------------------------------
+// fft_c2r
+//
+// out = the real inverse DFT (times scale) of the Hermitian spectrum whose
+// first n / 2 + 1 terms are src, inverting fft_r2c. The imaginary parts of
+// the terms that need to be real are ignored.
+
+template <typename T, int N>
+inline void fft_c2r(const fft_source<N, complex<T>>& src,
+                    gtensor<T, N>& out, int axis, T scale)
+{
+  const auto shape = out.shape();
+  const int n = shape[axis];
+  if (out.size() == 0) {
+    return;
+  }
+  const bool half = n % 2 == 0;
+  const int np = half ? n / 2 : n, M = n / 2;
+  const fft_plan<T> plan(np, 1);
+  // the half-length transform is normalized by 1 / (n / 2)
+  const T zscale = half ? 2 * scale : scale;
+  std::vector<T> wr(M + 1), wi(M + 1);
+  for (int k = 0; k <= M; k++) {
+    wr[k] = T(std::cos(FFT_2PI * k / n));
+    wi[k] = T(std::sin(FFT_2PI * k / n));
+  }
+  const std::ptrdiff_t is = src.strides[axis], os = out.strides()[axis];
+  const complex<T>* x = src.data;
+  T* y = out.data();
+  fft_for_each_block<T>(
+    shape, axis, src.strides, out.strides(), np,
+    [&](const std::ptrdiff_t* io, const std::ptrdiff_t* oo, int count,
+        T* buf) {
+      const std::ptrdiff_t nc = std::ptrdiff_t(np) * count;
+      T* br = buf;
+      T* bi = buf + nc;
+      for (int k = 0; k < np; k++) {
+        for (int l = 0; l < count; l++) {
+          if (half) {
+            // Z[k] = Fe + i Fo, with Fe = (X[k] + X*[M-k]) / 2 and
+            // Fo = w_n^-k (X[k] - X*[M-k]) / 2
+            const complex<T> a = x[io[l] + k * is];
+            const complex<T> c = x[io[l] + (M - k) * is];
+            const T er = T(.5) * (a.real() + c.real());
+            const T ei = T(.5) * (a.imag() - c.imag());
+            const T dr = T(.5) * (a.real() - c.real());
+            const T di = T(.5) * (a.imag() + c.imag());
+            const T or_ = wr[k] * dr - wi[k] * di;
+            const T oi = wr[k] * di + wi[k] * dr;
+            br[k * count + l] = er - oi;
+            bi[k * count + l] = ei + or_;
+          } else {
+            const complex<T> v = k <= M ? x[io[l] + k * is]
+                                        : std::conj(x[io[l] + (n - k) * is]);
+            br[k * count + l] = v.real();
+            bi[k * count + l] = k == 0 ? T(0) : v.imag();
+          }
+        }
+      }
+      const T* zr = plan.execute(buf, count);
+      const T* zi = zr + nc;
+      for (int i = 0; i < np; i++) {
+        for (int l = 0; l < count; l++) {
+          if (half) {
+            y[oo[l] + 2 * i * os] = zscale * zr[i * count + l];
+            y[oo[l] + (2 * i + 1) * os] = zscale * zi[i * count + l];
+          } else {
+            y[oo[l] + i * os] = zscale * zr[i * count + l];
+          }
+        }
+      }
+    });
+}
+
+} // namespace detail
+
+// ======================================================================
+// fft, ifft
+//
+// The discrete Fourier transform of e along `axis`,
+//
+//   fft:  X[k] = sum_j x[j] exp(-2 pi i j k / n)
+//   ifft: x[j] = 1 / n sum_k X[k] exp(2 pi i j k / n)
+//
+// as a new complex gtensor of the same shape. e may be real or complex, and
+// any expression; gtensors and their views, strided or not, are read
+// directly, anything else is evaluated first.
+//
+// The lines along the axis are transformed in blocks, side by side, with
+// the innermost loops running across lines so that they vectorize, and
+// blocks are spread across threads. Lengths are factored into radices 2, 3
+// and 4 and other primes; lengths with large prime factors are slow. If
+// FFTW was found at configure time (GTENSOR_HAVE_FFTW), float and double
+// transforms are handed off to it.
+
+template <typename E>
+auto fft(const E& e, int axis = 0)
+{
+  using T = detail::fft_real_t<expr_value_type<E>>;
+  constexpr size_type N = expr_dimension<E>();
+  gtensor<complex<T>, N> tmp;
+  auto src = detail::make_fft_source(e, tmp, axis, "fft");
+  gtensor<complex<T>, N> out(e.shape());
+  detail::fft_c2c(src, out, axis, -1, T(1));
+  return out;
+}
+
+template <typename E>
+auto ifft(const E& e, int axis = 0)
+{
+  using T = detail::fft_real_t<expr_value_type<E>>;
+  constexpr size_type N = expr_dimension<E>();
+  gtensor<complex<T>, N> tmp;
+  auto src = detail::make_fft_source(e, tmp, axis, "ifft");
+  gtensor<complex<T>, N> out(e.shape());
+  detail::fft_c2c(src, out, axis, 1, T(1) / std::max(1, out.shape(axis)));
+  return out;
+}
+
+// ======================================================================
+// rfft, irfft
+//
+// rfft is the fft of real e along `axis`, keeping only the n / 2 + 1
+// non-redundant terms, X[n - k] being X*[k]. Even lengths are transformed
+// as complex ones of half the length.
+//
+// irfft(e, n, axis) inverts it: e holds n / 2 + 1 terms along the axis, and
+// the result is real, with length n there.
+
+template <typename E>
+auto rfft(const E& e, int axis = 0)
+{
+  using T = std::decay_t<expr_value_type<E>>;
+  constexpr size_type N = expr_dimension<E>();
+  static_assert(std::is_floating_point<T>::value, "rfft: needs real input");
+  gtensor<T, N> tmp;
+  auto src = detail::make_fft_source(e, tmp, axis, "rfft");
+  auto shape = e.shape();
+  const int n = shape[axis];
+  shape[axis] = n / 2 + 1;
+  gtensor<complex<T>, N> out(shape);
+  detail::fft_r2c(src, n, out, axis);
+  return out;
+}
+
+template <typename E>
+auto irfft(const E& e, int n, int axis = 0)
+{
+  using T = detail::fft_real_t<expr_value_type<E>>;
+  constexpr size_type N = expr_dimension<E>();
+  gtensor<complex<T>, N> tmp;
+  auto src = detail::make_fft_source(e, tmp, axis, "irfft");
+  if (n < 0 || e.shape(axis) != n / 2 + 1) {
+    throw std::runtime_error("irfft: " + std::to_string(e.shape(axis)) +
+                             " terms along axis for length " +
+                             std::to_string(n));
+  }
+  auto shape = e.shape();
+  shape[axis] = n;
+  gtensor<T, N> out(shape);
+  const T scale = T(1) / std::max(1, n);
+  if (detail::fftw_dispatch<T>::available && out.size() > 0) {
+    // FFTW overwrites the input of c2r transforms
+    gtensor<complex<T>, N> in = e;
+    if (detail::fftw_dispatch<T>::run(detail::fft_kind::c2r, 1, shape, axis,
+                                      in.data(), in.strides(), out.data(),
+                                      out.strides())) {
+      for (size_type i = 0; i < out.size(); i++) {
+        out.data()[i] *= scale;
+      }
+      return out;
+    }
+  }
+  detail::fft_c2r(src, out, axis, scale);
+  return out;
+}
+
+} // namespace gt
+
+#endif
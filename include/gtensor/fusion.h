@@ -0,0 +1,477 @@
+
+// ======================================================================
+// fusion.h
+//
+// fusion_scope : deferred, fused execution of a sequence of assignments
+
+#ifndef GTENSOR_FUSION_H
+#define GTENSOR_FUSION_H
+
+#include "alias.h"
+#include "assign.h"
+#include "defs.h"
+#include "gtensor_view.h"
+#include "stepper.h"
+
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace gt
+{
+
+namespace detail
+{
+
+// number of elements the statements of a fused group are run over in turn,
+// chosen so that what one statement writes is still in cache when the next
+// one reads it
+constexpr const int FUSION_BLOCK_SIZE = 8192;
+
+// ======================================================================
+// fusion_statement_base
+//
+// a deferred lhs = op(lhs, rhs), with its types erased
+
+class fusion_statement_base
+{
+public:
+  virtual ~fusion_statement_base() = default;
+
+  virtual size_type dimension() const = 0;
+
+  // whether it can be run slice by slice, interleaved with other statements
+  virtual bool fusable() const = 0;
+  // whether running it interleaved with `prev`, which comes before it, gives
+  // the same result as running it after `prev` has completed
+  virtual bool fuses_with(const fusion_statement_base& prev) const = 0;
+  // whether it reads or writes memory in [lo, hi)
+  virtual bool touches(const char* lo, const char* hi) const = 0;
+
+  // number of slices (along the last dimension), and elements per slice
+  virtual int slices() const = 0;
+  virtual size_type slice_size() const = 0;
+
+  // runs the whole statement by itself
+  virtual void run() = 0;
+
+  // runs the statement over consecutive slices
+  virtual void start() = 0;
+  virtual void run_slices(int count) = 0;
+  virtual void finish() = 0;
+};
+
+// ======================================================================
+// fusion_statement_layout
+//
+// the memory accessed by a statement of dimension N, for deciding whether
+// it can be fused with others
+
+template <size_type N>
+class fusion_statement_layout : public fusion_statement_base
+{
+public:
+  size_type dimension() const override { return N; }
+
+  bool fusable() const override { return fusable_; }
+
+  bool fuses_with(const fusion_statement_base& prev) const override
+  {
+    if (!fusable_ || !prev.fusable() || prev.dimension() != N) {
+      return false;
+    }
+    auto& p = static_cast<const fusion_statement_layout<N>&>(prev);
+    if (p.shape_ != shape_ || !alias_same_index(p.lhs_, lhs_, shape_)) {
+      return false;
+    }
+    for (auto& r : reads_) {
+      if (!alias_same_index(p.lhs_, r, shape_)) {
+        return false;
+      }
+    }
+    for (auto& r : p.reads_) {
+      if (!alias_same_index(lhs_, r, shape_)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool touches(const char* lo, const char* hi) const override
+  {
+    auto overlaps = [&](const alias_layout<N>& l) {
+      return l.lo < hi && lo < l.hi;
+    };
+    return overlaps(lhs_) ||
+           std::any_of(reads_.begin(), reads_.end(), overlaps);
+  }
+
+  int slices() const override { return shape_[N - 1]; }
+
+  size_type slice_size() const override
+  {
+    size_type size = 1;
+    for (int d = 0; d < int(N) - 1; d++) {
+      size *= shape_[d];
+    }
+    return size;
+  }
+
+protected:
+  template <typename E1, typename E2>
+  void analyze(const E1& lhs, const E2& rhs)
+  {
+    shape_ = lhs.shape();
+    int n_lhs = 0;
+    auto collect_lhs = [&](const alias_layout<N>& l) {
+      lhs_ = l;
+      n_lhs++;
+    };
+    visit_alias_leaves<N>(lhs, true, collect_lhs, alias_tag2{});
+    auto collect_rhs = [&](const alias_layout<N>& l) { reads_.push_back(l); };
+    visit_alias_leaves<N>(rhs, true, collect_rhs, alias_tag2{});
+
+    fusable_ = n_lhs == 1 && lhs_.exact && lhs_.lo != lhs_.hi &&
+               alias_check(lhs, rhs) == alias_order::any;
+  }
+
+  gt::shape_type<N> shape_;
+  alias_layout<N> lhs_;
+  std::vector<alias_layout<N>> reads_;
+  bool fusable_ = false;
+};
+
+// ======================================================================
+// fusion_statement
+
+template <typename L, typename R, typename F>
+class fusion_statement : public fusion_statement_layout<expr_dimension<L>()>
+{
+public:
+  constexpr static size_type N = expr_dimension<L>();
+
+  fusion_statement(L&& lhs, R&& rhs, F op)
+    : lhs_(std::move(lhs)), rhs_(std::move(rhs)), op_(op)
+  {
+    this->analyze(lhs_, rhs_);
+  }
+
+  void run() override { compound_assign_now(lhs_, rhs_, op_); }
+
+  void start() override
+  {
+    cursor_.reset(new cursor(lhs_, rhs_, this->shape_));
+  }
+
+  void run_slices(int count) override
+  {
+    const auto& shape = this->shape_;
+    auto& op = op_;
+    auto f = [&op](auto& lhs, auto& rhs) { *lhs = op(*lhs, *rhs); };
+    for (int k = 0; k < count; k++) {
+      stepper_loop<N - 1>::run(shape, f, cursor_->lhs, cursor_->rhs);
+      cursor_->lhs.template step<N - 1>();
+      cursor_->rhs.template step<N - 1>();
+    }
+  }
+
+  void finish() override { cursor_.reset(); }
+
+private:
+  using shape_type = gt::shape_type<N>;
+  using lhs_stepper_type =
+    decltype(make_stepper(std::declval<L&>(), std::declval<shape_type>()));
+  using rhs_stepper_type = decltype(
+    make_stepper(std::declval<const R&>(), std::declval<shape_type>()));
+
+  struct cursor
+  {
+    cursor(L& lhs_, const R& rhs_, const shape_type& shape)
+      : lhs(make_stepper(lhs_, shape)), rhs(make_stepper(rhs_, shape))
+    {}
+
+    lhs_stepper_type lhs;
+    rhs_stepper_type rhs;
+  };
+
+  L lhs_;
+  R rhs_;
+  F op_;
+  std::unique_ptr<cursor> cursor_;
+};
+
+template <typename L, typename R, typename F>
+inline std::unique_ptr<fusion_statement_base> make_fusion_statement(L&& lhs,
+                                                                    R&& rhs,
+                                                                    F op)
+{
+  return std::unique_ptr<fusion_statement_base>(
+    new fusion_statement<std::decay_t<L>, std::decay_t<R>, F>(
+      std::forward<L>(lhs), std::forward<R>(rhs), op));
+}
+
+} // namespace detail
+
+class fusion_scope;
+
+namespace detail
+{
+
+inline fusion_scope*& active_fusion_scope()
+{
+  static thread_local fusion_scope* scope = nullptr;
+  return scope;
+}
+
+} // namespace detail
+
+// ======================================================================
+// fusion_suspend
+//
+// While a fusion_suspend is alive, assignments run right away, even inside
+// a fusion_scope. For code that needs to see the results of its
+// assignments immediately.
+
+class fusion_suspend
+{
+public:
+  fusion_suspend() : saved_(detail::active_fusion_scope())
+  {
+    detail::active_fusion_scope() = nullptr;
+  }
+
+  fusion_suspend(const fusion_suspend&) = delete;
+  fusion_suspend& operator=(const fusion_suspend&) = delete;
+
+  ~fusion_suspend() { detail::active_fusion_scope() = saved_; }
+
+private:
+  fusion_scope* saved_;
+};
+
+// ======================================================================
+// fusion_scope
+//
+// While a fusion_scope is alive, host assignments (operator=, operator+=,
+// etc.) are recorded rather than executed. They are executed in order when
+// the scope is flushed, at the latest when it goes out of scope:
+//
+//   {
+//     gt::fusion_scope fs;
+//     auto tmp = fs.temporary<double>(a.shape());
+//     tmp = a * b;
+//     c = tmp + d;
+//     e = 2. * tmp - c;
+//   } // c and e computed in a single traversal, tmp is never stored
+//
+// Consecutive statements with the same shape, that each read and write
+// every array either at the same index or not at all, are fused: rather
+// than each making a full pass over memory, all of them are run over a
+// block of slices (along the last dimension) before moving on to the next
+// block, so that what one writes is still in cache when the next reads it.
+//
+// Arrays created by temporary() only hold a single slice, so an intermediate
+// that is only used within fused statements never goes out to memory. They
+// must not be used across statements that cannot be fused, or across
+// flushes, which is diagnosed when recording the statement. Any other array
+// is written in full, even if nothing reads it after the scope, since that
+// can't be known here: dead intermediates are only skipped if they are
+// declared by temporary().
+//
+// Statements refer to the arrays involved by kernel view, so those need to
+// stay alive, and keep their storage, until the scope is flushed. Statements
+// whose expressions hold arrays by value, as in c = a + f() with f()
+// returning a gtensor, run right away instead. Arrays
+// written inside the scope must only be read by other statements until then.
+// Creating a gtensor from an expression, or assign_all(), flushes the scope
+// first, and runs right away. Library code that goes on to access the result
+// of an evaluation as memory evaluates it that way, or under fusion_suspend.
+
+class fusion_scope
+{
+public:
+  fusion_scope() : outer_(current()), uncaught_(n_uncaught_exceptions())
+  {
+    current() = this;
+  }
+
+  fusion_scope(const fusion_scope&) = delete;
+  fusion_scope& operator=(const fusion_scope&) = delete;
+
+  // Errors from running the remaining statements can't be reported from
+  // here, so they are dropped; call flush() first to see them.
+  ~fusion_scope()
+  {
+    current() = outer_;
+    // when unwinding from an exception, the recorded statements may refer to
+    // arrays that are gone already
+    if (n_uncaught_exceptions() == uncaught_) {
+      try {
+        flush();
+      } catch (...) {
+      }
+    }
+  }
+
+  // an array of the given shape that only holds a single slice at a time,
+  // for intermediate results within fused statements. Its storage is owned
+  // by the scope.
+  template <typename T, size_type N>
+  gtensor_view<T, N> temporary(const gt::shape_type<N>& shape)
+  {
+    auto strides = calc_strides(shape);
+    strides[N - 1] = 0;
+    size_type size = 1;
+    for (int d = 0; d < int(N) - 1; d++) {
+      size *= shape[d];
+    }
+    std::shared_ptr<T> storage(new T[size](), std::default_delete<T[]>());
+    auto lo = reinterpret_cast<const char*>(storage.get());
+    temporaries_.push_back({storage, lo, lo + size * sizeof(T), -1});
+    return gtensor_view<T, N>(storage.get(), shape, strides);
+  }
+
+  // executes the statements recorded so far
+  void flush()
+  {
+    // what's executed now must not be recorded again
+    fusion_suspend suspend;
+    auto groups = std::move(groups_);
+    groups_.clear();
+    for (auto& group : groups) {
+      run(group);
+    }
+  }
+
+  // the innermost fusion_scope of this thread, if any
+  static fusion_scope*& current() { return detail::active_fusion_scope(); }
+
+  void record(std::unique_ptr<detail::fusion_statement_base> stmt)
+  {
+    if (groups_.empty() || !fuses_with(*stmt, groups_.back())) {
+      groups_.push_back({n_groups_++, false, {}});
+    }
+    auto& group = groups_.back();
+    for (auto& t : temporaries_) {
+      if (!stmt->touches(t.lo, t.hi)) {
+        continue;
+      }
+      if (!stmt->fusable() || (t.group >= 0 && t.group != group.id)) {
+        if (group.stmts.empty()) {
+          groups_.pop_back();
+        }
+        throw std::runtime_error("fusion_scope: temporary used across "
+                                 "statements that cannot be fused");
+      }
+      t.group = group.id;
+      group.has_temporaries = true;
+    }
+    group.stmts.push_back(std::move(stmt));
+  }
+
+private:
+  struct group
+  {
+    int id;
+    bool has_temporaries;
+    std::vector<std::unique_ptr<detail::fusion_statement_base>> stmts;
+  };
+
+  struct temporary_storage
+  {
+    std::shared_ptr<void> storage;
+    const char* lo;
+    const char* hi;
+    int group;
+  };
+
+  static bool fuses_with(const detail::fusion_statement_base& stmt,
+                         const group& g)
+  {
+    return std::all_of(g.stmts.begin(), g.stmts.end(),
+                       [&](auto& prev) { return stmt.fuses_with(*prev); });
+  }
+
+  static void run(group& g)
+  {
+    if (g.stmts.size() == 1) {
+      g.stmts[0]->run();
+      return;
+    }
+
+    // a temporary only holds one slice, so needs to be consumed slice by slice
+    auto& first = *g.stmts[0];
+    int n = first.slices();
+    int block = 1;
+    if (!g.has_temporaries) {
+      size_type slice_size = std::max<size_type>(1, first.slice_size());
+      block = std::max<int>(1, detail::FUSION_BLOCK_SIZE / slice_size);
+    }
+    for (auto& s : g.stmts) {
+      s->start();
+    }
+    for (int k = 0; k < n; k += block) {
+      int count = std::min(block, n - k);
+      for (auto& s : g.stmts) {
+        s->run_slices(count);
+      }
+    }
+    for (auto& s : g.stmts) {
+      s->finish();
+    }
+  }
+
+  static int n_uncaught_exceptions()
+  {
+#if __cpp_lib_uncaught_exceptions >= 201411
+    return std::uncaught_exceptions();
+#else
+    return std::uncaught_exception() ? 1 : 0;
+#endif
+  }
+
+  fusion_scope* outer_;
+  int uncaught_;
+  int n_groups_ = 0;
+  std::vector<group> groups_;
+  std::vector<temporary_storage> temporaries_;
+};
+
+// ----------------------------------------------------------------------
+// deferred_assign implementation
+
+namespace detail
+{
+
+template <typename E1, typename E2, typename F>
+inline bool deferred_assign<space::host>::record(E1& lhs, const E2& rhs, F op)
+{
+  fusion_scope* scope = fusion_scope::current();
+  if (!scope) {
+    return false;
+  }
+  // a statement would be left with dangling views of operands that the
+  // expressions hold by value, so it runs right away, after what's pending
+  if (owns_operand_storage<E1>::value || owns_operand_storage<E2>::value) {
+    scope->flush();
+    return false;
+  }
+  scope->record(make_fusion_statement(lhs.to_kernel(), rhs.to_kernel(), op));
+  return true;
+}
+
+inline void deferred_assign<space::host>::flush()
+{
+  fusion_scope* scope = fusion_scope::current();
+  if (scope) {
+    scope->flush();
+  }
+}
+
+} // namespace detail
+
+} // namespace gt
+
+#endif
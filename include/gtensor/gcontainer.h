@@ -70,14 +70,14 @@ inline void gcontainer<D>::resize(const shape_type& shape)
   storage().resize(calc_size(shape));
 }
 
-#pragma nv_exec_check_disable
+GT_NV_EXEC_CHECK_DISABLE
 template <typename D>
 inline auto gcontainer<D>::data() const -> const_pointer
 {
   return storage().data();
 }
 
-#pragma nv_exec_check_disable
+GT_NV_EXEC_CHECK_DISABLE
 template <typename D>
 inline auto gcontainer<D>::data() -> pointer
 {
@@ -0,0 +1,404 @@
+
+// ======================================================================
+// gemm.h
+//
+// gemm, matmul : matrix products of 2-d arrays
+
+#ifndef GTENSOR_GEMM_H
+#define GTENSOR_GEMM_H
+
+#include "defs.h"
+#include "fusion.h"
+#include "gtensor.h"
+
+#ifdef GTENSOR_HAVE_CBLAS
+#include <cblas.h>
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace gt
+{
+
+namespace detail
+{
+
+// register block of the micro-kernel (rows of A x columns of B), and cache
+// blocks: a KC x NR panel of B and an MR x KC panel of A stay in L1, an
+// MC x KC block of A in L2 and a KC x NC block of B in L3
+constexpr const int GEMM_MR = 8;
+constexpr const int GEMM_NR = 4;
+constexpr const int GEMM_KC = 256;
+constexpr const int GEMM_MC = 128;
+constexpr const int GEMM_NC = 2048;
+
+// below this many multiply-adds, gemm runs on the calling thread only
+constexpr const size_type GEMM_PARALLEL_MIN = 64 * 64 * 64;
+
+// a matrix of any strides, rs between rows and cs between columns
+template <typename T>
+struct matrix_ref
+{
+  T* data;
+  int rows;
+  int cols;
+  std::ptrdiff_t rs;
+  std::ptrdiff_t cs;
+
+  T& operator()(int i, int j) const { return data[i * rs + j * cs]; }
+};
+
+template <typename T>
+inline bool overlaps(const matrix_ref<const T>& a, const matrix_ref<T>& c)
+{
+  auto extent = [](const auto& m, const T*& lo, const T*& hi) {
+    lo = hi = m.data;
+    for (auto step : {(m.rows - 1) * m.rs, (m.cols - 1) * m.cs}) {
+      (step < 0 ? lo : hi) += step;
+    }
+  };
+  const T *a_lo, *a_hi, *c_lo, *c_hi;
+  extent(a, a_lo, a_hi);
+  extent(c, c_lo, c_hi);
+  return !(a_hi < c_lo || c_hi < a_lo);
+}
+
+// an operand, read in place if it is stored as T, otherwise evaluated first
+
+template <typename T, typename E>
+inline matrix_ref<const T> as_matrix(const E& e, gtensor<T, 2>& tmp)
+{
+  shape_type<2> strides;
+  const T* data = stored_data(e, tmp, strides);
+  return {data, e.shape(0), e.shape(1), strides[0], strides[1]};
+}
+
+template <typename T>
+inline matrix_ref<const T> copy_matrix(const matrix_ref<const T>& m,
+                                       gtensor<T, 2>& tmp)
+{
+  tmp.resize(gt::shape(m.rows, m.cols));
+  for (int j = 0; j < m.cols; j++) {
+    for (int i = 0; i < m.rows; i++) {
+      tmp(i, j) = m(i, j);
+    }
+  }
+  return {tmp.data(), m.rows, m.cols, 1, m.rows};
+}
+
+// ----------------------------------------------------------------------
+// packing
+//
+// A block of A is packed into panels of MR rows, stored column after
+// column, and a block of B into panels of NR columns, stored row after row,
+// so that the micro-kernel reads both contiguously. Partial panels at the
+// edges are padded with zeros.
+
+template <typename T>
+inline void gemm_pack_a(const matrix_ref<const T>& a, int i0, int p0, int mc,
+                        int kc, T* ap)
+{
+  for (int ir = 0; ir < mc; ir += GEMM_MR) {
+    const int mr = std::min(GEMM_MR, mc - ir);
+    for (int p = 0; p < kc; p++) {
+      const T* col = &a(i0 + ir, p0 + p);
+      for (int i = 0; i < mr; i++) {
+        ap[i] = col[i * a.rs];
+      }
+      for (int i = mr; i < GEMM_MR; i++) {
+        ap[i] = T(0);
+      }
+      ap += GEMM_MR;
+    }
+  }
+}
+
+template <typename T>
+inline void gemm_pack_b(const matrix_ref<const T>& b, int p0, int j0, int kc,
+                        int nc, T* bp)
+{
+  for (int jr = 0; jr < nc; jr += GEMM_NR) {
+    const int nr = std::min(GEMM_NR, nc - jr);
+    for (int p = 0; p < kc; p++) {
+      const T* row = &b(p0 + p, j0 + jr);
+      for (int j = 0; j < nr; j++) {
+        bp[j] = row[j * b.cs];
+      }
+      for (int j = nr; j < GEMM_NR; j++) {
+        bp[j] = T(0);
+      }
+      bp += GEMM_NR;
+    }
+  }
+}
+
+// ----------------------------------------------------------------------
+// gemm_micro_kernel
+//
+// c(0:mr, 0:nr) = alpha * ap * bp + beta * c, for one MR x KC panel of A
+// and one KC x NR panel of B. The MR x NR accumulator has fixed size and
+// the inner loop is a rank-1 update of it, which the compiler keeps in
+// vector registers.
+
+template <typename T>
+inline void gemm_micro_kernel(int kc, const T* ap, const T* bp, T alpha,
+                              T beta, const matrix_ref<T>& c, int i0, int j0,
+                              int mr, int nr)
+{
+  T ab[GEMM_NR][GEMM_MR] = {};
+  for (int p = 0; p < kc; p++) {
+    for (int j = 0; j < GEMM_NR; j++) {
+      const T bj = bp[j];
+      for (int i = 0; i < GEMM_MR; i++) {
+        ab[j][i] += ap[i] * bj;
+      }
+    }
+    ap += GEMM_MR;
+    bp += GEMM_NR;
+  }
+
+  for (int j = 0; j < nr; j++) {
+    T* cj = &c(i0, j0 + j);
+    if (beta == T(0)) {
+      for (int i = 0; i < mr; i++) {
+        cj[i * c.rs] = alpha * ab[j][i];
+      }
+    } else {
+      for (int i = 0; i < mr; i++) {
+        cj[i * c.rs] = alpha * ab[j][i] + beta * cj[i * c.rs];
+      }
+    }
+  }
+}
+
+// ----------------------------------------------------------------------
+// gemm_blocked
+//
+// c = alpha * a * b + beta * c, blocked for the caches as described above.
+// The MC x KC blocks of A of each KC x NC block of B are spread across
+// threads, each with its own packed copy of its A block.
+
+template <typename T>
+inline void gemm_scale(T beta, const matrix_ref<T>& c)
+{
+  for (int j = 0; j < c.cols; j++) {
+    for (int i = 0; i < c.rows; i++) {
+      c(i, j) = beta == T(0) ? T(0) : beta * c(i, j);
+    }
+  }
+}
+
+template <typename T>
+inline void gemm_blocked(T alpha, const matrix_ref<const T>& a,
+                         const matrix_ref<const T>& b, T beta,
+                         const matrix_ref<T>& c)
+{
+  const int m = c.rows, n = c.cols, k = a.cols;
+  if (k == 0 || alpha == T(0)) {
+    gemm_scale(beta, c);
+    return;
+  }
+
+  const int n_ic = (m + GEMM_MC - 1) / GEMM_MC;
+  int n_threads = 1;
+  if (size_type(m) * n * k >= GEMM_PARALLEL_MIN) {
+    n_threads = std::max(1u, std::thread::hardware_concurrency());
+    n_threads = std::min(n_threads, n_ic);
+  }
+
+  std::vector<T> bp(size_type(GEMM_KC) *
+                    ((std::min(n, GEMM_NC) + GEMM_NR - 1) / GEMM_NR) *
+                    GEMM_NR);
+  std::vector<std::vector<T>> aps(
+    n_threads, std::vector<T>(size_type(GEMM_KC) * GEMM_MC));
+
+  for (int jc = 0; jc < n; jc += GEMM_NC) {
+    const int nc = std::min(GEMM_NC, n - jc);
+    for (int pc = 0; pc < k; pc += GEMM_KC) {
+      const int kc = std::min(GEMM_KC, k - pc);
+      const T beta_pc = pc == 0 ? beta : T(1);
+      gemm_pack_b(b, pc, jc, kc, nc, bp.data());
+
+      auto do_ic_blocks = [&](int t) {
+        T* ap = aps[t].data();
+        for (int ib = t; ib < n_ic; ib += n_threads) {
+          const int ic = ib * GEMM_MC;
+          const int mc = std::min(GEMM_MC, m - ic);
+          gemm_pack_a(a, ic, pc, mc, kc, ap);
+          for (int jr = 0; jr < nc; jr += GEMM_NR) {
+            const int nr = std::min(GEMM_NR, nc - jr);
+            for (int ir = 0; ir < mc; ir += GEMM_MR) {
+              const int mr = std::min(GEMM_MR, mc - ir);
+              gemm_micro_kernel(kc, ap + ir * kc, bp.data() + jr * kc, alpha,
+                                beta_pc, c, ic + ir, jc + jr, mr, nr);
+            }
+          }
+        }
+      };
+
+      std::vector<std::future<void>> others;
+      for (int t = 1; t < n_threads; t++) {
+        others.push_back(std::async(std::launch::async, do_ic_blocks, t));
+      }
+      do_ic_blocks(0);
+      for (auto& other : others) {
+        other.get();
+      }
+    }
+  }
+}
+
+// ----------------------------------------------------------------------
+// gemm_cblas
+//
+// Hands off to the system CBLAS, if available, for float and double
+// matrices that are unit-stride along one dimension. Returns false if it
+// didn't.
+
+template <typename T>
+inline bool gemm_cblas(T, const matrix_ref<const T>&,
+                       const matrix_ref<const T>&, T, const matrix_ref<T>&)
+{
+  return false;
+}
+
+#ifdef GTENSOR_HAVE_CBLAS
+
+// col-major with leading dimension ld, possibly transposed
+template <typename T>
+inline bool cblas_layout(const matrix_ref<T>& m, CBLAS_TRANSPOSE& trans,
+                         int& ld)
+{
+  if (m.rs == 1 && m.cs >= std::max(1, m.rows)) {
+    trans = CblasNoTrans;
+    ld = m.cs;
+    return true;
+  }
+  if (m.cs == 1 && m.rs >= std::max(1, m.cols)) {
+    trans = CblasTrans;
+    ld = m.rs;
+    return true;
+  }
+  return false;
+}
+
+template <typename T, typename F>
+inline bool gemm_cblas_impl(F cblas_gemm, T alpha,
+                            const matrix_ref<const T>& a,
+                            const matrix_ref<const T>& b, T beta,
+                            const matrix_ref<T>& c)
+{
+  CBLAS_TRANSPOSE ta, tb, tc;
+  int lda, ldb, ldc;
+  if (!cblas_layout(a, ta, lda) || !cblas_layout(b, tb, ldb) ||
+      !cblas_layout(c, tc, ldc) || tc != CblasNoTrans) {
+    return false;
+  }
+  cblas_gemm(CblasColMajor, ta, tb, c.rows, c.cols, a.cols, alpha, a.data,
+             lda, b.data, ldb, beta, c.data, ldc);
+  return true;
+}
+
+template <>
+inline bool gemm_cblas(double alpha, const matrix_ref<const double>& a,
+                       const matrix_ref<const double>& b, double beta,
+                       const matrix_ref<double>& c)
+{
+  return gemm_cblas_impl(cblas_dgemm, alpha, a, b, beta, c);
+}
+
+template <>
+inline bool gemm_cblas(float alpha, const matrix_ref<const float>& a,
+                       const matrix_ref<const float>& b, float beta,
+                       const matrix_ref<float>& c)
+{
+  return gemm_cblas_impl(cblas_sgemm, alpha, a, b, beta, c);
+}
+
+#endif
+
+} // namespace detail
+
+// ======================================================================
+// gemm
+//
+// c = alpha * a * b + beta * c for 2-d host arrays, where c is a gtensor or
+// a view of one, of any strides. a and b may be arbitrary expressions;
+// those that aren't stored as T in memory are evaluated first. As in BLAS,
+// c isn't read if beta is zero.
+//
+// The product is computed with a cache-blocked, packed micro-kernel,
+// spread across threads for larger matrices, or by the system CBLAS if one
+// was found at configure time (GTENSOR_HAVE_CBLAS) and the layouts allow.
+
+template <typename T, typename EA, typename EB, typename EC>
+void gemm(T alpha, const EA& a, const EB& b, T beta, EC&& c)
+{
+  using C = std::decay_t<EC>;
+  static_assert(expr_dimension<EA>() == 2 && expr_dimension<EB>() == 2 &&
+                  expr_dimension<C>() == 2,
+                "gemm: needs 2-d arrays");
+  static_assert(std::is_same<expr_space_type<C>, space::host>::value,
+                "gemm: only implemented on the host");
+  static_assert(detail::is_stored_as<T, C>::value,
+                "gemm: c needs to be stored as T in memory");
+
+  if (a.shape(1) != b.shape(0) || c.shape(0) != a.shape(0) ||
+      c.shape(1) != b.shape(1)) {
+    throw std::runtime_error("gemm: shapes " + to_string(a.shape()) + " x " +
+                             to_string(b.shape()) + " -> " +
+                             to_string(c.shape()) + " don't match");
+  }
+  if (c.shape(0) == 0 || c.shape(1) == 0) {
+    return;
+  }
+  // reads the data of a, b and c directly
+  detail::deferred_assign<space::host>::flush();
+
+  detail::matrix_ref<T> cm{&c.data_access(0), c.shape(0), c.shape(1),
+                           c.strides()[0], c.strides()[1]};
+  if (a.shape(1) == 0) {
+    detail::gemm_scale(beta, cm);
+    return;
+  }
+
+  gtensor<T, 2> a_tmp, b_tmp;
+  auto am = detail::as_matrix(a, a_tmp);
+  auto bm = detail::as_matrix(b, b_tmp);
+  // c is written while a and b are still read
+  if (detail::overlaps(am, cm)) {
+    am = detail::copy_matrix(am, a_tmp);
+  }
+  if (detail::overlaps(bm, cm)) {
+    bm = detail::copy_matrix(bm, b_tmp);
+  }
+
+  if (!detail::gemm_cblas(alpha, am, bm, beta, cm)) {
+    detail::gemm_blocked(alpha, am, bm, beta, cm);
+  }
+}
+
+// ======================================================================
+// matmul
+//
+// the matrix product a * b of 2-d arrays, as a new gtensor
+
+template <typename EA, typename EB>
+auto matmul(const EA& a, const EB& b)
+{
+  using T = std::decay_t<decltype(std::declval<expr_value_type<EA>>() *
+                                  std::declval<expr_value_type<EB>>())>;
+  gtensor<T, 2> c(gt::shape(a.shape(0), b.shape(1)));
+  gemm(T(1), a, b, T(0), c);
+  return c;
+}
+
+} // namespace gt
+
+#endif
@@ -2,11 +2,13 @@
 #ifndef GTENSOR_GFUNCTION_H
 #define GTENSOR_GFUNCTION_H
 
+#include "assign.h"
 #include "defs.h"
 #include "expression.h"
 #include "gscalar.h"
 #include "gstrided.h"
 #include "helper.h"
+#include "stepper.h"
 
 #include <numeric>
 
@@ -36,62 +38,6 @@ struct member_type<E, std::enable_if_t<is_expression<std::decay_t<E>>::value>>
 template <typename E>
 using to_expression_t = typename detail::member_type<E>::type;
 
-// ======================================================================
-// space_t
-
-namespace detail
-{
-
-template <typename S, typename T>
-struct space_type_op
-{
-  static_assert(!std::is_same<S, S>::value, "can't mix space types");
-};
-
-template <typename S>
-struct space_type_op<S, S>
-{
-  using type = S;
-};
-
-template <>
-struct space_type_op<space::any, space::any>
-{
-  using type = space::any;
-};
-
-template <typename S>
-struct space_type_op<space::any, S>
-{
-  using type = S;
-};
-
-template <typename S>
-struct space_type_op<S, space::any>
-{
-  using type = S;
-};
-
-template <typename...>
-struct space_type;
-
-template <typename S>
-struct space_type<S>
-{
-  using type = S;
-};
-
-template <typename S, typename... R>
-struct space_type<S, R...>
-{
-  using type = typename space_type_op<S, typename space_type<R...>::type>::type;
-};
-
-} // namespace detail
-
-template <typename... S>
-using space_t = typename detail::space_type<S...>::type;
-
 // ======================================================================
 // broadcast_shape
 
@@ -101,7 +47,7 @@ inline void broadcast_shape(S& to, const S2& from)
   // FIXME, rev it
   auto end_from = from.size() - 1;
   auto end_to = to.size() - 1;
-  for (int i = 0; i < from.size(); i++) {
+  for (int i = 0; i < int(from.size()); i++) {
     if (from[end_from - i] == to[end_to - i]) {
       // nothing to do
     } else if (to[end_to - i] == 1) {
@@ -159,6 +105,11 @@ inline void calc_shape(S& shape, const std::tuple<E...>& e)
 template <typename F, typename... E>
 class gfunction;
 
+template <typename F, typename... E>
+struct owns_operand_storage<gfunction<F, E...>>
+  : disjunction<owned_storage<E>...>
+{};
+
 template <typename F, typename... E>
 struct gtensor_inner_types<gfunction<F, E...>>
 {
@@ -187,41 +138,71 @@ public:
 
   using shape_type = gt::shape_type<dimension()>;
 
-  gfunction(F&& f, E&&... e) : f_(std::forward<F>(f)), e_(std::forward<E>(e)...)
-  {}
+  gfunction(F&& f, E&&... e);
 
-  shape_type shape() const;
-  int shape(int i) const;
+  GT_INLINE const shape_type& shape() const;
+  GT_INLINE int shape(int i) const;
 
   template <typename... Args>
   GT_INLINE value_type operator()(Args... args) const;
 
   gfunction<F, to_kernel_t<E>...> to_kernel() const;
 
+  const std::tuple<E...>& operands() const { return e_; }
+
+  template <typename S>
+  auto stepper(const S& shape) const;
+
 private:
+  gfunction(const shape_type& shape, F&& f, E&&... e);
+
+  template <std::size_t... I, typename S>
+  auto stepper(std::index_sequence<I...>, const S& shape) const;
+
+  template <std::size_t... I>
+  gfunction<F, to_kernel_t<E>...> to_kernel_impl(
+    std::index_sequence<I...>) const;
+
   template <std::size_t... I, typename... Args>
   GT_INLINE value_type access(std::index_sequence<I...>, Args... args) const;
 
 private:
   F f_;
   std::tuple<E...> e_;
+  // The broadcast shape is calculated (and checked) once on construction. It
+  // won't follow if operands held by reference are resized afterwards.
+  shape_type shape_;
+
+  template <typename F2, typename... E2>
+  friend class gfunction;
 };
 
 // ----------------------------------------------------------------------
 // gfunction implementation
 
 template <typename F, typename... E>
-inline auto gfunction<F, E...>::shape() const -> shape_type
+inline gfunction<F, E...>::gfunction(F&& f, E&&... e)
+  : f_(std::forward<F>(f)), e_(std::forward<E>(e)...)
 {
-  shape_type shape;
-  calc_shape(shape, e_);
-  return shape;
+  calc_shape(shape_, e_);
+}
+
+template <typename F, typename... E>
+inline gfunction<F, E...>::gfunction(const shape_type& shape, F&& f,
+                                     E&&... e)
+  : f_(std::forward<F>(f)), e_(std::forward<E>(e)...), shape_(shape)
+{}
+
+template <typename F, typename... E>
+inline auto gfunction<F, E...>::shape() const -> const shape_type&
+{
+  return shape_;
 }
 
 template <typename F, typename... E>
 inline int gfunction<F, E...>::shape(int i) const
 {
-  return shape()[i];
+  return shape_[i];
 }
 
 template <typename F, typename... E>
@@ -231,7 +212,7 @@ inline auto gfunction<F, E...>::operator()(Args... args) const -> value_type
   return access(std::make_index_sequence<sizeof...(E)>(), args...);
 }
 
-#pragma nv_exec_check_disable
+GT_NV_EXEC_CHECK_DISABLE
 template <typename F, typename... E>
 template <std::size_t... I, typename... Args>
 inline auto gfunction<F, E...>::access(std::index_sequence<I...>,
@@ -241,29 +222,42 @@ inline auto gfunction<F, E...>::access(std::index_sequence<I...>,
 }
 
 template <typename F, typename... E>
-auto function(F&& f, E&&... e)
+template <typename S>
+inline auto gfunction<F, E...>::stepper(const S& shape) const
 {
-  return gfunction<F, to_expression_t<E>...>(std::forward<F>(f),
-                                             std::forward<E>(e)...);
+  return stepper(std::make_index_sequence<sizeof...(E)>(), shape);
 }
 
-namespace detail
+template <typename F, typename... E>
+template <std::size_t... I, typename S>
+inline auto gfunction<F, E...>::stepper(std::index_sequence<I...>,
+                                        const S& shape) const
 {
+  return detail::make_function_stepper(
+    f_, detail::make_stepper(std::get<I>(e_), shape)...);
+}
 
-template <typename F, std::size_t... I, typename... E>
-inline auto make_gfunction(const F& f, std::index_sequence<I...>,
-                           const std::tuple<E...>& e)
+template <typename F, typename... E>
+auto function(F&& f, E&&... e)
 {
-  return function(F(f), (std::get<I>(e).to_kernel())...);
+  return gfunction<F, to_expression_t<E>...>(std::forward<F>(f),
+                                             std::forward<E>(e)...);
 }
 
-} // namespace detail
-
 template <typename F, typename... E>
 inline gfunction<F, to_kernel_t<E>...> gfunction<F, E...>::to_kernel() const
 {
-  return detail::make_gfunction(f_, std::make_index_sequence<sizeof...(E)>(),
-                                e_);
+  return to_kernel_impl(std::make_index_sequence<sizeof...(E)>());
+}
+
+template <typename F, typename... E>
+template <std::size_t... I>
+inline gfunction<F, to_kernel_t<E>...> gfunction<F, E...>::to_kernel_impl(
+  std::index_sequence<I...>) const
+{
+  // reuse the already calculated shape rather than redoing the broadcast
+  return gfunction<F, to_kernel_t<E>...>(shape_, F(f_),
+                                         std::get<I>(e_).to_kernel()...);
 }
 
 #define MAKE_UNARY_OP(NAME, OP)                                                \
@@ -319,8 +313,129 @@ MAKE_BINARY_OP(minus, -)
 MAKE_BINARY_OP(multiply, *)
 MAKE_BINARY_OP(divide, /)
 
+// comparisons, elementwise and lazy, with bool values. == and != compare
+// whole expressions (below); the elementwise ones are equal and not_equal.
+MAKE_BINARY_OP(less, <)
+MAKE_BINARY_OP(less_equal, <=)
+MAKE_BINARY_OP(greater, >)
+MAKE_BINARY_OP(greater_equal, >=)
+
 #undef MAKE_BINARY_OP
 
+#define MAKE_BINARY_FUNC(NAME, EXPR)                                           \
+  namespace ops                                                                \
+  {                                                                            \
+                                                                               \
+  struct NAME                                                                  \
+  {                                                                            \
+    template <typename T, typename U>                                          \
+    GT_INLINE bool operator()(T a, U b) const                                  \
+    {                                                                          \
+      return EXPR;                                                             \
+    }                                                                          \
+  };                                                                           \
+                                                                               \
+  } /* namespace ops */                                                        \
+                                                                               \
+  template <typename E1, typename E2,                                          \
+            typename Enable = std::enable_if_t<has_expression<E1, E2>::value>> \
+  auto NAME(E1&& e1, E2&& e2)                                                  \
+  {                                                                            \
+    return function(ops::NAME{}, std::forward<E1>(e1), std::forward<E2>(e2));  \
+  }
+
+MAKE_BINARY_FUNC(equal, a == b)
+MAKE_BINARY_FUNC(not_equal, a != b)
+MAKE_BINARY_FUNC(logical_and, bool(a) & bool(b))
+MAKE_BINARY_FUNC(logical_or, bool(a) | bool(b))
+
+#undef MAKE_BINARY_FUNC
+
+// && and || are elementwise, too, and so evaluate both sides
+
+template <typename E1, typename E2,
+          typename Enable = std::enable_if_t<has_expression<E1, E2>::value>>
+auto operator&&(E1&& e1, E2&& e2)
+{
+  return logical_and(std::forward<E1>(e1), std::forward<E2>(e2));
+}
+
+template <typename E1, typename E2,
+          typename Enable = std::enable_if_t<has_expression<E1, E2>::value>>
+auto operator||(E1&& e1, E2&& e2)
+{
+  return logical_or(std::forward<E1>(e1), std::forward<E2>(e2));
+}
+
+namespace ops
+{
+
+struct logical_not
+{
+  template <typename T>
+  GT_INLINE bool operator()(T a) const
+  {
+    return !bool(a);
+  }
+};
+
+// c ? a : b, in the common type of a and b. Both are evaluated, which lets
+// the compiler turn the conditional into a blend rather than a branch.
+struct where
+{
+  template <typename C, typename T, typename U>
+  GT_INLINE auto operator()(C c, T a, U b) const
+  {
+    using V = std::common_type_t<T, U>;
+    const V va = a, vb = b;
+    return bool(c) ? va : vb;
+  }
+};
+
+} // namespace ops
+
+template <typename E,
+          typename Enable = std::enable_if_t<has_expression<E>::value>>
+auto operator!(E&& e)
+{
+  return function(ops::logical_not{}, std::forward<E>(e));
+}
+
+template <typename E, typename E1, typename E2,
+          typename Enable =
+            std::enable_if_t<has_expression<E, E1, E2>::value>>
+auto where(E&& cond, E1&& e1, E2&& e2)
+{
+  return function(ops::where{}, std::forward<E>(cond), std::forward<E1>(e1),
+                  std::forward<E2>(e2));
+}
+
+// ----------------------------------------------------------------------
+// gstrided compound assignment operators
+
+#define MAKE_COMPOUND_ASSIGN_OP(NAME, OP)                                      \
+  template <typename D>                                                        \
+  template <typename E>                                                        \
+  inline D& gstrided<D>::operator OP(const expression<E>& e)                   \
+  {                                                                            \
+    compound_assign(derived(), e.derived(), ops::NAME{});                      \
+    return derived();                                                          \
+  }                                                                            \
+                                                                               \
+  template <typename D>                                                        \
+  inline D& gstrided<D>::operator OP(value_type val)                           \
+  {                                                                            \
+    compound_assign(derived(), scalar(val), ops::NAME{});                      \
+    return derived();                                                          \
+  }
+
+MAKE_COMPOUND_ASSIGN_OP(plus, +=)
+MAKE_COMPOUND_ASSIGN_OP(minus, -=)
+MAKE_COMPOUND_ASSIGN_OP(multiply, *=)
+MAKE_COMPOUND_ASSIGN_OP(divide, /=)
+
+#undef MAKE_COMPOUND_ASSIGN_OP
+
 // ----------------------------------------------------------------------
 // operator==, !-
 //
@@ -334,7 +449,7 @@ template <size_type N1, size_type N2>
 struct equals
 {
   template <typename E1, typename E2>
-  static bool run(const E1& e1, const E2& e2)
+  static bool run(const E1&, const E2&)
   {
     return false;
   }
@@ -0,0 +1,293 @@
+
+// ======================================================================
+// ghosted.h
+//
+// ghosted_gtensor : a gtensor padded with ghost points, with views of its
+// interior and halos, and packing of faces for halo exchange
+
+#ifndef GTENSOR_GHOSTED_H
+#define GTENSOR_GHOSTED_H
+
+#include "defs.h"
+#include "gtensor.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace gt
+{
+
+namespace detail
+{
+
+// ======================================================================
+// face_packer
+//
+// Copies between a face of an array and a contiguous buffer. In col-major
+// order, a face of width g normal to dimension d consists of blocks of
+// g * (extent of dims < d) contiguous elements, one per index in dims > d.
+// On the host, that's a loop of block copies, which is a single one for the
+// last dimension. On the device, the copy goes through a regular
+// assignment between views.
+
+template <typename S>
+struct face_packer
+{
+  template <typename V>
+  static void pack(const V& face, V& packed)
+  {
+    packed = face;
+  }
+
+  template <typename V>
+  static void unpack(const V& packed, V& halo)
+  {
+    halo = packed;
+  }
+};
+
+template <typename T>
+inline void copy_blocks(const T* src, size_type src_stride, T* dst,
+                        size_type dst_stride, size_type n_blocks,
+                        size_type len)
+{
+  if (len == 1) {
+    for (size_type b = 0; b < n_blocks; b++) {
+      dst[b * dst_stride] = src[b * src_stride];
+    }
+    return;
+  }
+  for (size_type b = 0; b < n_blocks; b++) {
+    std::copy(src + b * src_stride, src + b * src_stride + len,
+              dst + b * dst_stride);
+  }
+}
+
+template <>
+struct face_packer<space::host>
+{
+  template <typename V>
+  static void pack(const V& face, V& packed)
+  {
+    // copies storage directly, after what a fusion_scope may have deferred
+    deferred_assign<space::host>::flush();
+    size_type len, stride, n_blocks;
+    layout(face, len, stride, n_blocks);
+    copy_blocks(face.data(), stride, packed.data(), len, n_blocks, len);
+  }
+
+  template <typename V>
+  static void unpack(const V& packed, V& halo)
+  {
+    deferred_assign<space::host>::flush();
+    size_type len, stride, n_blocks;
+    layout(halo, len, stride, n_blocks);
+    copy_blocks(packed.data(), len, halo.data(), stride, n_blocks, len);
+  }
+
+private:
+  // the face is a view of a col-major array that's complete in all
+  // dimensions but one. Dimensions of extent 1 don't matter for the layout,
+  // and have stride 0 in the array, so they are skipped.
+  template <typename V>
+  static void layout(const V& face, size_type& len, size_type& stride,
+                     size_type& n_blocks)
+  {
+    constexpr int N = expr_dimension<V>();
+    const auto& strides = face.strides();
+    bool contiguous = true;
+    len = 1;
+    stride = 0;
+    n_blocks = 1;
+    for (int d = 0; d < N; d++) {
+      if (face.shape(d) == 1) {
+        continue;
+      }
+      if (contiguous && strides[d] == int(len)) {
+        len *= face.shape(d);
+      } else {
+        if (contiguous) {
+          stride = strides[d];
+          contiguous = false;
+        }
+        n_blocks *= face.shape(d);
+      }
+    }
+    if (contiguous) {
+      stride = len;
+    }
+  }
+};
+
+} // namespace detail
+
+// ======================================================================
+// ghosted_gtensor
+//
+// A gtensor of the given (interior) shape, padded with ghosts[d] ghost
+// points on either side of each dimension d. Indices of the underlying
+// storage() are shifted by the ghost widths relative to the interior, e.g.,
+// for a 1-d array with 2 ghost points, interior()(0) is storage()(2).
+//
+// For halo exchange, along dimension d and side 0 (lower) or 1 (upper):
+//
+// - halo(d, side) are the ghost points on that side, spanning all of the
+//   other dimensions, including their ghost points. Filling the halos one
+//   dimension after the other therefore takes care of edges and corners.
+// - face(d, side) are the interior points that a neighbour on that side
+//   needs for its halo, i.e., a slab of the same shape as the halo.
+// - pack(d, side, buf) copies the face into a contiguous buffer of
+//   face_size(d) elements, unpack(d, side, buf) copies a buffer into the
+//   halo. packed(buf, d) is the buffer viewed with the shape of the face.
+
+template <typename T, int N, typename S = space::host>
+class ghosted_gtensor
+{
+public:
+  using tensor_type = gtensor<T, N, S>;
+  using view_type = gtensor_view<T, N, S>;
+  using value_type = T;
+  using pointer = typename tensor_type::pointer;
+  using const_pointer = typename tensor_type::const_pointer;
+  using shape_type = gt::shape_type<N>;
+  using space_type = S;
+
+  ghosted_gtensor() = default;
+  ghosted_gtensor(const shape_type& shape, const shape_type& ghosts);
+
+  const shape_type& shape() const { return shape_; }
+  int shape(int d) const { return shape_[d]; }
+  const shape_type& ghosts() const { return ghosts_; }
+
+  tensor_type& storage() { return storage_; }
+  const tensor_type& storage() const { return storage_; }
+
+  view_type interior() const;
+
+  view_type halo(int d, int side) const;
+  view_type face(int d, int side) const;
+
+  shape_type face_shape(int d) const;
+  size_type face_size(int d) const;
+  view_type packed(pointer buf, int d) const;
+
+  void pack(int d, int side, pointer buf) const;
+  void unpack(int d, int side, pointer buf);
+
+private:
+  view_type slab(int d, int start, int width) const;
+
+  shape_type shape_;
+  shape_type ghosts_;
+  tensor_type storage_;
+};
+
+// ----------------------------------------------------------------------
+// ghosted_gtensor implementation
+
+namespace detail
+{
+
+template <size_type N>
+inline shape_type<N> ghosted_shape(const shape_type<N>& shape,
+                                   const shape_type<N>& ghosts)
+{
+  shape_type<N> full;
+  for (int d = 0; d < int(N); d++) {
+    if (shape[d] < 0 || ghosts[d] < 0) {
+      throw std::runtime_error("ghosted_gtensor: negative shape or ghosts");
+    }
+    full[d] = shape[d] + 2 * ghosts[d];
+  }
+  return full;
+}
+
+} // namespace detail
+
+template <typename T, int N, typename S>
+inline ghosted_gtensor<T, N, S>::ghosted_gtensor(const shape_type& shape,
+                                                 const shape_type& ghosts)
+  : shape_(shape),
+    ghosts_(ghosts),
+    storage_(detail::ghosted_shape(shape, ghosts))
+{}
+
+template <typename T, int N, typename S>
+inline auto ghosted_gtensor<T, N, S>::interior() const -> view_type
+{
+  const auto& strides = storage_.strides();
+  size_type offset = 0;
+  for (int d = 0; d < N; d++) {
+    offset += ghosts_[d] * strides[d];
+  }
+  return view_type(storage_.to_kernel().data() + offset, shape_, strides);
+}
+
+template <typename T, int N, typename S>
+inline auto ghosted_gtensor<T, N, S>::slab(int d, int start, int width) const
+  -> view_type
+{
+  if (d < 0 || d >= N) {
+    throw std::runtime_error("ghosted_gtensor: dimension out of range");
+  }
+  const auto& strides = storage_.strides();
+  auto shape = storage_.shape();
+  shape[d] = width;
+  return view_type(storage_.to_kernel().data() + start * strides[d], shape,
+                   strides);
+}
+
+template <typename T, int N, typename S>
+inline auto ghosted_gtensor<T, N, S>::halo(int d, int side) const -> view_type
+{
+  return slab(d, side == 0 ? 0 : ghosts_[d] + shape_[d], ghosts_[d]);
+}
+
+template <typename T, int N, typename S>
+inline auto ghosted_gtensor<T, N, S>::face(int d, int side) const -> view_type
+{
+  if (shape_[d] < ghosts_[d]) {
+    throw std::runtime_error("ghosted_gtensor: interior thinner than ghosts");
+  }
+  return slab(d, side == 0 ? ghosts_[d] : shape_[d], ghosts_[d]);
+}
+
+template <typename T, int N, typename S>
+inline auto ghosted_gtensor<T, N, S>::face_shape(int d) const -> shape_type
+{
+  auto shape = storage_.shape();
+  shape[d] = ghosts_[d];
+  return shape;
+}
+
+template <typename T, int N, typename S>
+inline size_type ghosted_gtensor<T, N, S>::face_size(int d) const
+{
+  return calc_size(face_shape(d));
+}
+
+template <typename T, int N, typename S>
+inline auto ghosted_gtensor<T, N, S>::packed(pointer buf, int d) const
+  -> view_type
+{
+  auto shape = face_shape(d);
+  return view_type(buf, shape, calc_strides(shape));
+}
+
+template <typename T, int N, typename S>
+inline void ghosted_gtensor<T, N, S>::pack(int d, int side, pointer buf) const
+{
+  auto packed_face = packed(buf, d);
+  detail::face_packer<S>::pack(face(d, side), packed_face);
+}
+
+template <typename T, int N, typename S>
+inline void ghosted_gtensor<T, N, S>::unpack(int d, int side, pointer buf)
+{
+  auto halo_slab = halo(d, side);
+  detail::face_packer<S>::unpack(packed(buf, d), halo_slab);
+}
+
+} // namespace gt
+
+#endif
@@ -0,0 +1,1088 @@
+
+#ifndef GTENSOR_GMATH_H
+#define GTENSOR_GMATH_H
+
+#include "complex.h"
+#include "defs.h"
+#include "gfunction.h"
+#include "macros.h"
+#include "sarray.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace gt
+{
+
+// ======================================================================
+// elementwise math functions
+//
+// exp, log, sqrt, sin, cos, abs, pow, conj, real and imag return lazy
+// gfunctions, like the arithmetic operators. For float and double (and
+// complex of either) they don't call into libm, whose calls keep the
+// assignment loop from being vectorized, but evaluate branch-free
+// polynomial approximations that the compiler can vectorize. Other value
+// types fall back to the std:: functions.
+//
+// Maximum error, measured against long double libm, in ulp of the result
+// (double / float):
+//
+//   exp    1.2 / 1.2   over- and underflow (to subnormals, too) as libm
+//   log    0.9 / 0.9
+//   sqrt   0.8 / 0.8   so not always correctly rounded, unlike std::sqrt
+//   sin    2.4 / 0.5   for |x| >= 2^20, the reduction adds an absolute error
+//   cos    2.4 / 0.5   of up to 1e-22, which matters only for results near 0
+//   pow    1.3 + 0.002 |y log(x)| / 0.5
+//
+// The float sin, cos and pow are evaluated in double. sin and cos reduce
+// large arguments by a second, much longer, method, which is evaluated for
+// every element, as there are no branches, and makes them about three to
+// four times as expensive as they'd be otherwise. For complex z, the
+// error of exp, log, sqrt, sin, cos and pow is a few ulp relative to |f(z)|
+// (log: to max(|log(z)|, 1)), so that a part much smaller than the other
+// may have a large relative error; abs(z) is within 3 ulp and overflows
+// only if |z| does. Special values (inf, nan, +-0) follow libm, for
+// complex arguments up to the signs of zeros and infinities.
+//
+// The double kernels need 64-bit integer compares to vectorize, which on
+// x86 means SSE4.2 (-march=x86-64-v2) or better. Without, they'd be slower
+// than libm, so that real double arguments use std:: there, unless
+// GTENSOR_MATH_DOUBLE_KERNELS is defined to 1. The float ones vectorize
+// with plain SSE2. Whether loops storing complex results vectorize depends
+// on the compiler (gcc 12 doesn't).
+//
+// pow<K>(e) for a compile-time integer K, and polyval(c, e) for polynomials,
+// evaluate in a single node by multiplications (and additions) only,
+// rather than as a tree of arithmetic operator nodes.
+
+#ifndef GTENSOR_MATH_DOUBLE_KERNELS
+#if defined(__x86_64__) && !defined(__SSE4_2__)
+#define GTENSOR_MATH_DOUBLE_KERNELS 0
+#else
+#define GTENSOR_MATH_DOUBLE_KERNELS 1
+#endif
+#endif
+
+namespace detail
+{
+
+template <typename T>
+struct math_float;
+
+template <>
+struct math_float<double>
+{
+  using uint = std::uint64_t;
+  static constexpr int mant = 52;
+  static constexpr int bias = 1023;
+  static constexpr double min_normal = 2.2250738585072014e-308;
+
+  // x + round_magic - round_magic rounds x to an integer, and leaves it
+  // in the low bits of the sum
+  static constexpr double round_magic = 6755399441055744.; // 1.5 * 2^52
+
+  static constexpr double exp_lo = -746.;
+  static constexpr double exp_hi = 710.;
+  static constexpr double ln2_hi = 6.93147180369123816490e-01;
+  static constexpr double ln2_lo = 1.90821492927058770002e-10;
+
+  // pi / 2 in three parts, the first two with 33 significant bits
+  static constexpr double pio2_1 = 1.57079632673412561417e+00;
+  static constexpr double pio2_2 = 6.07710050630396597660e-11;
+  static constexpr double pio2_3 = 2.02226624879595063154e-21;
+
+  static constexpr uint rsqrt_magic = 0x5fe6eb50c7b537a9;
+  static constexpr int rsqrt_steps = 4;
+  // subnormals are scaled by 2^scale_exp
+  static constexpr int scale_exp = 54;
+  static constexpr double scale = 18014398509481984.;
+  static constexpr double sqrt_unscale = 7.450580596923828125e-9; // 2^-27
+};
+
+template <>
+struct math_float<float>
+{
+  using uint = std::uint32_t;
+  static constexpr int mant = 23;
+  static constexpr int bias = 127;
+  static constexpr float min_normal = 1.17549435e-38f;
+  static constexpr float round_magic = 12582912.f; // 1.5 * 2^23
+
+  static constexpr float exp_lo = -104.f;
+  static constexpr float exp_hi = 89.f;
+  static constexpr float ln2_hi = 6.93145751953125e-01f;
+  static constexpr float ln2_lo = 1.42860676533018704e-06f;
+
+  static constexpr uint rsqrt_magic = 0x5f375a86;
+  static constexpr int rsqrt_steps = 3;
+  static constexpr int scale_exp = 24;
+  static constexpr float scale = 16777216.f;
+  static constexpr float sqrt_unscale = 2.44140625e-4f; // 2^-12
+};
+
+template <typename T>
+using math_uint = typename math_float<T>::uint;
+
+template <typename T>
+GT_FORCE_INLINE math_uint<T> math_bits(T x)
+{
+  math_uint<T> u;
+  std::memcpy(&u, &x, sizeof(u));
+  return u;
+}
+
+template <typename T>
+GT_FORCE_INLINE T math_from_bits(math_uint<T> u)
+{
+  T x;
+  std::memcpy(&x, &u, sizeof(x));
+  return x;
+}
+
+// c ? a : b, without branches. A plain conditional does as well when
+// its result is the end result, but when it feeds more arithmetic and a or b
+// is a constant, the compiler specializes that arithmetic on a branch of its
+// own, which keeps the loop from being vectorized (under -ftrapping-math,
+// the default). The comparisons are the quiet std::isless etc. for the same
+// reason.
+template <typename T>
+GT_FORCE_INLINE T math_select(bool c, T a, T b)
+{
+  using U = math_uint<T>;
+  const U m = c ? ~U(0) : U(0);
+  return math_from_bits<T>((math_bits(a) & m) | (math_bits(b) & ~m));
+}
+
+// std::signbit, but as a comparison, which vectorizes where the bit test
+// doesn't
+template <typename T>
+GT_FORCE_INLINE bool math_signbit(T x)
+{
+  return std::isless(std::copysign(T(1), x), T(0));
+}
+
+// c0 + x * (c1 + x * (c2 + ...))
+template <typename T, typename C>
+GT_FORCE_INLINE T math_horner(T, C c0)
+{
+  return T(c0);
+}
+
+template <typename T, typename C, typename... Cs>
+GT_FORCE_INLINE T math_horner(T x, C c0, Cs... cs)
+{
+  return T(c0) + x * math_horner(x, cs...);
+}
+
+// exp(r) for |r| <= ln(2) / 2, Taylor to the point where the remainder is
+// below half an ulp
+GT_FORCE_INLINE double math_exp_poly(double r)
+{
+  return math_horner(r, 1., 1., 1. / 2, 1. / 6, 1. / 24, 1. / 120, 1. / 720,
+                     1. / 5040, 1. / 40320, 1. / 362880, 1. / 3628800,
+                     1. / 39916800, 1. / 479001600, 1. / 6227020800.);
+}
+
+GT_FORCE_INLINE float math_exp_poly(float r)
+{
+  return math_horner(r, 1., 1., 1. / 2, 1. / 6, 1. / 24, 1. / 120, 1. / 720,
+                     1. / 5040);
+}
+
+// exp(x) = 2^n exp(r), r = x - n ln(2) with ln(2) split in two so that
+// n ln2_hi is exact. 2^n is applied as two factors, each a normal number,
+// so that results which over- or underflow (to subnormals, too) come out
+// of the last multiplication correctly rounded.
+template <typename T>
+GT_FORCE_INLINE T math_exp_impl(T x)
+{
+  using F = math_float<T>;
+  using U = math_uint<T>;
+  const T lo = F::exp_lo, hi = F::exp_hi, magic = F::round_magic;
+
+  // nan passes through both
+  x = math_select(std::isless(x, lo), lo, x);
+  x = math_select(std::isgreater(x, hi), hi, x);
+  const T t = x * T(1.44269504088896340736) + magic;
+  const T n = t - magic;
+  const T r = (x - n * T(F::ln2_hi)) - n * T(F::ln2_lo);
+
+  // n + 2 bias + 2 > 0, halved to floor(n / 2) + bias + 1
+  const U u = math_bits(t) - math_bits(magic) + U(2 * F::bias + 2);
+  const U h = u >> 1;
+  const T s1 = math_from_bits<T>((h - 1) << F::mant);
+  const T s2 = math_from_bits<T>((u - h - 1) << F::mant);
+  return math_exp_poly(r) * s1 * s2;
+}
+
+// s (2 / 3 + 2 / 5 z + 2 / 7 z^2 + ...), z = s^2 <= 0.0295
+GT_FORCE_INLINE double math_log_poly(double z)
+{
+  return z * math_horner(z, 2. / 3, 2. / 5, 2. / 7, 2. / 9, 2. / 11, 2. / 13,
+                         2. / 15, 2. / 17, 2. / 19, 2. / 21);
+}
+
+GT_FORCE_INLINE float math_log_poly(float z)
+{
+  return z * math_horner(z, 2. / 3, 2. / 5, 2. / 7, 2. / 9);
+}
+
+// x = 2^e m, m in [sqrt(2) / 2, sqrt(2)), for finite x > 0
+template <typename T>
+GT_FORCE_INLINE void math_log_reduce(T x, T& m, T& e)
+{
+  using F = math_float<T>;
+  using U = math_uint<T>;
+  const T two_mant = T(U(1) << F::mant);
+
+  const bool sub = std::isless(x, T(F::min_normal));
+  const T y = math_select(sub, x * T(F::scale), x);
+  const U u = math_bits(y);
+  m = math_from_bits<T>((u & ((U(1) << F::mant) - 1)) | math_bits(T(1)));
+  // the biased exponent, as a floating point number
+  e = math_from_bits<T>(math_bits(two_mant) | (u >> F::mant)) - two_mant;
+
+  const bool big = std::isgreater(m, T(1.41421356237309504880));
+  m = math_select(big, T(.5) * m, m);
+  e = e + math_select(big, T(1), T(0)) - T(F::bias) -
+      math_select(sub, T(F::scale_exp), T(0));
+}
+
+// log(x) = e ln(2) + log(m), and with f = m - 1, s = f / (2 + f), log(m) =
+// 2 atanh(s) = f - f^2 / 2 + s (f^2 / 2 + R(s^2)), which keeps the leading
+// term exact.
+template <typename T>
+GT_FORCE_INLINE T math_log_impl(T x)
+{
+  using F = math_float<T>;
+  const T inf = std::numeric_limits<T>::infinity();
+
+  T m, e;
+  math_log_reduce(x, m, e);
+  const T f = m - T(1);
+  const T s = f / (T(2) + f);
+  const T hfsq = T(.5) * f * f;
+  const T R = math_log_poly(s * s);
+  T r = e * T(F::ln2_hi) -
+        ((hfsq - (s * (hfsq + R) + e * T(F::ln2_lo))) - f);
+
+  r = math_select(x == inf, x, r);
+  r = math_select(x == T(0), -inf, r);
+  return math_select(std::isless(x, T(0)) | std::isnan(x),
+                     std::numeric_limits<T>::quiet_NaN(), r);
+}
+
+// hi + lo = a b exactly. Without a fused multiply-add, by Dekker's product
+// of a and b split into halves of 26 bits each, all of whose products are
+// exact, so that it holds under -ffp-contract, too.
+GT_FORCE_INLINE void math_two_prod(double a, double b, double& hi, double& lo)
+{
+  hi = a * b;
+#ifdef FP_FAST_FMA
+  lo = std::fma(a, b, -hi);
+#else
+  const double c = 134217729.; // 2^27 + 1
+  const double ta = c * a, tb = c * b;
+  const double ah = ta - (ta - a), al = a - ah;
+  const double bh = tb - (tb - b), bl = b - bh;
+  lo = ((ah * bh - hi) + ah * bl + al * bh) + al * bl;
+#endif
+}
+
+// log(x) as hi + lo, to about 2^-64 relative, for finite x > 0. As in
+// math_log_impl, but with log(m) = 2 s + 2 / 3 s^3 + s^5 Q(s^2), s = f /
+// (m + 1), where s and the first two terms are carried in two doubles. e
+// ln2_hi is exact.
+GT_FORCE_INLINE void math_log_dd(double x, double& hi, double& lo)
+{
+  using F = math_float<double>;
+  const double two_thirds_lo = 3.70074341541718826e-17; // 2 / 3 - double
+
+  double m, e;
+  math_log_reduce(x, m, e);
+  // f, m + 1 - 1 and the rounding error of m + 1 are exact
+  const double f = m - 1.;
+  const double d = m + 1., d_lo = m - (d - 1.);
+  double s = f / d, p, p_lo;
+  math_two_prod(s, d, p, p_lo);
+  const double s_lo = (((f - p) - p_lo) - s * d_lo) / d;
+
+  double z, z_lo, c, c_lo, t, t_lo;
+  math_two_prod(s, s, z, z_lo);
+  math_two_prod(s, z, c, c_lo);
+  c_lo = c_lo + s * z_lo + 3. * z * s_lo;
+  math_two_prod(c, 2. / 3, t, t_lo);
+  t_lo = t_lo + c_lo * (2. / 3) + c * two_thirds_lo;
+  const double q =
+    c * z *
+    math_horner(z, 2. / 5, 2. / 7, 2. / 9, 2. / 11, 2. / 13, 2. / 15, 2. / 17,
+                2. / 19, 2. / 21, 2. / 23, 2. / 25);
+
+  // |t| < |2 s| and |log(m)| < |e ln2_hi| unless e = 0, so the sums
+  // are exact as h + h_lo, which is renormalized last
+  const double l = 2. * s + t;
+  const double l_lo = ((2. * s - l) + t) + (2. * s_lo + t_lo + q);
+  const double a = e * F::ln2_hi;
+  const double h = a + l;
+  const double h_lo = ((a - h) + l) + (l_lo + e * F::ln2_lo);
+  hi = h + h_lo;
+  lo = h_lo - (hi - h);
+}
+
+// sin(r) and cos(r) for |r| <= pi / 4
+GT_FORCE_INLINE void math_sincos_poly(double r, double& s, double& c)
+{
+  const double z = r * r;
+  s = r + r * z *
+            math_horner(z, -1. / 6, 1. / 120, -1. / 5040, 1. / 362880,
+                        -1. / 39916800, 1. / 6227020800.,
+                        -1. / 1307674368000., 1. / 355687428096000.);
+  c = 1. - .5 * z +
+      z * z *
+        math_horner(z, 1. / 24, -1. / 720, 1. / 40320, -1. / 3628800,
+                    1. / 479001600, -1. / 87178291200.,
+                    1. / 20922789888000., -1. / 6402373705728000.);
+}
+
+// s + e = a + b exactly
+GT_FORCE_INLINE void math_two_sum(double a, double b, double& s, double& e)
+{
+  s = a + b;
+  const double bb = s - a;
+  e = (a - (s - bb)) + (b - bb);
+}
+
+// 2 / pi = sum c_j 2^(-24 (j + 1)), in chunks c_j of 24 bits, after two
+// zeros
+template <typename T = void>
+struct math_two_over_pi
+{
+  static const double chunks[49];
+};
+
+template <typename T>
+const double math_two_over_pi<T>::chunks[49] = {
+  0., 0., 10680707., 7228996., 1387004., 2578385., 16069853., 12639074.,
+  9804092., 4427841., 16666979., 11263675., 12935607., 2387514., 4345298.,
+  14681673., 3074569., 13734428., 16653803., 1880361., 10960616., 8533493.,
+  3062596., 8710556., 7349940., 6258241., 3772886., 3769171., 3798172.,
+  8675211., 12450088., 3874808., 9961438., 366607., 15675153., 9132554.,
+  7151469., 3571407., 2607881., 12013382., 4155038., 6285869., 7677882.,
+  13102053., 15825725., 473591., 9065106., 15363067., 6271263.};
+
+// x 2 / pi = n + f, |f| <= 1 / 2, for finite x >= 2^20 (Payne-Hanek), with
+// n in the low bits of t, as the Cody-Waite reduction leaves it, and r = f
+// pi / 2. With x = m 2^q, m < 2^53 an integer split as m = mh 2^24 + ml,
+// x 2 / pi is a sum of products mh c_j and ml c_j, each exact, times powers
+// of two. Those that are multiples of 4 don't matter, and the next ones are
+// reduced modulo 4. The table lookups are all that differs by element.
+GT_FORCE_INLINE void math_pio2_reduce(double x, double& t, double& r)
+{
+  using F = math_float<double>;
+  using U = math_uint<double>;
+  const double magic = F::round_magic, two_mant = 4503599627370496.;
+  const double c24 = 16777216., r24 = 1. / 16777216.;
+  const double r48 = r24 * r24, r72 = r48 * r24;
+
+  const U ue = math_bits(x) >> F::mant;
+  const double q =
+    math_from_bits<double>(math_bits(two_mant) | ue) - two_mant - 1075.;
+  const double m = x * math_from_bits<double>((U(2098) - ue) << F::mant);
+  const double mh = (m * r24 + magic) - magic;
+  const double ml = m - mh * c24;
+
+  // c_j0 is the first chunk with mh c_j0 2^(q - 24 j0) < 4, so that w =
+  // 2^(q - 24 j0) is in [2^-22, 2]; ml c_j0-1 has the same weight
+  const double j0 = ((q + 10.5) * (1. / 24) + magic) - magic;
+  const U k = math_bits(j0 + (1. + magic)) - math_bits(magic);
+  const double* c = math_two_over_pi<>::chunks;
+  const double w = math_from_bits<double>(
+    (math_bits((q - 24. * j0 + 1023.) + magic) - math_bits(magic))
+    << F::mant);
+
+  const double w1 = w * r24, w2 = w * r48, w3 = w * r72, w4 = w3 * r24;
+  const double a0 = mh * c[k + 1] * w, b0 = ml * c[k] * w;
+  const double a1 = mh * c[k + 2] * w1, b1 = ml * c[k + 1] * w1;
+  const double a2 = mh * c[k + 3] * w2, b2 = ml * c[k + 2] * w2;
+  // 0 <= a0 < 2^54. Reduced modulo 4, a0 to b1 add up exactly, as
+  // multiples of w 2^-24 >= 2^-46 below 8.
+  double s = (a0 - ((a0 * .25 + two_mant) - two_mant) * 4.) +
+             (b0 - ((b0 * .25 + magic) - magic) * 4.) +
+             (a1 - ((a1 * .25 + magic) - magic) * 4.) +
+             (b1 - ((b1 * .25 + magic) - magic) * 4.);
+  double e0, e1, e2;
+  math_two_sum(s, a2, s, e0);
+  math_two_sum(s, b2, s, e1);
+  math_two_sum(s, mh * c[k + 4] * w3, s, e2);
+  const double lo = (e0 + e1 + e2) +
+                    (ml * c[k + 3] * w3 + (mh * c[k + 5] + ml * c[k + 4]) * w4 +
+                     (mh * c[k + 6] + ml * c[k + 5]) * (w4 * r24));
+
+  t = s + magic;
+  double f, f_lo, p, p_lo;
+  math_two_sum(s - (t - magic), lo, f, f_lo);
+  math_two_prod(f, 1.57079632679489655800, p, p_lo);
+  r = p + (p_lo + f * 6.12323399573676603587e-17 +
+           f_lo * 1.57079632679489655800);
+}
+
+// x = n pi / 2 + r, Cody-Waite with pi / 2 in three parts, or, for |x| >=
+// 2^20, where n pio2_1 wouldn't be exact any more, math_pio2_reduce. q = n
+// mod 4 selects between +-sin(r) and +-cos(r) by bit operations, without
+// branches; cos(x) is sin(x) one quadrant further.
+GT_FORCE_INLINE double math_sin_impl(double x, unsigned quadrant)
+{
+  using F = math_float<double>;
+  using U = math_uint<double>;
+  const double magic = F::round_magic, big = 1048576.;
+
+  double t = x * 0.636619772367581343076 + magic;
+  const double n = t - magic;
+  double r = ((x - n * F::pio2_1) - n * F::pio2_2) - n * F::pio2_3;
+
+  // for negative x, sin(x) = sin(-x) two quadrants further, cos(x) = cos(-x)
+  const double ax = std::fabs(x);
+  const bool large = std::isgreaterequal(ax, big);
+  const bool neg = std::isless(x, 0.);
+  double tl, rl;
+  math_pio2_reduce(math_select(large, ax, big), tl, rl);
+  t = math_select(large, tl, t);
+  r = math_select(large, rl, r);
+
+  double s, c;
+  math_sincos_poly(r, s, c);
+
+  const U q = math_bits(t) + U(quadrant) +
+              (U(large & neg & (quadrant == 0)) << 1);
+  const U odd = U(0) - (q & U(1));
+  const U res = (math_bits(s) & ~odd) | (math_bits(c) & odd);
+  const double v = math_from_bits<double>(res ^ ((q & U(2)) << 62));
+  // sin(-0) = -0, sin(+-inf) = nan
+  return math_select((quadrant == 0) & (x == 0.), x,
+                     math_select(ax == std::numeric_limits<double>::infinity(),
+                                 std::numeric_limits<double>::quiet_NaN(), v));
+}
+
+// in double, where the reduction is good for a much larger range than a
+// float one would be
+GT_FORCE_INLINE float math_sin_impl(float x, unsigned quadrant)
+{
+  return float(math_sin_impl(double(x), quadrant));
+}
+
+// Newton iteration for 1 / sqrt(x) from the usual bit-level first guess,
+// then one correction of sqrt(x) = x / sqrt(x) itself. Subnormals are
+// scaled into the normal range by an even power of two.
+template <typename T>
+GT_FORCE_INLINE T math_sqrt_impl(T x)
+{
+  using F = math_float<T>;
+  const bool sub = std::isless(x, T(F::min_normal));
+  const T y = math_select(sub, x * T(F::scale), x);
+
+  T r = math_from_bits<T>(F::rsqrt_magic - (math_bits(y) >> 1));
+  for (int i = 0; i < F::rsqrt_steps; i++) {
+    r = r * (T(1.5) - T(.5) * y * r * r);
+  }
+  T s = y * r;
+  s = s + T(.5) * r * (y - s * s);
+  s = math_select(sub, s * T(F::sqrt_unscale), s);
+
+  // +-0 came through as is
+  s = math_select(x == std::numeric_limits<T>::infinity(), x, s);
+  return math_select(std::isless(x, T(0)), std::numeric_limits<T>::quiet_NaN(),
+                     s);
+}
+
+// atan(t), |t| <= tan(pi / 8), Cephes' rational and polynomial fits
+GT_FORCE_INLINE double math_atan_poly(double t)
+{
+  const double z = t * t;
+  const double p =
+    math_horner(z, -6.485021904942025371773E1, -1.228866684490136173410E2,
+                -7.500855792314704667340E1, -1.615753718733365076637E1,
+                -8.750608600031904122785E-1);
+  const double q =
+    math_horner(z, 1.945506571482613964425E2, 4.853903996359136964868E2,
+                4.328810604912902668951E2, 1.650270098316988542046E2,
+                2.485846490142306297962E1, 1.);
+  return t + t * z * p / q;
+}
+
+GT_FORCE_INLINE float math_atan_poly(float t)
+{
+  const float z = t * t;
+  return t + t * z *
+               math_horner(z, -3.33329491539E-1, 1.99777106478E-1,
+                           -1.38776856032E-1, 8.05374449538E-2);
+}
+
+// atan2(y, x), from atan of min(|x|, |y|) / max(|x|, |y|) in [0, 1]
+template <typename T>
+GT_FORCE_INLINE T math_atan2_impl(T y, T x)
+{
+  const T pio4 = T(0.785398163397448309616);
+  const T pio2 = T(1.57079632679489661923);
+  const T pi = T(3.14159265358979323846);
+
+  const T ax = std::abs(x), ay = std::abs(y);
+  const bool xbig = std::isgreater(ax, ay);
+  const T mx = math_select(xbig, ax, ay);
+  const T mn = math_select(xbig, ay, ax);
+  T t = math_select(mx == mn, T(1), mn / mx);
+  t = math_select(mx == T(0), T(0), t);
+
+  const bool upper = std::isgreater(t, T(0.414213562373095048802));
+  T a = math_atan_poly(math_select(upper, (t - T(1)) / (t + T(1)), t));
+  a = math_select(upper, a + pio4, a);
+  a = math_select(std::isgreater(ay, ax), pio2 - a, a);
+  a = math_select(math_signbit(x), pi - a, a);
+  a = math_select(math_signbit(y), -a, a);
+  return math_select(std::isunordered(x, y), x + y, a);
+}
+
+// sinh and cosh of a real x, sinh by its Taylor series near 0, where
+// (e^x - e^-x) / 2 cancels
+template <typename T>
+GT_FORCE_INLINE void math_sinhcosh(T x, T& sh, T& ch)
+{
+  const T ex = math_exp_impl(x);
+  const T emx = T(1) / ex;
+  ch = T(.5) * (ex + emx);
+  const T z = x * x;
+  const T small =
+    x + x * z *
+          math_horner(z, 1. / 6, 1. / 120, 1. / 5040, 1. / 362880,
+                      1. / 39916800, 1. / 6227020800., 1. / 1307674368000.,
+                      1. / 355687428096000.);
+  sh = math_select(std::isless(std::abs(x), T(1)), small, T(.5) * (ex - emx));
+}
+
+// |z| without intermediate overflow or underflow
+template <typename T>
+GT_FORCE_INLINE T math_hypot(T a, T b)
+{
+  const T inf = std::numeric_limits<T>::infinity();
+  const T aa = std::abs(a), ab = std::abs(b);
+  const bool abig = std::isgreater(aa, ab);
+  const T mx = math_select(abig, aa, ab);
+  const T mn = math_select(abig, ab, aa);
+  const T t = math_select(mx == T(0), T(0), mn / mx);
+  const T r = mx * math_sqrt_impl(T(1) + t * t);
+  return math_select((aa == inf) | (ab == inf), inf, r);
+}
+
+// whether a real y is an integer, and an odd one. Adding and subtracting
+// 2^mant rounds |y| < 2^mant to an integer; everything larger is one
+// already.
+template <typename T>
+GT_FORCE_INLINE void math_parity(T y, bool& is_int, bool& odd)
+{
+  using F = math_float<T>;
+  const T two_mant = T(math_uint<T>(1) << F::mant);
+  const T ay = std::abs(y);
+  const T hy = T(.5) * ay;
+  is_int = std::isgreaterequal(ay, two_mant) |
+           ((ay + two_mant) - two_mant == ay);
+  odd = is_int & std::isless(ay, T(2) * two_mant) &
+        ((hy + two_mant) - two_mant != hy);
+}
+
+// ----------------------------------------------------------------------
+// the kernels by value type: generic, real, complex
+
+template <typename T>
+GT_FORCE_INLINE auto math_exp(const T& x)
+{
+  using std::exp;
+  return exp(x);
+}
+
+#if GTENSOR_MATH_DOUBLE_KERNELS
+GT_FORCE_INLINE double math_exp(double x) { return math_exp_impl(x); }
+#endif
+GT_FORCE_INLINE float math_exp(float x) { return math_exp_impl(x); }
+
+template <typename T>
+GT_FORCE_INLINE auto math_log(const T& x)
+{
+  using std::log;
+  return log(x);
+}
+
+#if GTENSOR_MATH_DOUBLE_KERNELS
+GT_FORCE_INLINE double math_log(double x) { return math_log_impl(x); }
+#endif
+GT_FORCE_INLINE float math_log(float x) { return math_log_impl(x); }
+
+template <typename T>
+GT_FORCE_INLINE auto math_sqrt(const T& x)
+{
+  using std::sqrt;
+  return sqrt(x);
+}
+
+#if GTENSOR_MATH_DOUBLE_KERNELS
+GT_FORCE_INLINE double math_sqrt(double x) { return math_sqrt_impl(x); }
+#endif
+GT_FORCE_INLINE float math_sqrt(float x) { return math_sqrt_impl(x); }
+
+template <typename T>
+GT_FORCE_INLINE auto math_sin(const T& x)
+{
+  using std::sin;
+  return sin(x);
+}
+
+#if GTENSOR_MATH_DOUBLE_KERNELS
+GT_FORCE_INLINE double math_sin(double x) { return math_sin_impl(x, 0); }
+#endif
+GT_FORCE_INLINE float math_sin(float x) { return math_sin_impl(x, 0); }
+
+template <typename T>
+GT_FORCE_INLINE auto math_cos(const T& x)
+{
+  using std::cos;
+  return cos(x);
+}
+
+#if GTENSOR_MATH_DOUBLE_KERNELS
+GT_FORCE_INLINE double math_cos(double x) { return math_sin_impl(x, 1); }
+#endif
+GT_FORCE_INLINE float math_cos(float x) { return math_sin_impl(x, 1); }
+
+template <typename T>
+GT_FORCE_INLINE auto math_abs(const T& x)
+{
+  using std::abs;
+  return abs(x);
+}
+
+template <typename T, typename U>
+GT_FORCE_INLINE auto math_pow(const T& x, const U& y)
+{
+  using std::pow;
+  return pow(x, y);
+}
+
+#if GTENSOR_MATH_DOUBLE_KERNELS
+GT_FORCE_INLINE double math_pow(double x, double y)
+{
+  bool is_int, odd;
+  math_parity(y, is_int, odd);
+  const double ax = std::abs(x);
+  const double inf = std::numeric_limits<double>::infinity();
+  // y log(|x|) as t + t_lo, since an error in it of d ulp makes one of
+  // about d |y log(x)| ulp in the result
+  double lx, lx_lo, t, t_lo;
+  math_log_dd(ax, lx, lx_lo);
+  lx = math_select(ax == inf, inf, lx);
+  lx = math_select(ax == 0., -inf, lx);
+  lx = math_select(std::isnan(ax), ax, lx);
+  math_two_prod(y, lx, t, t_lo);
+  // no correction where the result over- or underflows anyway, or is nan
+  t_lo = math_select(std::isless(std::abs(t), 1e3), t_lo + y * lx_lo, 0.);
+  double r = math_exp_impl(t);
+  r = math_select(r == inf, r, r + r * t_lo);
+  r = math_select(math_signbit(x) & odd, -r, r);
+  r = math_select(std::isless(x, 0.) & (ax != inf) & !is_int,
+                  std::numeric_limits<double>::quiet_NaN(), r);
+  // 1, even if the other argument is nan, and (-1)^+-inf = 1
+  const bool one = (y == 0.) | (x == 1.) | ((ax == 1.) & (std::abs(y) == inf));
+  return math_select(one, 1., r);
+}
+#endif
+
+// in double, which makes it exact up to the final rounding
+GT_FORCE_INLINE float math_pow(float x, float y)
+{
+  return float(math_pow(double(x), double(y)));
+}
+
+template <typename T>
+GT_FORCE_INLINE auto math_conj(const T& x)
+{
+  return x;
+}
+
+template <typename T>
+GT_FORCE_INLINE auto math_real(const T& x)
+{
+  return x;
+}
+
+template <typename T>
+GT_FORCE_INLINE auto math_imag(const T&)
+{
+  return T(0);
+}
+
+template <typename R>
+GT_FORCE_INLINE complex<R> math_conj(const complex<R>& z)
+{
+  return complex<R>(z.real(), -z.imag());
+}
+
+template <typename R>
+GT_FORCE_INLINE R math_real(const complex<R>& z)
+{
+  return z.real();
+}
+
+template <typename R>
+GT_FORCE_INLINE R math_imag(const complex<R>& z)
+{
+  return z.imag();
+}
+
+// complex<float> and complex<double>; other complex types take the generic
+// overloads above
+template <typename R>
+using math_if_float =
+  std::enable_if_t<std::is_same<R, float>::value ||
+                   std::is_same<R, double>::value>;
+
+template <typename R, typename Enable = math_if_float<R>>
+GT_FORCE_INLINE R math_abs(const complex<R>& z)
+{
+  return math_hypot(z.real(), z.imag());
+}
+
+template <typename R, typename Enable = math_if_float<R>>
+GT_FORCE_INLINE complex<R> math_exp(const complex<R>& z)
+{
+  const R e = math_exp_impl(z.real());
+  const R c = math_sin_impl(z.imag(), 1), s = math_sin_impl(z.imag(), 0);
+  // exp(+-inf + 0i) without inf * 0
+  return complex<R>(e * c, math_select(z.imag() == R(0), z.imag(), e * s));
+}
+
+template <typename R, typename Enable = math_if_float<R>>
+GT_FORCE_INLINE complex<R> math_log(const complex<R>& z)
+{
+  return complex<R>(math_log_impl(math_hypot(z.real(), z.imag())),
+                    math_atan2_impl(z.imag(), z.real()));
+}
+
+// the principal root, from t = sqrt((|z| + |a|) / 2), which doesn't cancel,
+// and b / (2 t)
+template <typename R, typename Enable = math_if_float<R>>
+GT_FORCE_INLINE complex<R> math_sqrt(const complex<R>& z)
+{
+  const R a = z.real(), b = z.imag();
+  const R t = math_sqrt_impl(R(.5) * (math_hypot(a, b) + std::abs(a)));
+  const R u = math_select(t == R(0), R(0), R(.5) * b / t);
+  const bool right = std::isgreaterequal(a, R(0));
+  const R tb = math_select(math_signbit(b), -t, t);
+  return complex<R>(math_select(right, t, std::abs(u)),
+                    math_select(right, u, tb));
+}
+
+template <typename R, typename Enable = math_if_float<R>>
+GT_FORCE_INLINE complex<R> math_sin(const complex<R>& z)
+{
+  R sh, ch;
+  math_sinhcosh(z.imag(), sh, ch);
+  return complex<R>(math_sin_impl(z.real(), 0) * ch,
+                    math_sin_impl(z.real(), 1) * sh);
+}
+
+template <typename R, typename Enable = math_if_float<R>>
+GT_FORCE_INLINE complex<R> math_cos(const complex<R>& z)
+{
+  R sh, ch;
+  math_sinhcosh(z.imag(), sh, ch);
+  return complex<R>(math_sin_impl(z.real(), 1) * ch,
+                    -math_sin_impl(z.real(), 0) * sh);
+}
+
+// exp(w log(z)), with z^0 = 1 and 0^w = 0 otherwise
+template <typename R, typename Enable = math_if_float<R>>
+GT_FORCE_INLINE complex<R> math_pow(const complex<R>& z,
+                                    const complex<R>& w)
+{
+  const complex<R> l = math_log(z);
+  const R re = w.real() * l.real() - w.imag() * l.imag();
+  const R im = w.real() * l.imag() + w.imag() * l.real();
+  const complex<R> r = math_exp(complex<R>(re, im));
+  const bool zero = (z.real() == R(0)) & (z.imag() == R(0));
+  const bool wzero = (w.real() == R(0)) & (w.imag() == R(0));
+  return complex<R>(
+    math_select(wzero, R(1), math_select(zero, R(0), r.real())),
+    math_select(wzero | zero, R(0), r.imag()));
+}
+
+// the common type of pow's arguments, complex if either is
+template <typename T>
+struct math_real_type
+{
+  using type = T;
+};
+
+template <typename R>
+struct math_real_type<complex<R>>
+{
+  using type = R;
+};
+
+template <typename T, typename U>
+struct math_promote
+{
+  using type = std::common_type_t<T, U>;
+};
+
+template <typename R, typename U>
+struct math_promote<complex<R>, U>
+{
+  using type =
+    complex<std::common_type_t<R, typename math_real_type<U>::type>>;
+};
+
+template <typename T, typename R>
+struct math_promote<T, complex<R>>
+{
+  using type = complex<std::common_type_t<T, R>>;
+};
+
+template <typename R, typename S>
+struct math_promote<complex<R>, complex<S>>
+{
+  using type = complex<std::common_type_t<R, S>>;
+};
+
+// ----------------------------------------------------------------------
+// integer powers and polynomials
+
+// x^k = x^p * x^(k - p), where x^(k - p) is on the way to x^p already, so
+// that it's the same expression, which the compiler evaluates only once.
+// Up to 64, p is k's parent in Knuth's power tree, which takes the least
+// possible number of multiplications; beyond, it's binary powering.
+constexpr int math_pow_parent(int k)
+{
+  constexpr int tree[] = {
+    0,  0,  1,  2,  2,  3,  3,  5,  4,  6,  5,  10, 6,  10, 7,  10, 8,
+    16, 9,  14, 10, 14, 11, 13, 12, 15, 13, 18, 14, 28, 15, 28, 16, 17,
+    17, 21, 18, 36, 19, 26, 20, 40, 21, 40, 22, 30, 23, 42, 24, 48, 25,
+    48, 26, 52, 27, 44, 28, 38, 29, 31, 30, 56, 31, 42, 32};
+  return k <= 64 ? tree[k] : k % 2 == 0 ? k / 2 : k - 1;
+}
+
+template <int K>
+struct math_ipow
+{
+  template <typename T>
+  GT_FORCE_INLINE static T eval(T x)
+  {
+    constexpr int p = math_pow_parent(K);
+    return math_ipow<p>::eval(x) * math_ipow<K - p>::eval(x);
+  }
+};
+
+template <>
+struct math_ipow<1>
+{
+  template <typename T>
+  GT_FORCE_INLINE static T eval(T x)
+  {
+    return x;
+  }
+};
+
+template <int K, typename T>
+GT_FORCE_INLINE T math_pow_int(T x)
+{
+  return K == 0 ? T(1)
+                : K > 0 ? math_ipow<(K > 0 ? K : 1)>::eval(x)
+                        : T(1) / math_ipow<(K < 0 ? -K : 1)>::eval(x);
+}
+
+// c[0] x^(N-1) + ... + c[N-1], highest power first, as np.polyval.
+// Estrin's scheme splits the polynomial into halves, lo + x^m hi, that
+// can be evaluated independently, rather than Horner's single chain of
+// dependent multiply-adds.
+// the largest power of two below n
+constexpr std::size_t math_estrin_split(std::size_t n)
+{
+  std::size_t m = 1;
+  while (2 * m < n) {
+    m *= 2;
+  }
+  return m;
+}
+
+template <std::size_t Lo, std::size_t N>
+struct math_estrin
+{
+  template <typename T, typename C, std::size_t M>
+  GT_FORCE_INLINE static T eval(T x, const sarray<C, M>& c)
+  {
+    constexpr std::size_t m = math_estrin_split(N);
+    const T lo = math_estrin<Lo, m>::eval(x, c);
+    const T hi = math_estrin<Lo + m, N - m>::eval(x, c);
+    return lo + math_ipow<int(m)>::eval(x) * hi;
+  }
+};
+
+template <std::size_t Lo>
+struct math_estrin<Lo, 1>
+{
+  template <typename T, typename C, std::size_t M>
+  GT_FORCE_INLINE static T eval(T, const sarray<C, M>& c)
+  {
+    return T(c[M - 1 - Lo]);
+  }
+};
+
+template <std::size_t Lo>
+struct math_estrin<Lo, 2>
+{
+  template <typename T, typename C, std::size_t M>
+  GT_FORCE_INLINE static T eval(T x, const sarray<C, M>& c)
+  {
+    return T(c[M - 1 - Lo]) + x * T(c[M - 2 - Lo]);
+  }
+};
+
+template <typename T, typename C, std::size_t N>
+GT_FORCE_INLINE T math_polyval(T x, const sarray<C, N>& c)
+{
+  static_assert(N > 0, "polyval needs at least one coefficient");
+  if (N <= 4) {
+    T r = T(c[0]);
+    for (std::size_t i = 1; i < N; i++) {
+      r = r * x + T(c[i]);
+    }
+    return r;
+  }
+  return math_estrin<0, N>::eval(x, c);
+}
+
+} // namespace detail
+
+// ----------------------------------------------------------------------
+// ops and the expression functions
+
+#define MAKE_MATH_UNARY_FUNC(NAME)                                             \
+  namespace ops                                                                \
+  {                                                                            \
+                                                                               \
+  struct NAME                                                                  \
+  {                                                                            \
+    template <typename T>                                                      \
+    GT_FORCE_INLINE auto operator()(T a) const                                 \
+    {                                                                          \
+      return detail::math_##NAME(a);                                           \
+    }                                                                          \
+  };                                                                           \
+                                                                               \
+  } /* namespace ops */                                                        \
+                                                                               \
+  template <typename E,                                                        \
+            typename Enable = std::enable_if_t<has_expression<E>::value>>      \
+  auto NAME(E&& e)                                                             \
+  {                                                                            \
+    return function(ops::NAME{}, std::forward<E>(e));                          \
+  }
+
+MAKE_MATH_UNARY_FUNC(exp)
+MAKE_MATH_UNARY_FUNC(log)
+MAKE_MATH_UNARY_FUNC(sqrt)
+MAKE_MATH_UNARY_FUNC(sin)
+MAKE_MATH_UNARY_FUNC(cos)
+MAKE_MATH_UNARY_FUNC(abs)
+MAKE_MATH_UNARY_FUNC(conj)
+MAKE_MATH_UNARY_FUNC(real)
+MAKE_MATH_UNARY_FUNC(imag)
+
+#undef MAKE_MATH_UNARY_FUNC
+
+namespace ops
+{
+
+struct pow
+{
+  template <typename T, typename U>
+  GT_FORCE_INLINE auto operator()(T a, U b) const
+  {
+    using V = typename detail::math_promote<T, U>::type;
+    return detail::math_pow(V(a), V(b));
+  }
+};
+
+} // namespace ops
+
+template <typename E1, typename E2,
+          typename Enable = std::enable_if_t<has_expression<E1, E2>::value>>
+auto pow(E1&& e1, E2&& e2)
+{
+  return function(ops::pow{}, std::forward<E1>(e1), std::forward<E2>(e2));
+}
+
+// pow<K>(e): e^K for a compile-time K, by multiplications only, which is
+// exact for integers and, unlike pow(e, K), fine for negative bases
+
+namespace ops
+{
+
+template <int K>
+struct ipow
+{
+  template <typename T>
+  GT_FORCE_INLINE auto operator()(T a) const
+  {
+    return detail::math_pow_int<K>(a);
+  }
+};
+
+} // namespace ops
+
+template <int K, typename E,
+          typename Enable = std::enable_if_t<has_expression<E>::value>>
+auto pow(E&& e)
+{
+  return function(ops::ipow<K>{}, std::forward<E>(e));
+}
+
+// polyval(c, e): c[0] e^(N-1) + c[1] e^(N-2) + ... + c[N-1], in the common
+// type of coefficients and e. The coefficients are held by value, so
+// polyval({1., -2., .5}, x) works as well as passing an sarray.
+
+namespace ops
+{
+
+template <typename C, std::size_t N>
+struct polyval
+{
+  template <typename T>
+  GT_FORCE_INLINE auto operator()(T a) const
+  {
+    using V = typename detail::math_promote<T, C>::type;
+    return detail::math_polyval(V(a), c);
+  }
+
+  sarray<C, N> c;
+};
+
+} // namespace ops
+
+template <typename C, std::size_t N, typename E,
+          typename Enable = std::enable_if_t<has_expression<E>::value>>
+auto polyval(const sarray<C, N>& c, E&& e)
+{
+  return function(ops::polyval<C, N>{c}, std::forward<E>(e));
+}
+
+template <typename C, std::size_t N, typename E,
+          typename Enable = std::enable_if_t<has_expression<E>::value>>
+auto polyval(const C (&c)[N], E&& e)
+{
+  return polyval(sarray<C, N>(c, N), std::forward<E>(e));
+}
+
+} // namespace gt
+
+#endif
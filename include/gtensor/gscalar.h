@@ -4,6 +4,7 @@
 
 #include "expression.h"
 #include "sarray.h"
+#include "stepper.h"
 
 namespace gt
 {
@@ -23,7 +24,7 @@ public:
   shape_type shape() const { return {}; }
 
   template <typename... Args>
-  GT_INLINE value_type operator()(Args... args) const
+  GT_INLINE value_type operator()(Args...) const
   {
     return value_;
   }
@@ -33,6 +34,12 @@ public:
     return gscalar<value_type>(value_type(value_));
   }
 
+  template <typename S>
+  detail::scalar_stepper<value_type> stepper(const S&) const
+  {
+    return {value_};
+  }
+
 private:
   T value_; // FIXME? would be much less fragile to never store reference
 };
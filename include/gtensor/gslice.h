@@ -10,6 +10,9 @@ namespace gt
 struct gnewaxis
 {};
 
+struct gall
+{};
+
 struct gnone
 {};
 
@@ -30,6 +33,7 @@ struct gslice
   gslice(gnone, int stop, gnone) : stop(stop) {}
   gslice(gnone, gnone, int step) : step(step) {}
   gslice(gnone, gnone, gnone) {}
+  gslice(gall) {}
 
   int start = none;
   int stop = none;
@@ -78,6 +82,7 @@ public:
     NEWAXIS,
   };
 
+  gdesc(gall) : type_(ALL) {}
   gdesc(gnewaxis) : type_(NEWAXIS) {}
   gdesc(int value) : type_(VALUE), value_(value) {}
   gdesc(const gslice& slice) : type_(SLICE), slice_(slice) {}
@@ -117,9 +122,9 @@ inline gslice slice(T1 start, T2 stop, T3 step)
   return gslice(start, stop, step);
 }
 
-inline gslice all()
+inline gall all()
 {
-  return gslice(gnone{}, gnone{}, gnone{});
+  return gall{};
 }
 
 inline gnewaxis newaxis()
@@ -144,7 +149,7 @@ inline std::ostream& operator<<(std::ostream& os, const gdesc& desc)
 
 namespace placeholders
 {
-constexpr gslice _all;
+constexpr gall _all;
 constexpr gnewaxis _newaxis;
 
 template <typename... Ts>
@@ -0,0 +1,304 @@
+
+#ifndef GTENSOR_GSTENCIL_H
+#define GTENSOR_GSTENCIL_H
+
+#include "defs.h"
+#include "expression.h"
+#include "sarray.h"
+#include "stepper.h"
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace gt
+{
+
+// ======================================================================
+// stencil_stepper
+//
+// Traverses a stencil applied to a strided expression: rather than one
+// stepper per point of the stencil, there is a single position, and the
+// points are read at fixed offsets from it. Neighbouring outputs along the
+// contiguous axis read overlapping windows from the same cache lines, and
+// since the loop body is just K loads at constant offsets and K
+// multiply-adds, the innermost loop vectorizes for any stencil axis.
+// Dimensions where the stencil has extent 1 are broadcast, so the position
+// doesn't move along them.
+
+namespace detail
+{
+
+template <typename E, typename T, size_type K, typename S>
+class stencil_stepper
+{
+public:
+  using value_type =
+    decltype(std::declval<T>() * std::declval<E&>().data_access(0));
+
+  template <typename Sh1, typename Sh>
+  stencil_stepper(E& e, const sarray<T, K>& coeffs, int axis,
+                  const Sh1& stencil_shape, const Sh& shape)
+    : e_(&e), coeffs_(coeffs)
+  {
+    const auto& strides = e.strides();
+    for (int k = 0; k < int(K); k++) {
+      offsets_[k] = k * strides[axis];
+    }
+    for (int d = 0; d < int(S::size()); d++) {
+      strides_[d] = stencil_shape[d] == 1 ? 0 : strides[d];
+      backstrides_[d] = strides_[d] * shape[d];
+    }
+  }
+
+  value_type operator*() const
+  {
+    value_type val = coeffs_[0] * e_->data_access(offset_);
+    for (int k = 1; k < int(K); k++) {
+      val += coeffs_[k] * e_->data_access(offset_ + offsets_[k]);
+    }
+    return val;
+  }
+
+  template <size_type D>
+  void step()
+  {
+    offset_ += get<D>(strides_);
+  }
+
+  template <size_type D>
+  void advance(int n)
+  {
+    offset_ += n * get<D>(strides_);
+  }
+
+  template <size_type D>
+  void reset()
+  {
+    offset_ -= backstrides_[D];
+  }
+
+private:
+  E* e_;
+  sarray<T, K> coeffs_;
+  size_type offset_ = 0;
+  // not S, which may be fixed at compile time, since broadcast dimensions
+  // get a stride of 0
+  sarray<int, S::size()> strides_;
+  sarray<int, S::size()> backstrides_;
+  sarray<size_type, K> offsets_;
+};
+
+template <typename E, typename T, size_type K, typename Sh1, typename Sh>
+inline auto make_stencil_stepper(E& e, const sarray<T, K>& coeffs, int axis,
+                                 const Sh1& stencil_shape, const Sh& shape)
+  -> stencil_stepper<E, T, K, std::decay_t<decltype(e.strides())>>
+{
+  return {e, coeffs, axis, stencil_shape, shape};
+}
+
+} // namespace detail
+
+// ======================================================================
+// gstencil
+//
+// The stencil with coefficients c[0..K) along `axis` applied to e:
+//
+//   s(..., i, ...) = sum_k c[k] * e(..., i + k, ...)
+//
+// It's defined where all points are inside e, so its shape is that of e,
+// with K - 1 fewer points along the axis.
+
+template <typename E, typename T, size_type K>
+class gstencil;
+
+template <typename E, typename T, size_type K>
+struct owns_operand_storage<gstencil<E, T, K>> : owned_storage<E>
+{};
+
+template <typename E, typename T, size_type K>
+struct gtensor_inner_types<gstencil<E, T, K>>
+{
+  using space_type = expr_space_type<E>;
+  constexpr static size_type dimension = expr_dimension<E>();
+
+  using value_type =
+    decltype(std::declval<T>() * std::declval<expr_value_type<E>>());
+  using reference = value_type;
+  using const_reference = value_type;
+};
+
+template <typename E, typename T, size_type K>
+class gstencil : public expression<gstencil<E, T, K>>
+{
+public:
+  static_assert(K > 0, "gstencil: need at least one point");
+
+  using self_type = gstencil<E, T, K>;
+  using base_type = expression<self_type>;
+  using inner_types = gtensor_inner_types<self_type>;
+  using space_type = typename inner_types::space_type;
+  using value_type = typename inner_types::value_type;
+  using reference = typename inner_types::reference;
+  using const_reference = typename inner_types::const_reference;
+
+  constexpr static size_type dimension() { return inner_types::dimension; };
+
+  using shape_type = gt::shape_type<dimension()>;
+  using coeffs_type = sarray<T, K>;
+
+  gstencil(E&& e, const coeffs_type& coeffs, int axis);
+
+  GT_INLINE const shape_type& shape() const;
+  GT_INLINE int shape(int i) const;
+
+  const coeffs_type& coeffs() const { return coeffs_; }
+  int axis() const { return axis_; }
+
+  // the expression the stencil is applied to
+  const std::decay_t<E>& adapted() const { return e_; }
+
+  template <typename... Args>
+  GT_INLINE value_type operator()(Args... args) const;
+
+  gstencil<to_kernel_t<E>, T, K> to_kernel() const;
+
+#if GTENSOR_BOUNDSCHECK_LEVEL < 2
+  // only available if e is strided, and not at bounds checking level 2,
+  // where every access goes through operator() to be checked
+  template <typename S>
+  auto stepper(const S& shape) const
+    -> decltype(detail::make_stencil_stepper(
+      std::declval<const std::decay_t<E>&>(),
+      std::declval<const coeffs_type&>(), 0, std::declval<shape_type>(),
+      shape));
+#endif
+
+private:
+  using index_type = sarray<int, dimension()>;
+
+  template <size_type... I>
+  GT_INLINE value_type access(std::index_sequence<I...>,
+                              const index_type& idx) const;
+
+  E e_;
+  coeffs_type coeffs_;
+  int axis_;
+  shape_type shape_;
+};
+
+// ----------------------------------------------------------------------
+// gstencil implementation
+
+template <typename E, typename T, size_type K>
+inline gstencil<E, T, K>::gstencil(E&& e, const coeffs_type& coeffs, int axis)
+  : e_(std::forward<E>(e)), coeffs_(coeffs), axis_(axis), shape_(e_.shape())
+{
+  if (axis < 0 || axis >= int(dimension())) {
+    throw std::runtime_error("stencil: axis out of range");
+  }
+  if (shape_[axis] < int(K)) {
+    throw std::runtime_error("stencil: expression too short along axis");
+  }
+  shape_[axis] -= K - 1;
+}
+
+template <typename E, typename T, size_type K>
+inline auto gstencil<E, T, K>::shape() const -> const shape_type&
+{
+  return shape_;
+}
+
+template <typename E, typename T, size_type K>
+inline int gstencil<E, T, K>::shape(int i) const
+{
+  return shape_[i];
+}
+
+template <typename E, typename T, size_type K>
+template <typename... Args>
+inline auto gstencil<E, T, K>::operator()(Args... args) const -> value_type
+{
+  index_type idx(args...);
+  // broadcast along dimensions of extent 1
+  for (int d = 0; d < int(dimension()); d++) {
+    if (shape_[d] == 1) {
+      idx[d] = 0;
+    }
+  }
+  auto seq = std::make_index_sequence<dimension()>();
+  value_type val = coeffs_[0] * access(seq, idx);
+  for (int k = 1; k < int(K); k++) {
+    idx[axis_]++;
+    val += coeffs_[k] * access(seq, idx);
+  }
+  return val;
+}
+
+GT_NV_EXEC_CHECK_DISABLE
+template <typename E, typename T, size_type K>
+template <size_type... I>
+inline auto gstencil<E, T, K>::access(std::index_sequence<I...>,
+                                      const index_type& idx) const
+  -> value_type
+{
+  return e_(idx[I]...);
+}
+
+template <typename E, typename T, size_type K>
+inline gstencil<to_kernel_t<E>, T, K> gstencil<E, T, K>::to_kernel() const
+{
+  return gstencil<to_kernel_t<E>, T, K>(e_.to_kernel(), coeffs_, axis_);
+}
+
+#if GTENSOR_BOUNDSCHECK_LEVEL < 2
+
+template <typename E, typename T, size_type K>
+template <typename S>
+inline auto gstencil<E, T, K>::stepper(const S& shape) const
+  -> decltype(detail::make_stencil_stepper(
+    std::declval<const std::decay_t<E>&>(),
+    std::declval<const coeffs_type&>(), 0, std::declval<shape_type>(), shape))
+{
+  const std::decay_t<E>& e = e_;
+  return detail::make_stencil_stepper(e, coeffs_, axis_, shape_, shape);
+}
+
+#endif
+
+// ======================================================================
+// stencil
+//
+// gt::stencil(e, coeffs, axis) applies the stencil with the given
+// coefficients along `axis` (default 0), e.g., for a centered 2nd order
+// first derivative along y,
+//
+//   dfdy = gt::stencil(f, gt::sarray<double, 3>(-.5, 0., .5), 1) / dy;
+//
+// The number of points is fixed at compile time; coefficients may also be
+// given by a 1-d array of that size, as in gt::stencil<3>(f, c, 1).
+
+template <typename E, typename T, size_type K>
+inline auto stencil(E&& e, const sarray<T, K>& coeffs, int axis = 0)
+{
+  return gstencil<E, T, K>(std::forward<E>(e), coeffs, axis);
+}
+
+template <size_type K, typename E, typename C>
+inline auto stencil(E&& e, const C& coeffs, int axis = 0)
+{
+  using T = std::decay_t<expr_value_type<C>>;
+  if (coeffs.shape(0) != int(K)) {
+    throw std::runtime_error("stencil: expected " + std::to_string(K) +
+                             " coefficients");
+  }
+  sarray<T, K> c;
+  for (int k = 0; k < int(K); k++) {
+    c[k] = coeffs(k);
+  }
+  return gstencil<E, T, K>(std::forward<E>(e), c, axis);
+}
+
+} // namespace gt
+
+#endif
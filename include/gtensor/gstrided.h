@@ -5,6 +5,7 @@
 #include "defs.h"
 #include "expression.h"
 #include "gslice.h"
+#include "stepper.h"
 #include "strides.h"
 
 namespace gt
@@ -24,6 +25,28 @@ auto view(E&& e, Args&&... args);
 template <typename D>
 struct gtensor_inner_types;
 
+// ======================================================================
+// inner_shape_type
+//
+// shape type as given by gtensor_inner_types, defaults to shape_type<N>
+
+namespace detail
+{
+
+template <typename IT, typename Enable = void>
+struct inner_shape_type
+{
+  using type = gt::shape_type<IT::dimension>;
+};
+
+template <typename IT>
+struct inner_shape_type<IT, void_t<typename IT::shape_type>>
+{
+  using type = typename IT::shape_type;
+};
+
+} // namespace detail
+
 // ======================================================================
 // gstrided
 
@@ -42,8 +65,8 @@ public:
 
   constexpr static size_type dimension() { return inner_types::dimension; }
 
-  using shape_type = gt::shape_type<dimension()>;
-  using strides_type = gt::shape_type<dimension()>;
+  using shape_type = typename detail::inner_shape_type<inner_types>::type;
+  using strides_type = strides_t<shape_type>;
 
   using base_type::derived;
 
@@ -70,6 +93,25 @@ public:
   GT_INLINE const_reference data_access(size_type i) const;
   GT_INLINE reference data_access(size_type i);
 
+  // in-place compound assignment, defined in gfunction.h
+  template <typename E>
+  D& operator+=(const expression<E>& e);
+  template <typename E>
+  D& operator-=(const expression<E>& e);
+  template <typename E>
+  D& operator*=(const expression<E>& e);
+  template <typename E>
+  D& operator/=(const expression<E>& e);
+  D& operator+=(value_type val);
+  D& operator-=(value_type val);
+  D& operator*=(value_type val);
+  D& operator/=(value_type val);
+
+  template <typename S>
+  auto stepper(const S& shape) const;
+  template <typename S>
+  auto stepper(const S& shape);
+
 protected:
   template <typename... Args>
   GT_INLINE size_type index(Args&&... args) const;
@@ -159,6 +201,31 @@ inline auto gstrided<D>::data_access(size_type i) -> reference
   return derived().data_access_impl(i);
 }
 
+// At bounds checking level 2, traversal goes by multi-d index instead, so
+// that every access is checked by index()
+
+template <typename D>
+template <typename S>
+inline auto gstrided<D>::stepper(const S& shape) const
+{
+#if GTENSOR_BOUNDSCHECK_LEVEL >= 2
+  return detail::index_stepper<const D, S::size()>(derived(), shape);
+#else
+  return detail::strided_stepper<const D, strides_type>(derived(), shape);
+#endif
+}
+
+template <typename D>
+template <typename S>
+inline auto gstrided<D>::stepper(const S& shape)
+{
+#if GTENSOR_BOUNDSCHECK_LEVEL >= 2
+  return detail::index_stepper<D, S::size()>(derived(), shape);
+#else
+  return detail::strided_stepper<D, strides_type>(derived(), shape);
+#endif
+}
+
 template <typename D>
 template <typename... Args>
 inline size_type gstrided<D>::index(Args&&... args) const
@@ -6,7 +6,10 @@
 #include "thrust_ext.h"
 #endif
 
+#include "assign_all.h"
+#include "fusion.h"
 #include "gfunction.h"
+#include "gstencil.h"
 #include "gtensor_view.h"
 #include "gview.h"
 
@@ -16,14 +19,17 @@ namespace gt
 // ======================================================================
 // gtensor
 
-template <typename T, int N, typename S>
+template <typename T, int N, typename S, typename X>
 class gtensor;
 
-template <typename T, int N, typename S>
-struct gtensor_inner_types<gtensor<T, N, S>>
+template <typename T, int N, typename S, typename X>
+struct gtensor_inner_types<gtensor<T, N, S, X>>
 {
+  static_assert(X::size() == N, "shape type does not match dimension");
+
   using space_type = S;
   constexpr static size_type dimension = N;
+  using shape_type = X;
 
   using storage_type = typename space_type::template Vector<T>;
   using value_type = typename storage_type::value_type;
@@ -33,11 +39,12 @@ struct gtensor_inner_types<gtensor<T, N, S>>
   using const_reference = typename storage_type::const_reference;
 };
 
-template <typename T, int N, typename S = space::host>
-class gtensor : public gcontainer<gtensor<T, N, S>>
+template <typename T, int N, typename S = space::host,
+          typename X = typename detail::default_shape_type<N>::type>
+class gtensor : public gcontainer<gtensor<T, N, S, X>>
 {
 public:
-  using self_type = gtensor<T, N, S>;
+  using self_type = gtensor<T, N, S, X>;
   using base_type = gcontainer<self_type>;
   using inner_types = gtensor_inner_types<self_type>;
   using storage_type = typename inner_types::storage_type;
@@ -61,8 +68,8 @@ public:
 
   using base_type::operator=;
 
-  gtensor_view<T, N, S> to_kernel() const; // FIXME, const T
-  gtensor_view<T, N, S> to_kernel();
+  gtensor_view<T, N, S, X> to_kernel() const; // FIXME, const T
+  gtensor_view<T, N, S, X> to_kernel();
 
 private:
   GT_INLINE const storage_type& storage_impl() const;
@@ -79,13 +86,13 @@ private:
 // ======================================================================
 // gtensor implementation
 
-template <typename T, int N, typename S>
-inline gtensor<T, N, S>::gtensor(const shape_type& shape)
+template <typename T, int N, typename S, typename X>
+inline gtensor<T, N, S, X>::gtensor(const shape_type& shape)
   : base_type(shape, calc_strides(shape)), storage_(calc_size(shape))
 {}
 
-template <typename T, int N, typename S>
-inline gtensor<T, N, S>::gtensor(helper::nd_initializer_list_t<T, N> il)
+template <typename T, int N, typename S, typename X>
+inline gtensor<T, N, S, X>::gtensor(helper::nd_initializer_list_t<T, N> il)
   : base_type({}, {})
 {
   // FIXME?! this kinda changes row-major list into transposed col-major array
@@ -94,52 +101,57 @@ inline gtensor<T, N, S>::gtensor(helper::nd_initializer_list_t<T, N> il)
   helper::nd_initializer_list_copy<N>(il, (*this));
 }
 
-template <typename T, int N, typename S>
+template <typename T, int N, typename S, typename X>
 template <typename E>
-inline gtensor<T, N, S>::gtensor(const expression<E>& e)
+inline gtensor<T, N, S, X>::gtensor(const expression<E>& e)
 {
+  using space_type = space_t<S, expr_space_type<E>>;
   this->resize(e.derived().shape());
-  *this = e.derived();
+  // a new array is computed right away, even inside a fusion_scope, since it
+  // is not known to outlive the scope
+  detail::deferred_assign<space_type>::flush();
+  detail::assign_now(*this, e.derived());
 }
 
-template <typename T, int N, typename S>
-inline auto gtensor<T, N, S>::storage_impl() const -> const storage_type&
+template <typename T, int N, typename S, typename X>
+inline auto gtensor<T, N, S, X>::storage_impl() const -> const storage_type&
 {
   return storage_;
 }
 
-template <typename T, int N, typename S>
-inline auto gtensor<T, N, S>::storage_impl() -> storage_type&
+template <typename T, int N, typename S, typename X>
+inline auto gtensor<T, N, S, X>::storage_impl() -> storage_type&
 {
   return storage_;
 }
 
-#pragma nv_exec_check_disable
-template <typename T, int N, typename S>
-inline auto gtensor<T, N, S>::data_access_impl(size_t i) const
+GT_NV_EXEC_CHECK_DISABLE
+template <typename T, int N, typename S, typename X>
+inline auto gtensor<T, N, S, X>::data_access_impl(size_t i) const
   -> const_reference
 {
   return storage_[i];
 }
 
-#pragma nv_exec_check_disable
-template <typename T, int N, typename S>
-inline auto gtensor<T, N, S>::data_access_impl(size_t i) -> reference
+GT_NV_EXEC_CHECK_DISABLE
+template <typename T, int N, typename S, typename X>
+inline auto gtensor<T, N, S, X>::data_access_impl(size_t i) -> reference
 {
   return storage_[i];
 }
 
-template <typename T, int N, typename S>
-inline gtensor_view<T, N, S> gtensor<T, N, S>::to_kernel() const
+template <typename T, int N, typename S, typename X>
+inline gtensor_view<T, N, S, X> gtensor<T, N, S, X>::to_kernel() const
 {
-  return gtensor_view<T, N, S>(const_cast<gtensor<T, N, S>*>(this)->data(),
-                               this->shape(), this->strides());
+  return gtensor_view<T, N, S, X>(const_cast<gtensor*>(this)->data(),
+                                  this->shape(), this->strides());
 }
 
-template <typename T, int N, typename S>
-inline gtensor_view<T, N, S> gtensor<T, N, S>::to_kernel()
+template <typename T, int N, typename S, typename X>
+inline gtensor_view<T, N, S, X> gtensor<T, N, S, X>::to_kernel()
 {
-  return gtensor_view<T, N, S>(this->data(), this->shape(), this->strides());
+  return gtensor_view<T, N, S, X>(this->data(), this->shape(),
+                                  this->strides());
 }
 
 #if GTENSOR_HAVE_DEVICE
@@ -444,6 +456,57 @@ eval(E&& e)
   return {std::forward<E>(e)};
 }
 
+// ======================================================================
+// stored_data
+//
+// For library code that reads the elements of an expression from memory
+// (gemm, fft, einsum): e is read in place if it is stored as T, like
+// gtensors and their strided views, otherwise it is evaluated into tmp.
+// strides are set to go with the data returned.
+
+namespace detail
+{
+
+template <typename T, typename E, typename Enable = void>
+struct is_stored_as : std::false_type
+{};
+
+template <typename T, typename E>
+struct is_stored_as<T, E, void_t<decltype(std::declval<E&>().strides())>>
+  : std::integral_constant<
+      bool,
+      std::is_lvalue_reference<
+        decltype(std::declval<E&>().data_access(0))>::value &&
+        std::is_same<std::decay_t<decltype(std::declval<E&>().data_access(0))>,
+                     T>::value>
+{};
+
+template <typename T, int N, typename E, typename S>
+inline const T* stored_data(const E& e, gtensor<T, N>&, S& strides,
+                            std::true_type)
+{
+  strides = e.strides();
+  return &e.data_access(0);
+}
+
+template <typename T, int N, typename E, typename S>
+inline const T* stored_data(const E& e, gtensor<T, N>& tmp, S& strides,
+                            std::false_type)
+{
+  // constructed, which assigns right away even inside a fusion_scope
+  tmp = gtensor<T, N>(e);
+  strides = tmp.strides();
+  return tmp.data();
+}
+
+template <typename T, int N, typename E, typename S>
+inline const T* stored_data(const E& e, gtensor<T, N>& tmp, S& strides)
+{
+  return stored_data(e, tmp, strides, is_stored_as<T, E>{});
+}
+
+} // namespace detail
+
 } // namespace gt
 
 #endif
@@ -10,14 +10,18 @@ namespace gt
 // ======================================================================
 // gtensor_view
 
-template <typename T, int N, typename S = space::host>
+template <typename T, int N, typename S = space::host,
+          typename X = typename detail::default_shape_type<N>::type>
 class gtensor_view;
 
-template <typename T, int N, typename S>
-struct gtensor_inner_types<gtensor_view<T, N, S>>
+template <typename T, int N, typename S, typename X>
+struct gtensor_inner_types<gtensor_view<T, N, S, X>>
 {
+  static_assert(X::size() == N, "shape type does not match dimension");
+
   using space_type = S;
   constexpr static size_type dimension = N;
+  using shape_type = X;
 
   using storage_type = typename space_type::template Span<T>;
   using value_type = typename storage_type::value_type;
@@ -27,11 +31,11 @@ struct gtensor_inner_types<gtensor_view<T, N, S>>
   using const_reference = typename storage_type::const_reference;
 };
 
-template <typename T, int N, typename S>
-class gtensor_view : public gstrided<gtensor_view<T, N, S>>
+template <typename T, int N, typename S, typename X>
+class gtensor_view : public gstrided<gtensor_view<T, N, S, X>>
 {
 public:
-  using self_type = gtensor_view<T, N, S>;
+  using self_type = gtensor_view<T, N, S, X>;
   using base_type = gstrided<self_type>;
   using inner_types = gtensor_inner_types<self_type>;
   using storage_type = typename inner_types::storage_type;
@@ -72,11 +76,11 @@ private:
 // ======================================================================
 // gtensor_view implementation
 
-template <typename T, int N, typename S>
-inline gtensor_view<T, N, S>::gtensor_view(pointer data,
+template <typename T, int N, typename S, typename X>
+inline gtensor_view<T, N, S, X>::gtensor_view(pointer data,
                                            const shape_type& shape,
                                            const strides_type& strides)
-  : base_type(shape, strides), storage_(data, calc_size(shape))
+  : base_type(shape, strides), storage_(data, calc_extent(shape, strides))
 {
 #ifndef NDEBUG
 #ifdef __CUDACC__
@@ -97,42 +101,42 @@ inline gtensor_view<T, N, S>::gtensor_view(pointer data,
 #endif
 }
 
-template <typename T, int N, typename S>
+template <typename T, int N, typename S, typename X>
 template <typename E>
-inline auto gtensor_view<T, N, S>::operator=(const expression<E>& e)
+inline auto gtensor_view<T, N, S, X>::operator=(const expression<E>& e)
   -> self_type&
 {
   assign(*this, e.derived());
   return *this;
 }
 
-template <typename T, int N, typename S>
-inline auto gtensor_view<T, N, S>::to_kernel() const -> gtensor_view
+template <typename T, int N, typename S, typename X>
+inline auto gtensor_view<T, N, S, X>::to_kernel() const -> gtensor_view
 {
   return *this;
 }
 
-template <typename T, int N, typename S>
-inline auto gtensor_view<T, N, S>::data() const -> const_pointer
+template <typename T, int N, typename S, typename X>
+inline auto gtensor_view<T, N, S, X>::data() const -> const_pointer
 {
   return storage_.data();
 }
 
-template <typename T, int N, typename S>
-inline auto gtensor_view<T, N, S>::data() -> pointer
+template <typename T, int N, typename S, typename X>
+inline auto gtensor_view<T, N, S, X>::data() -> pointer
 {
   return storage_.data();
 }
 
-template <typename T, int N, typename S>
-inline auto gtensor_view<T, N, S>::data_access_impl(size_t i) const
+template <typename T, int N, typename S, typename X>
+inline auto gtensor_view<T, N, S, X>::data_access_impl(size_t i) const
   -> const_reference
 {
   return storage_[i];
 }
 
-template <typename T, int N, typename S>
-inline auto gtensor_view<T, N, S>::data_access_impl(size_t i) -> reference
+template <typename T, int N, typename S, typename X>
+inline auto gtensor_view<T, N, S, X>::data_access_impl(size_t i) -> reference
 {
   return storage_[i];
 }
@@ -28,6 +28,26 @@ struct disjunction<B1, Bn...>
   : std::conditional_t<bool(B1::value), B1, disjunction<Bn...>>
 {};
 
+// ======================================================================
+// conjunction
+
+template <class...>
+struct conjunction : std::true_type
+{};
+template <class B1>
+struct conjunction<B1> : B1
+{};
+template <class B1, class... Bn>
+struct conjunction<B1, Bn...>
+  : std::conditional_t<bool(B1::value), conjunction<Bn...>, B1>
+{};
+
+// ======================================================================
+// void_t
+
+template <typename... Ts>
+using void_t = void;
+
 // ======================================================================
 // assert_is_same
 //
@@ -4,6 +4,7 @@
 
 #include "assign.h"
 #include "expression.h"
+#include "fastdiv.h"
 #include "gslice.h"
 
 namespace gt
@@ -21,57 +22,67 @@ class gview_adaptor
 public:
   using space_type = expr_space_type<E>;
   using shape_type = expr_shape_type<E>;
+  using index_type = sarray<int, shape_type::size()>;
 
   using inner_expression_type = std::decay_t<E>;
   using value_type = typename inner_expression_type::value_type;
   using reference = typename inner_expression_type::reference;
   using const_reference = typename inner_expression_type::const_reference;
 
-  gview_adaptor(E&& e) : e_(e), strides_(calc_strides(e.shape())) {}
+  gview_adaptor(E&& e)
+    : e_(e),
+      strides_(calc_strides(e.shape())),
+      div_(make_dividers<shape_type::size()>(strides_))
+  {}
 
   shape_type shape() const { return e_.shape(); }
   shape_type strides() const { return strides_; }
 
   auto to_kernel() const { return e_.to_kernel(); }
 
+  const inner_expression_type& adapted() const { return e_; }
+
   GT_INLINE const_reference data_access(size_type i) const
   {
-    shape_type idx = unravel(i, strides_);
+    auto idx = unravel<index_type>(i, div_);
     return access(std::make_index_sequence<idx.size()>(), idx);
   }
 
   GT_INLINE reference data_access(size_type i)
   {
-    shape_type idx = unravel(i, strides_);
+    auto idx = unravel<index_type>(i, div_);
     return access(std::make_index_sequence<idx.size()>(), idx);
   }
 
 private:
   template <size_type... I>
   GT_INLINE const_reference access(std::index_sequence<I...>,
-                                   const shape_type& idx) const
+                                   const index_type& idx) const
   {
     return e_(idx[I]...);
   }
 
   template <size_type... I>
-  GT_INLINE reference access(std::index_sequence<I...>, const shape_type& idx)
+  GT_INLINE reference access(std::index_sequence<I...>, const index_type& idx)
   {
     return e_(idx[I]...);
   }
 
   E e_;
   shape_type strides_;
+  // dividers for unraveling the 1-d index without integer division
+  sarray<fast_divider, shape_type::size()> div_;
 };
 
 } // namespace detail
 
+template <typename E>
+struct owns_operand_storage<detail::gview_adaptor<E>> : owned_storage<E>
+{};
+
 // ----------------------------------------------------------------------
 // select_gview_adaptor
 
-template <typename... Ts>
-using void_t = void;
-
 namespace detail
 {
 
@@ -98,6 +109,18 @@ using select_gview_adaptor_t = typename detail::select_gview_adaptor<E>::type;
 template <typename EC, int N>
 class gview;
 
+template <typename EC, int N>
+struct owns_operand_storage<gview<EC, N>> : owned_storage<EC>
+{};
+
+template <typename E>
+struct is_gview : std::false_type
+{};
+
+template <typename EC, int N>
+struct is_gview<gview<EC, N>> : std::true_type
+{};
+
 template <typename EC, int N>
 struct gtensor_inner_types<gview<EC, N>>
 {
@@ -115,6 +138,7 @@ class gview : public gstrided<gview<EC, N>>
 {
 public:
   using self_type = gview<EC, N>;
+  using inner_type = EC;
   using base_type = gstrided<self_type>;
   using inner_types = gtensor_inner_types<self_type>;
 
@@ -126,6 +150,10 @@ public:
 
   gview(EC&& e, size_type offset, const shape_type& shape,
         const strides_type& strides);
+  // declared explicitly, since the assignment operators below assign
+  // elements rather than the view itself
+  gview(const gview&) = default;
+  gview(gview&&) = default;
 
   self_type& operator=(const self_type& o);
   template <typename E>
@@ -135,6 +163,12 @@ public:
   // FIXME, const correctness
   gview<to_kernel_t<EC>, N> to_kernel() const;
 
+  // underlying expression and offset into it, used to fold views of views
+  size_type offset() const { return offset_; }
+  const std::remove_reference_t<EC>& inner() const& { return e_; }
+  std::remove_reference_t<EC>& inner() & { return e_; }
+  EC&& inner() && { return std::forward<EC>(e_); }
+
 private:
   GT_INLINE const_reference data_access_impl(size_type i) const;
   GT_INLINE reference data_access_impl(size_type i);
@@ -198,107 +232,223 @@ inline auto gview<EC, N>::operator=(value_type val) -> gview&
 
 // ======================================================================
 // view
+//
+// The view is built up by applying one descriptor after the other, each of
+// which consumes one dimension of the underlying expression and / or adds
+// one dimension to the view. The descriptors passed to view(e, args...) are
+// dispatched by type at compile time, so no descriptor array is built and
+// `_all` / `_newaxis` reduce to copying / setting shape and stride.
 
-template <size_type N, typename E>
-auto view(E&& _e, const std::vector<gdesc>& descs)
+namespace detail
 {
-  using EC = select_gview_adaptor_t<E>;
 
-  EC e(std::forward<E>(_e));
+template <size_type N, typename S, typename ST>
+struct view_builder
+{
+  view_builder(const S& old_shape, const ST& old_strides)
+    : old_shape(old_shape), old_strides(old_strides)
+  {}
 
-  size_type offset = 0;
-  const auto& old_shape = e.shape();
-  const auto& old_strides = e.strides();
-  gt::shape_type<N> shape, strides;
-  int new_i = 0, old_i = 0;
-  for (int i = 0; i < descs.size(); i++) {
-    // std::cout << "slice " << descs[i] << " old_shape " << old_shape[i]
-    //           << " old_stride " << old_strides[i] << "\n";
-    if (descs[i].type() == gdesc::ALL) {
-      shape[new_i] = old_shape[old_i];
-      strides[new_i] = old_strides[old_i];
-      new_i++;
-      old_i++;
-    } else if (descs[i].type() == gdesc::VALUE) {
-      offset += descs[i].value() * old_strides[old_i];
-      old_i++;
-    } else if (descs[i].type() == gdesc::NEWAXIS) {
-      shape[new_i] = 1;
-      strides[new_i] = 0;
-      new_i++;
-    } else if (descs[i].type() == gdesc::SLICE) {
-      auto slice = descs[i].slice();
-      int start = slice.start;
-      int stop = slice.stop;
-      int step = slice.step;
-      if (step == gslice::none) {
-        step = 1;
-      }
-      if (step == 0) {
-        throw std::runtime_error(
-          "view: the step parameter in a slice cannot be zero!");
-      }
-      if (start == gslice::none) {
-        start = step > 0 ? 0 : old_shape[old_i] - 1;
-      } else if (start < 0) {
-        start += old_shape[old_i];
-      }
-      if (stop == gslice::none) {
-        stop = step > 0 ? old_shape[old_i] : -1;
-      } else if (stop == 0 && step == 1) {
-        // FIXME, keep this?, different from numpy, though convenient
-        stop += old_shape[old_i];
-      } else if (stop < 0) {
-        stop += old_shape[old_i];
-      }
-      // std::cout << "slice " << start << ":" << stop << ":" << step << "\n";
-      // FIXME? Could just return 0-size
-      if (step > 0 && start >= stop) {
-        throw std::runtime_error("view: start must be less than stop!");
-      }
-      if (step < 0 && stop >= start) {
-        throw std::runtime_error("view: start must be greater than stop!");
-      }
-      if ((step > 0 && stop > old_shape[old_i]) ||
-          (step < 0 && start > old_shape[old_i])) {
-        throw std::runtime_error("view: cannot exceed underlying shape!");
-      }
-      if (step > 0) {
-        shape[new_i] = (stop - start - 1) / step + 1;
-      } else {
-        shape[new_i] = (start - stop - 1) / (-step) + 1;
-      }
-      strides[new_i] = old_strides[old_i] * step;
-      offset += start * old_strides[old_i];
-      new_i++;
-      old_i++;
-    } else {
-      assert(0);
-    }
-  }
-  // handle rest as if filled with all()
-  while (old_i < old_shape.size()) {
+  void apply(gall)
+  {
     shape[new_i] = old_shape[old_i];
     strides[new_i] = old_strides[old_i];
     new_i++;
     old_i++;
   }
-  // for (int i = 0; i < new_i; i++) {
-  //   std::cout << i << " new shape " << shape[i] << " stride " << strides[i]
-  //   <<
-  //   "\n";
-  // }
-
-  assert(new_i == N);
-  return gview<EC, N>(std::forward<EC>(e), offset, shape, strides);
+
+  void apply(gnewaxis)
+  {
+    shape[new_i] = 1;
+    strides[new_i] = 0;
+    new_i++;
+  }
+
+  void apply(int value)
+  {
+#if GTENSOR_BOUNDSCHECK_LEVEL >= 1
+    if (value < 0 || value >= old_shape[old_i]) {
+      throw std::runtime_error("view: index out of range!");
+    }
+#endif
+    offset += value * old_strides[old_i];
+    old_i++;
+  }
+
+  void apply(const gslice& slice)
+  {
+    int extent = old_shape[old_i];
+    int start = slice.start;
+    int stop = slice.stop;
+    int step = slice.step;
+    if (step == gslice::none) {
+      step = 1;
+    }
+    if (step == 0) {
+      throw std::runtime_error(
+        "view: the step parameter in a slice cannot be zero!");
+    }
+    if (start == gslice::none) {
+      start = step > 0 ? 0 : extent - 1;
+    } else if (start < 0) {
+      start += extent;
+    }
+    if (stop == gslice::none) {
+      stop = step > 0 ? extent : -1;
+    } else if (stop == 0 && step == 1) {
+      // FIXME, keep this?, different from numpy, though convenient
+      stop += extent;
+    } else if (stop < 0) {
+      stop += extent;
+    }
+    // FIXME? Could just return 0-size
+    if (step > 0 && start >= stop) {
+      throw std::runtime_error("view: start must be less than stop!");
+    }
+    if (step < 0 && stop >= start) {
+      throw std::runtime_error("view: start must be greater than stop!");
+    }
+    if ((step > 0 && stop > extent) || (step < 0 && start > extent)) {
+      throw std::runtime_error("view: cannot exceed underlying shape!");
+    }
+#if GTENSOR_BOUNDSCHECK_LEVEL >= 1
+    // all elements of the slice need to be within the underlying shape,
+    // so that accesses through the view need no further checking
+    if (start < 0 || start >= extent || stop < -1) {
+      throw std::runtime_error("view: slice out of range!");
+    }
+#endif
+    if (step > 0) {
+      shape[new_i] = (stop - start - 1) / step + 1;
+    } else {
+      shape[new_i] = (start - stop - 1) / (-step) + 1;
+    }
+    // like calc_strides, use zero stride for extent 1, so that the view can
+    // be broadcast
+    strides[new_i] = shape[new_i] == 1 ? 0 : old_strides[old_i] * step;
+    offset += start * old_strides[old_i];
+    new_i++;
+    old_i++;
+  }
+
+  // runtime-typed descriptor
+  void apply(const gdesc& desc)
+  {
+    switch (desc.type()) {
+      case gdesc::ALL: apply(gall{}); break;
+      case gdesc::NEWAXIS: apply(gnewaxis{}); break;
+      case gdesc::VALUE: apply(desc.value()); break;
+      case gdesc::SLICE: apply(desc.slice()); break;
+    }
+  }
+
+  // handle remaining dimensions as if filled with all()
+  void finish()
+  {
+    while (old_i < int(S::size())) {
+      apply(gall{});
+    }
+    assert(new_i == N);
+  }
+
+  const S& old_shape;
+  const ST& old_strides;
+  size_type offset = 0;
+  gt::shape_type<N> shape, strides;
+  int new_i = 0, old_i = 0;
+};
+
+template <size_type N, typename S, typename ST>
+inline view_builder<N, S, ST> make_view_builder(const S& old_shape,
+                                                const ST& old_strides)
+{
+  return view_builder<N, S, ST>(old_shape, old_strides);
+}
+
+} // namespace detail
+
+namespace detail
+{
+
+// ----------------------------------------------------------------------
+// view_maker
+//
+// creates the gview, after `apply` has applied the descriptors to the
+// view_builder
+
+template <typename E, typename Enable = void>
+struct view_maker
+{
+  template <size_type N, typename F>
+  static auto run(E&& _e, F&& apply)
+  {
+    using EC = select_gview_adaptor_t<E>;
+
+    EC e(std::forward<E>(_e));
+
+    const auto& old_shape = e.shape();
+    const auto& old_strides = e.strides();
+    auto bld = make_view_builder<N>(old_shape, old_strides);
+    apply(bld);
+    bld.finish();
+    return gview<EC, N>(std::forward<EC>(e), bld.offset, bld.shape,
+                        bld.strides);
+  }
+};
+
+// A view of a gview is folded into a single gview of the underlying
+// expression, by combining offsets and using the new strides directly, so
+// that element access doesn't go through a chain of views.
+
+template <typename E>
+struct view_maker<E, std::enable_if_t<is_gview<std::decay_t<E>>::value>>
+{
+  using inner_type = typename std::decay_t<E>::inner_type;
+
+  // the new view refers to the underlying expression if this view is an
+  // lvalue, otherwise it takes it over
+  using EC = std::conditional_t<
+    std::is_lvalue_reference<E>::value,
+    std::conditional_t<
+      std::is_const<std::remove_reference_t<E>>::value,
+      const std::decay_t<inner_type>&,
+      std::conditional_t<std::is_reference<inner_type>::value, inner_type,
+                         inner_type&>>,
+    inner_type>;
+
+  template <size_type N, typename F>
+  static auto run(E&& e, F&& apply)
+  {
+    auto bld = make_view_builder<N>(e.shape(), e.strides());
+    apply(bld);
+    bld.finish();
+    return gview<EC, N>(std::forward<E>(e).inner(), e.offset() + bld.offset,
+                        bld.shape, bld.strides);
+  }
+};
+
+} // namespace detail
+
+template <size_type N, typename E>
+auto view(E&& e, const std::vector<gdesc>& descs)
+{
+  return detail::view_maker<E>::template run<N>(
+    std::forward<E>(e), [&descs](auto& bld) {
+      for (const auto& desc : descs) {
+        bld.apply(desc);
+      }
+    });
 }
 
 template <typename E, typename... Args>
 auto view(E&& e, Args&&... args)
 {
   constexpr std::size_t N = view_dimension<E, Args...>();
-  std::vector<gdesc> descs{std::forward<Args>(args)...};
-  return view<N>(std::forward<E>(e), descs);
+  return detail::view_maker<E>::template run<N>(
+    std::forward<E>(e), [&](auto& bld) {
+      int dummy[] = {(bld.apply(args), 0)..., 0};
+      (void)dummy;
+    });
 }
 
 // ======================================================================
@@ -311,10 +461,10 @@ inline auto reshape(E&& _e, gt::shape_type<N> shape)
 
   EC e(std::forward<E>(_e));
 
-  size_type size_e = e.size();
+  size_type size_e = calc_size(e.shape());
   size_type size = 1;
   int dim_adjust = -1;
-  for (int d = 0; d < N; d++) {
+  for (int d = 0; d < int(N); d++) {
     if (shape[d] == -1) {
       assert(dim_adjust == -1); // can at most have one placeholder
       dim_adjust = d;
@@ -323,13 +473,13 @@ inline auto reshape(E&& _e, gt::shape_type<N> shape)
     }
   }
   if (dim_adjust == -1) {
-    assert(size == e.size());
+    assert(size == size_e);
   } else {
-    assert(e.size() % size == 0);
-    shape[dim_adjust] = e.size() / size;
+    assert(size_e % size == 0);
+    shape[dim_adjust] = size_e / size;
   }
   assert(calc_size(shape) == calc_size(e.shape()));
-  return gview<E, N>(std::forward<EC>(e), 0, shape, calc_strides(shape));
+  return gview<EC, N>(std::forward<EC>(e), 0, shape, calc_strides(shape));
 }
 
 // ======================================================================
@@ -343,10 +493,10 @@ inline auto swapaxes(E&& _e, int axis1, int axis2)
   EC e(std::forward<E>(_e));
 
   constexpr int N = expr_dimension<E>();
-  expr_shape_type<E> shape;
-  expr_shape_type<E> strides;
+  gt::shape_type<N> shape;
+  gt::shape_type<N> strides;
 
-  for (int d = 0; d < shape.size(); d++) {
+  for (int d = 0; d < int(shape.size()); d++) {
     if (d == axis1) {
       shape[d] = e.shape()[axis2];
       strides[d] = e.strides()[axis2];
@@ -368,17 +518,17 @@ inline auto swapaxes(E&& _e, int axis1, int axis2)
 // transpose
 
 template <typename E>
-inline auto transpose(E&& _e, expr_shape_type<E> axes)
+inline auto transpose(E&& _e, gt::shape_type<expr_dimension<E>()> axes)
 {
   using EC = select_gview_adaptor_t<E>;
 
   EC e(std::forward<E>(_e));
 
   constexpr int N = expr_dimension<E>();
-  expr_shape_type<E> shape;
-  expr_shape_type<E> strides;
+  gt::shape_type<N> shape;
+  gt::shape_type<N> strides;
 
-  for (int d = 0; d < shape.size(); d++) {
+  for (int d = 0; d < int(shape.size()); d++) {
     shape[d] = e.shape()[axes[d]];
     strides[d] = e.strides()[axes[d]];
   }
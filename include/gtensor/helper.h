@@ -196,7 +196,7 @@ namespace detail
 {
 template <size_type I, typename F, typename... E>
 inline std::enable_if_t<I == sizeof...(E), size_type> max(
-  F&& f, const std::tuple<E...>& tpl)
+  F&&, const std::tuple<E...>&)
 {
   return 0;
 }
@@ -225,6 +225,68 @@ size_type max(F&& f, const std::tuple<E...>& tpl)
   return detail::max<0, F, E...>(std::forward<F>(f), tpl);
 }
 
+// ======================================================================
+// for_each, for_each_pair, transform
+//
+// apply f to each element of a tuple, to corresponding elements of two
+// tuples, or create a tuple of f(e) for e in the tuple
+
+namespace detail
+{
+
+template <typename TPL, typename F, size_type... I>
+inline void for_each(TPL&& tpl, F&& f, std::index_sequence<I...>)
+{
+  int dummy[] = {(f(std::get<I>(std::forward<TPL>(tpl))), 0)..., 0};
+  (void)dummy;
+}
+
+template <typename TPL1, typename TPL2, typename F, size_type... I>
+inline void for_each_pair(TPL1&& tpl1, TPL2&& tpl2, F&& f,
+                          std::index_sequence<I...>)
+{
+  int dummy[] = {(f(std::get<I>(std::forward<TPL1>(tpl1)),
+                    std::get<I>(std::forward<TPL2>(tpl2))),
+                  0)...,
+                 0};
+  (void)dummy;
+}
+
+template <typename TPL, typename F, size_type... I>
+inline auto transform(TPL&& tpl, F&& f, std::index_sequence<I...>)
+{
+  return std::make_tuple(f(std::get<I>(std::forward<TPL>(tpl)))...);
+}
+
+} // namespace detail
+
+template <typename TPL, typename F>
+inline void for_each(TPL&& tpl, F&& f)
+{
+  detail::for_each(
+    std::forward<TPL>(tpl), std::forward<F>(f),
+    std::make_index_sequence<std::tuple_size<std::decay_t<TPL>>::value>());
+}
+
+template <typename TPL1, typename TPL2, typename F>
+inline void for_each_pair(TPL1&& tpl1, TPL2&& tpl2, F&& f)
+{
+  static_assert(std::tuple_size<std::decay_t<TPL1>>::value ==
+                  std::tuple_size<std::decay_t<TPL2>>::value,
+                "for_each_pair: tuples need to have the same size");
+  detail::for_each_pair(
+    std::forward<TPL1>(tpl1), std::forward<TPL2>(tpl2), std::forward<F>(f),
+    std::make_index_sequence<std::tuple_size<std::decay_t<TPL1>>::value>());
+}
+
+template <typename TPL, typename F>
+inline auto transform(TPL&& tpl, F&& f)
+{
+  return detail::transform(
+    std::forward<TPL>(tpl), std::forward<F>(f),
+    std::make_index_sequence<std::tuple_size<std::decay_t<TPL>>::value>());
+}
+
 } // namespace helper
 } // namespace gt
 
@@ -13,18 +13,68 @@
 
 #define GT_INLINE __host__ __device__
 #define GT_LAMBDA [=] __host__ __device__
+#define GT_FORCE_INLINE __host__ __device__ __forceinline__
 
 #else
 
 #define GT_INLINE inline
 #define GT_LAMBDA []
+#if defined(__GNUC__)
+#define GT_FORCE_INLINE inline __attribute__((always_inline))
+#else
+#define GT_FORCE_INLINE inline
+#endif
 
 #endif
 
-#ifndef NDEBUG
+// GT_FORCE_INLINE is for small elementwise kernels which need to end up
+// inlined into the assignment loop for it to vectorize, where the
+// compiler's inlining heuristics may give up first.
+
+// Bounds checking comes in levels, selected by GTENSOR_BOUNDSCHECK_LEVEL:
+//
+// 0: no checks (default with NDEBUG)
+// 1: shapes and view / slice extents are validated once per assign and view
+//    construction, but element accesses inside the loops are not checked
+//    (default without NDEBUG)
+// 2: additionally, every element access is checked against the shape, which
+//    is very slow. Also selected by defining GT_BOUNDSCHECK.
+
+#ifndef GTENSOR_BOUNDSCHECK_LEVEL
+#if defined(GT_BOUNDSCHECK)
+#define GTENSOR_BOUNDSCHECK_LEVEL 2
+#elif !defined(NDEBUG)
+#define GTENSOR_BOUNDSCHECK_LEVEL 1
+#else
+#define GTENSOR_BOUNDSCHECK_LEVEL 0
+#endif
+#endif
+
+#if GTENSOR_BOUNDSCHECK_LEVEL >= 2 && !defined(GT_BOUNDSCHECK)
 #define GT_BOUNDSCHECK
 #endif
 
+// marks the following loop as not having loop-carried dependencies through
+// memory, i.e., what __restrict__ would say about the pointers involved
+
+#if defined(__clang__)
+#define GT_NOALIAS_LOOP _Pragma("clang loop vectorize(assume_safety)")
+#elif defined(__GNUC__)
+#define GT_NOALIAS_LOOP _Pragma("GCC ivdep")
+#else
+#define GT_NOALIAS_LOOP
+#endif
+
+// keeps nvcc from warning about host functions called from the following
+// __host__ __device__ function template; other compilers would warn about
+// the pragma instead
+
+#ifdef __CUDACC__
+#define GT_NV_EXEC_CHECK_DISABLE _Pragma("nv_exec_check_disable")
+#else
+#define GT_NV_EXEC_CHECK_DISABLE
+#endif
+
 #ifdef __CUDACC__
 
 #define gtLaunchKernel(kernelName, numblocks, numthreads, memperblock, streamId, ...)          \
@@ -0,0 +1,422 @@
+
+// ======================================================================
+// mask.h
+//
+// any, all : reductions of boolean-valued expressions, as built from the
+// elementwise comparisons and logical operators
+//
+// compress, nonzero, masked : selecting the elements where a mask is true
+
+#ifndef GTENSOR_MASK_H
+#define GTENSOR_MASK_H
+
+#include "batched.h"
+#include "defs.h"
+#include "fusion.h"
+#include "gtensor.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace gt
+{
+
+namespace detail
+{
+
+// (about) the elements looked at in one go: between checks whether another
+// thread has found what we're looking for already, and as the unit of work
+// for counting and scattering
+constexpr const size_type MASK_BLOCK = 4096;
+
+// the slabs that the work is split into. The outer dimensions, from dim
+// on, are folded into units of per_unit elements each, with dim as high
+// as keeps those at most MASK_BLOCK, so that even shapes like (n, 1) split
+// into enough slabs for all threads. Slab s is the units [begin(s),
+// end(s)), which are contiguous in col-major order.
+struct mask_slabs
+{
+  template <typename S>
+  mask_slabs(const S& shape)
+  {
+    const size_type total = calc_size(shape);
+    if (total == 0) {
+      return;
+    }
+    dim = int(S::size()) - 1;
+    per_unit = total / shape[dim];
+    while (dim > 0 && per_unit > MASK_BLOCK) {
+      dim--;
+      per_unit /= shape[dim];
+    }
+    n_units = total / per_unit;
+    size = std::max(size_type(1), MASK_BLOCK / per_unit);
+    n = int((n_units + size - 1) / size);
+  }
+
+  size_type begin(int s) const { return size_type(s) * size; }
+  size_type end(int s) const { return std::min(n_units, (s + 1) * size); }
+  size_type work() const { return size * per_unit; }
+
+  int n = 0;
+  int dim = 0;
+  size_type size = 1;
+  size_type n_units = 0;
+  size_type per_unit = 0;
+};
+
+template <typename St, typename S, size_type... I>
+inline void mask_advance(St& s, const S& pos, std::index_sequence<I...>)
+{
+  int dummy[] = {(s.template advance<I>(pos[I]), 0)...};
+  (void)dummy;
+}
+
+template <typename S, typename F, typename... Ss>
+inline void mask_for_each_stepper(const S& shape, const S& pos, F& f,
+                                  Ss... s)
+{
+  int dummy[] = {
+    (mask_advance(s, pos, std::make_index_sequence<S::size()>()), 0)...};
+  (void)dummy;
+  for_each_stepper(shape, f, s...);
+}
+
+// calls f(s...) for each element of slab s of shape, in col-major order,
+// with s... steppers at that element of e... The slab is traversed in runs
+// along slabs.dim, each starting out with steppers of its own.
+template <typename S, typename F, typename... E>
+inline void mask_for_each(const S& shape, const mask_slabs& slabs, int s,
+                          F&& f, E&... e)
+{
+  const int dim = slabs.dim;
+  const size_type r1 = slabs.end(s);
+  for (size_type r = slabs.begin(s); r < r1;) {
+    S pos, run = shape;
+    size_type q = r;
+    for (int d = 0; d < int(S::size()); d++) {
+      pos[d] = 0;
+      if (d >= dim) {
+        pos[d] = int(q % shape[d]);
+        q /= shape[d];
+      }
+      if (d > dim) {
+        run[d] = 1;
+      }
+    }
+    run[dim] = int(std::min(r1 - r, size_type(shape[dim] - pos[dim])));
+    mask_for_each_stepper(run, pos, f, make_stepper(e, run)...);
+    r += run[dim];
+  }
+}
+
+// whether bool(e) == want anywhere. The threads each take a range of
+// slabs, and stop once any of them finds an element. Within a slab,
+// matches are counted rather than or'ed together, which the compiler
+// vectorizes.
+template <typename E>
+inline bool mask_find(const E& e, bool want)
+{
+  const gt::shape_type<expr_dimension<E>()> shape = e.shape();
+  const mask_slabs slabs(shape);
+  std::atomic<bool> found(false);
+  batched_parallel(slabs.n, slabs.work(), 1, [&](int s0, int s1) {
+    for (int s = s0; s < s1 && !found.load(std::memory_order_relaxed); s++) {
+      int hit = 0;
+      mask_for_each(
+        shape, slabs, s, [&](const auto& m) { hit += bool(*m) == want; }, e);
+      if (hit) {
+        found.store(true, std::memory_order_relaxed);
+      }
+    }
+  });
+  return found.load();
+}
+
+// where the elements selected by mask go when packed: those of slab s from
+// offsets[s] on, offsets[slabs.n] being their total
+template <typename M>
+inline std::vector<size_type> mask_offsets(const M& mask,
+                                           const mask_slabs& slabs)
+{
+  const gt::shape_type<expr_dimension<M>()> shape = mask.shape();
+  std::vector<size_type> offsets(slabs.n + 1);
+  batched_parallel(slabs.n, slabs.work(), 1, [&](int s0, int s1) {
+    for (int s = s0; s < s1; s++) {
+      size_type cnt = 0;
+      mask_for_each(
+        shape, slabs, s, [&](const auto& m) { cnt += bool(*m); }, mask);
+      offsets[s + 1] = cnt;
+    }
+  });
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  return offsets;
+}
+
+// calls f(s, pos, l) for all slabs s, in parallel, with pos where the
+// slab's selected elements go and l the linear index of its first element
+template <typename F>
+inline void mask_scatter(const mask_slabs& slabs,
+                         const std::vector<size_type>& offsets, F&& f)
+{
+  batched_parallel(slabs.n, slabs.work(), 1, [&](int s0, int s1) {
+    for (int s = s0; s < s1; s++) {
+      f(s, offsets[s], slabs.begin(s) * slabs.per_unit);
+    }
+  });
+}
+
+template <typename M, typename S>
+inline void check_mask_shape(const M& mask, const S& shape, const char* name)
+{
+  if (mask.shape() != shape) {
+    throw std::runtime_error(std::string(name) +
+                             ": mask shape does not match");
+  }
+}
+
+} // namespace detail
+
+// ======================================================================
+// any, all
+//
+// whether bool(e) is true for any, or all, elements of e, e.g.,
+// any(x < 0.). All threads stop soon after the first hit (for any) or
+// miss (for all). Empty expressions have none and all.
+
+template <typename E>
+inline bool any(const expression<E>& e)
+{
+  static_assert(std::is_same<expr_space_type<E>, space::host>::value,
+                "any: only implemented on the host");
+  detail::deferred_assign<space::host>::flush();
+  return detail::mask_find(e.derived(), true);
+}
+
+template <typename E>
+inline bool all(const expression<E>& e)
+{
+  static_assert(std::is_same<expr_space_type<E>, space::host>::value,
+                "all: only implemented on the host");
+  detail::deferred_assign<space::host>::flush();
+  return !detail::mask_find(e.derived(), false);
+}
+
+// ======================================================================
+// compress, nonzero
+//
+// compress(mask, e): the elements of e where mask is true, packed into a
+// 1-d gtensor in col-major order. nonzero(mask): the indices of those
+// elements, one array per dimension, so that the i-th one is at
+// (idx[0](i), idx[1](i), ...).
+//
+// Both count the selected elements per slab of (about) MASK_BLOCK elements
+// in parallel, sum up the counts to find where each slab's elements go, and
+// then copy them there in parallel.
+
+template <typename M, typename E>
+inline gtensor<expr_value_type<E>, 1> compress(const expression<M>& mask,
+                                               const expression<E>& e)
+{
+  static_assert(std::is_same<expr_space_type<M>, space::host>::value &&
+                  std::is_same<expr_space_type<E>, space::host>::value,
+                "compress: only implemented on the host");
+  static_assert(expr_dimension<M>() == expr_dimension<E>(),
+                "compress: mask and expression differ in dimension");
+  using V = expr_value_type<E>;
+  const auto& m = mask.derived();
+  const auto& ed = e.derived();
+  const gt::shape_type<expr_dimension<E>()> shape = ed.shape();
+  detail::check_mask_shape(m, shape, "compress");
+  detail::deferred_assign<space::host>::flush();
+
+  const detail::mask_slabs slabs(shape);
+  const auto offsets = detail::mask_offsets(m, slabs);
+  gtensor<V, 1> r(gt::shape(int(offsets[slabs.n])));
+  V* p = r.data();
+  detail::mask_scatter(slabs, offsets, [&](int s, size_type pos, size_type) {
+    detail::mask_for_each(
+      shape, slabs, s,
+      [&](const auto& ms, const auto& es) {
+        if (bool(*ms)) {
+          p[pos++] = *es;
+        }
+      },
+      m, ed);
+  });
+  return r;
+}
+
+template <typename M>
+inline std::array<gtensor<int, 1>, expr_dimension<M>()> nonzero(
+  const expression<M>& mask)
+{
+  static_assert(std::is_same<expr_space_type<M>, space::host>::value,
+                "nonzero: only implemented on the host");
+  constexpr size_type N = expr_dimension<M>();
+  const auto& m = mask.derived();
+  const gt::shape_type<N> shape = m.shape();
+  detail::deferred_assign<space::host>::flush();
+
+  const detail::mask_slabs slabs(shape);
+  const auto offsets = detail::mask_offsets(m, slabs);
+  std::array<gtensor<int, 1>, N> idx;
+  std::array<int*, N> p;
+  for (int d = 0; d < int(N); d++) {
+    idx[d] = gtensor<int, 1>(gt::shape(int(offsets[slabs.n])));
+    p[d] = idx[d].data();
+  }
+  const gt::shape_type<N> strides = calc_strides(shape);
+  detail::mask_scatter(slabs, offsets, [&](int s, size_type pos, size_type l) {
+    detail::mask_for_each(
+      shape, slabs, s,
+      [&](const auto& ms) {
+        if (bool(*ms)) {
+          const auto i = unravel(l, strides);
+          for (int d = 0; d < int(N); d++) {
+            p[d][pos] = i[d];
+          }
+          pos++;
+        }
+        l++;
+      },
+      m);
+  });
+  return idx;
+}
+
+// ======================================================================
+// masked
+//
+// masked(lhs, mask) = rhs assigns to the elements of lhs where mask is
+// true, and leaves the others alone. rhs can be
+//
+// - a scalar, or an expression of lhs's shape (or broadcast to it): the
+//   selected elements get the corresponding ones of rhs, as by
+//   lhs = where(mask, rhs, lhs),
+// - a 1-d expression with one element per selected element, as returned by
+//   compress: those are scattered to the selected elements in col-major
+//   order, so that masked(x, m) = compress(m, y) is x = where(m, y, x). The
+//   scatter reads the mask twice, so it must not depend on elements of lhs
+//   other than the one it selects.
+//
+// Masked assignments run right away, also inside a fusion_scope.
+
+template <typename E, typename M>
+class masked_proxy
+{
+public:
+  masked_proxy(E&& e, M&& mask)
+    : e_(std::forward<E>(e)), mask_(std::forward<M>(mask))
+  {
+    detail::check_mask_shape(mask_, e_.shape(), "masked");
+  }
+
+  template <typename E2>
+  masked_proxy& operator=(const expression<E2>& rhs)
+  {
+    assign_from(rhs.derived(),
+                std::integral_constant<bool, expr_dimension<E2>() ==
+                                               expr_dimension<E>()>{});
+    return *this;
+  }
+
+  masked_proxy& operator=(expr_value_type<E> val)
+  {
+    assign_where(val);
+    return *this;
+  }
+
+private:
+  // same dimension, 1-d or not
+  template <typename E2>
+  void assign_from(const E2& rhs, std::true_type)
+  {
+    assign_same(rhs,
+                std::integral_constant<bool, expr_dimension<E>() == 1>{});
+  }
+
+  template <typename E2>
+  void assign_same(const E2& rhs, std::false_type)
+  {
+    assign_where(rhs);
+  }
+
+  // 1-d, which can be either
+  template <typename E2>
+  void assign_same(const E2& rhs, std::true_type)
+  {
+    if (rhs.shape(0) != 1 && rhs.shape(0) != e_.shape(0)) {
+      assign_packed(rhs);
+    } else {
+      assign_where(rhs);
+    }
+  }
+
+  // runs right away, also inside a fusion_scope, where a deferred statement
+  // would refer to a mask held by this proxy after it's gone
+  template <typename R>
+  void assign_where(const R& rhs)
+  {
+    detail::deferred_assign<space::host>::flush();
+    fusion_suspend suspend;
+    gt::assign(e_, where(mask_, rhs, e_));
+  }
+
+  template <typename E2>
+  void assign_from(const E2& rhs, std::false_type)
+  {
+    static_assert(expr_dimension<E2>() == 1,
+                  "masked: rhs must match lhs in dimension, or be 1-d");
+    assign_packed(rhs);
+  }
+
+  template <typename E2>
+  void assign_packed(const E2& rhs)
+  {
+    static_assert(std::is_same<expr_space_type<E>, space::host>::value,
+                  "masked: scattering only implemented on the host");
+    using V = expr_value_type<E>;
+    const gt::shape_type<expr_dimension<E>()> shape = e_.shape();
+    detail::deferred_assign<space::host>::flush();
+
+    const detail::mask_slabs slabs(shape);
+    const auto offsets = detail::mask_offsets(mask_, slabs);
+    if (size_type(rhs.shape(0)) != offsets[slabs.n]) {
+      throw std::runtime_error(
+        "masked: rhs has " + std::to_string(rhs.shape(0)) +
+        " elements for " + std::to_string(offsets[slabs.n]) + " selected");
+    }
+    // evaluated up front, since it may well read lhs
+    const gtensor<V, 1> packed = rhs;
+    const V* p = packed.data();
+    detail::mask_scatter(slabs, offsets, [&](int s, size_type pos, size_type) {
+      detail::mask_for_each(
+        shape, slabs, s,
+        [&](auto& es, const auto& ms) {
+          if (bool(*ms)) {
+            *es = p[pos++];
+          }
+        },
+        e_, mask_);
+    });
+  }
+
+  E e_;
+  M mask_;
+};
+
+template <typename E, typename M>
+inline masked_proxy<E, M> masked(E&& e, M&& mask)
+{
+  return masked_proxy<E, M>(std::forward<E>(e), std::forward<M>(mask));
+}
+
+} // namespace gt
+
+#endif
@@ -0,0 +1,82 @@
+
+// ======================================================================
+// mpi_transport.h
+//
+// mpi_transport : halo exchange for distributed_gtensor between MPI
+// processes, one subdomain each
+
+#ifndef GTENSOR_MPI_TRANSPORT_H
+#define GTENSOR_MPI_TRANSPORT_H
+
+#include "distributed.h"
+
+#include <mpi.h>
+
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace gt
+{
+
+// ======================================================================
+// mpi_transport
+//
+// Each process in `comm` holds the subdomain with its rank, so the
+// communicator needs to have exactly as many processes as there are
+// subdomains. The data is sent as raw bytes with non-blocking
+// point-to-point messages. exchange_halos_async() calls MPI from a
+// different thread than the caller, which needs MPI to be initialized with
+// at least MPI_THREAD_SERIALIZED, and no other MPI calls by the caller
+// until the exchange is done.
+
+class mpi_transport
+{
+public:
+  explicit mpi_transport(MPI_Comm comm = MPI_COMM_WORLD) : comm_(comm) {}
+
+  MPI_Comm comm() const { return comm_; }
+
+  std::vector<int> local_ranks(int n_ranks) const
+  {
+    int rank, size;
+    MPI_Comm_rank(comm_, &rank);
+    MPI_Comm_size(comm_, &size);
+    if (size != n_ranks) {
+      throw std::runtime_error("mpi_transport: " + std::to_string(n_ranks) +
+                               " subdomains, but " + std::to_string(size) +
+                               " processes");
+    }
+    return {rank};
+  }
+
+  template <typename T>
+  void exchange(std::vector<message<T>>& sends,
+                std::vector<message<T>>& recvs) const
+  {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "mpi_transport: T needs to be trivially copyable");
+    std::vector<MPI_Request> requests(recvs.size() + sends.size());
+    auto req = requests.begin();
+    for (auto& r : recvs) {
+      MPI_Irecv(r.data, r.size * sizeof(T), MPI_BYTE, r.from, r.tag, comm_,
+                &*req++);
+    }
+    for (auto& s : sends) {
+      MPI_Isend(s.data, s.size * sizeof(T), MPI_BYTE, s.to, s.tag, comm_,
+                &*req++);
+    }
+    if (MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE) !=
+        MPI_SUCCESS) {
+      throw std::runtime_error("mpi_transport: exchange failed");
+    }
+  }
+
+private:
+  MPI_Comm comm_;
+};
+
+} // namespace gt
+
+#endif
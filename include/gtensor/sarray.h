@@ -9,6 +9,7 @@
 #ifndef GTENSOR_SARRAY_H
 #define GTENSOR_SARRAY_H
 
+#include "gtl.h"
 #include "macros.h"
 
 #include <cassert>
@@ -32,7 +33,10 @@ public:
   sarray() = default;
 
   // construct from exactly N elements provided
-  template <typename... U, std::enable_if_t<sizeof...(U) == N, int> = 0>
+  template <typename... U,
+            std::enable_if_t<sizeof...(U) == N &&
+                               conjunction<std::is_convertible<U, T>...>::value,
+                             int> = 0>
   sarray(U... args);
   sarray(const T* p, std::size_t n);
 
@@ -43,8 +47,8 @@ public:
 
   GT_INLINE constexpr static std::size_t size();
 
-  GT_INLINE const T& operator[](T i) const;
-  GT_INLINE T& operator[](T i);
+  GT_INLINE const T& operator[](std::size_t i) const;
+  GT_INLINE T& operator[](std::size_t i);
 
   GT_INLINE const T* begin() const;
   GT_INLINE const T* end() const;
@@ -62,7 +66,10 @@ inline std::ostream& operator<<(std::ostream& os, const sarray<T, N>& arr);
 // sarray implementation
 
 template <typename T, std::size_t N>
-template <typename... U, std::enable_if_t<sizeof...(U) == N, int>>
+template <typename... U,
+          std::enable_if_t<sizeof...(U) == N &&
+                             conjunction<std::is_convertible<U, T>...>::value,
+                           int>>
 sarray<T, N>::sarray(U... args) : data_{T(args)...}
 {}
 
@@ -97,12 +104,12 @@ GT_INLINE constexpr std::size_t sarray<T, N>::size()
 }
 
 template <typename T, std::size_t N>
-GT_INLINE const T& sarray<T, N>::operator[](T i) const
+GT_INLINE const T& sarray<T, N>::operator[](std::size_t i) const
 {
   return data_[i];
 }
 template <typename T, std::size_t N>
-GT_INLINE T& sarray<T, N>::operator[](T i)
+GT_INLINE T& sarray<T, N>::operator[](std::size_t i)
 {
   return data_[i];
 }
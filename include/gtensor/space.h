@@ -173,6 +173,62 @@ using device = host;
 
 } // namespace space
 
+// ======================================================================
+// space_t
+
+namespace detail
+{
+
+template <typename S, typename T>
+struct space_type_op
+{
+  static_assert(!std::is_same<S, S>::value, "can't mix space types");
+};
+
+template <typename S>
+struct space_type_op<S, S>
+{
+  using type = S;
+};
+
+template <>
+struct space_type_op<space::any, space::any>
+{
+  using type = space::any;
+};
+
+template <typename S>
+struct space_type_op<space::any, S>
+{
+  using type = S;
+};
+
+template <typename S>
+struct space_type_op<S, space::any>
+{
+  using type = S;
+};
+
+template <typename...>
+struct space_type;
+
+template <typename S>
+struct space_type<S>
+{
+  using type = S;
+};
+
+template <typename S, typename... R>
+struct space_type<S, R...>
+{
+  using type = typename space_type_op<S, typename space_type<R...>::type>::type;
+};
+
+} // namespace detail
+
+template <typename... S>
+using space_t = typename detail::space_type<S...>::type;
+
 } // namespace gt
 
 #endif
@@ -35,10 +35,18 @@ public:
 
   GT_INLINE const_reference operator[](size_type i) const
   {
+#ifdef GT_BOUNDSCHECK
     assert(i < size_);
+#endif
+    return data_[i];
+  }
+  GT_INLINE reference operator[](size_type i)
+  {
+#ifdef GT_BOUNDSCHECK
+    assert(i < size_);
+#endif
     return data_[i];
   }
-  GT_INLINE reference operator[](size_type i) { return data_[i]; }
 
 private:
   pointer data_ = nullptr;
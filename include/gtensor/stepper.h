@@ -0,0 +1,365 @@
+
+#ifndef GTENSOR_STEPPER_H
+#define GTENSOR_STEPPER_H
+
+#include "defs.h"
+#include "extents.h"
+#include "gtl.h"
+
+#include <tuple>
+#include <utility>
+
+namespace gt
+{
+
+// ======================================================================
+// steppers
+//
+// Incremental traversal of an expression in col-major order. Rather than
+// calculating the storage index from the full multi-d index for every
+// element, a stepper keeps its current position, which is advanced by
+// step<D>() when index D is incremented and rolled back by reset<D>() after
+// a full sweep over dimension D. For strided expressions, that's one add per
+// operand per element. advance<D>(n) moves n steps at once, for starting a
+// traversal somewhere other than the origin.
+//
+// Expressions provide `stepper(shape)` to create a stepper for traversing
+// the given (broadcast) shape; those that don't are traversed by
+// index_stepper, which keeps the multi-d index and calls operator().
+
+namespace detail
+{
+
+// ----------------------------------------------------------------------
+// strided_stepper
+
+template <typename E, typename S>
+class strided_stepper
+{
+public:
+  using reference = decltype(std::declval<E&>().data_access(0));
+
+  template <typename Sh>
+  strided_stepper(E& e, const Sh& shape) : e_(&e), strides_(e.strides())
+  {
+    for (int d = 0; d < int(S::size()); d++) {
+      backstrides_[d] = strides_[d] * shape[d];
+    }
+  }
+
+  reference operator*() const { return e_->data_access(offset_); }
+
+  template <size_type D>
+  void step()
+  {
+    static_assert(D < S::size(), "strided_stepper: dimension out of range");
+    offset_ += get<D>(strides_);
+  }
+
+  template <size_type D>
+  void advance(int n)
+  {
+    offset_ += n * get<D>(strides_);
+  }
+
+  template <size_type D>
+  void reset()
+  {
+    offset_ -= backstrides_[D];
+  }
+
+private:
+  E* e_;
+  size_type offset_ = 0;
+  S strides_;
+  sarray<int, S::size()> backstrides_;
+};
+
+// ----------------------------------------------------------------------
+// scalar_stepper
+
+template <typename T>
+class scalar_stepper
+{
+public:
+  scalar_stepper(const T& value) : value_(value) {}
+
+  const T& operator*() const { return value_; }
+
+  template <size_type D>
+  void step()
+  {}
+
+  template <size_type D>
+  void advance(int)
+  {}
+
+  template <size_type D>
+  void reset()
+  {}
+
+private:
+  T value_;
+};
+
+// ----------------------------------------------------------------------
+// function_stepper
+
+template <typename F, typename... Ss>
+class function_stepper
+{
+public:
+  function_stepper(const F& f, Ss&&... s) : f_(&f), s_(std::move(s)...) {}
+
+  auto operator*() const
+  {
+    return deref(std::make_index_sequence<sizeof...(Ss)>());
+  }
+
+  template <size_type D>
+  void step()
+  {
+    step<D>(std::make_index_sequence<sizeof...(Ss)>());
+  }
+
+  template <size_type D>
+  void advance(int n)
+  {
+    advance<D>(n, std::make_index_sequence<sizeof...(Ss)>());
+  }
+
+  template <size_type D>
+  void reset()
+  {
+    reset<D>(std::make_index_sequence<sizeof...(Ss)>());
+  }
+
+private:
+  template <size_type... I>
+  auto deref(std::index_sequence<I...>) const
+  {
+    return (*f_)(*std::get<I>(s_)...);
+  }
+
+  template <size_type D, size_type... I>
+  void step(std::index_sequence<I...>)
+  {
+    int dummy[] = {(std::get<I>(s_).template step<D>(), 0)..., 0};
+    (void)dummy;
+  }
+
+  template <size_type D, size_type... I>
+  void advance(int n, std::index_sequence<I...>)
+  {
+    int dummy[] = {(std::get<I>(s_).template advance<D>(n), 0)..., 0};
+    (void)dummy;
+  }
+
+  template <size_type D, size_type... I>
+  void reset(std::index_sequence<I...>)
+  {
+    int dummy[] = {(std::get<I>(s_).template reset<D>(), 0)..., 0};
+    (void)dummy;
+  }
+
+  const F* f_;
+  std::tuple<Ss...> s_;
+};
+
+template <typename F, typename... Ss>
+inline function_stepper<F, Ss...> make_function_stepper(const F& f, Ss&&... s)
+{
+  return function_stepper<F, Ss...>(f, std::forward<Ss>(s)...);
+}
+
+// ----------------------------------------------------------------------
+// index_stepper
+//
+// fallback for expressions that can only be accessed by multi-d index
+
+template <typename E, size_type N>
+class index_stepper
+{
+public:
+  template <typename Sh>
+  index_stepper(E& e, const Sh&) : e_(&e)
+  {}
+
+  decltype(auto) operator*() const
+  {
+    return deref(std::make_index_sequence<N>());
+  }
+
+  template <size_type D>
+  void step()
+  {
+    idx_[D]++;
+  }
+
+  template <size_type D>
+  void advance(int n)
+  {
+    idx_[D] += n;
+  }
+
+  template <size_type D>
+  void reset()
+  {
+    idx_[D] = 0;
+  }
+
+private:
+  template <size_type... I>
+  decltype(auto) deref(std::index_sequence<I...>) const
+  {
+    return (*e_)(idx_[I]...);
+  }
+
+  E* e_;
+  sarray<int, N> idx_ = {};
+};
+
+// ----------------------------------------------------------------------
+// make_stepper
+
+template <typename E, typename S, typename Enable = void>
+struct stepper_maker
+{
+  static auto run(E& e, const S& shape)
+  {
+    return index_stepper<E, S::size()>(e, shape);
+  }
+};
+
+template <typename E, typename S>
+struct stepper_maker<
+  E, S, void_t<decltype(std::declval<E&>().stepper(std::declval<const S&>()))>>
+{
+  static auto run(E& e, const S& shape) { return e.stepper(shape); }
+};
+
+template <typename E, typename S>
+inline auto make_stepper(E& e, const S& shape)
+{
+  return stepper_maker<E, S>::run(e, shape);
+}
+
+// ----------------------------------------------------------------------
+// stepper_loop
+//
+// calls f(s...) for every point in the index space given by shape, advancing
+// all steppers s... in lockstep. With NoAlias, the innermost loop is marked
+// as free of loop-carried dependencies through memory, so the compiler can
+// vectorize it without runtime alias checks.
+
+template <size_type D, bool NoAlias = false>
+struct stepper_loop
+{
+  template <typename S, typename F, typename... Ss>
+  static void run(const S& shape, F& f, Ss&... s)
+  {
+    for (int i = 0; i < get<D - 1>(shape); i++) {
+      stepper_loop<D - 1, NoAlias>::run(shape, f, s...);
+      int dummy[] = {(s.template step<D - 1>(), 0)...};
+      (void)dummy;
+    }
+    int dummy[] = {(s.template reset<D - 1>(), 0)...};
+    (void)dummy;
+  }
+};
+
+template <>
+struct stepper_loop<1, true>
+{
+  template <typename S, typename F, typename... Ss>
+  static void run(const S& shape, F& f, Ss&... s)
+  {
+    const int n = get<0>(shape);
+    GT_NOALIAS_LOOP
+    for (int i = 0; i < n; i++) {
+      f(s...);
+      int dummy[] = {(s.template step<0>(), 0)...};
+      (void)dummy;
+    }
+    int dummy[] = {(s.template reset<0>(), 0)...};
+    (void)dummy;
+  }
+};
+
+template <bool NoAlias>
+struct stepper_loop<0, NoAlias>
+{
+  template <typename S, typename F, typename... Ss>
+  static void run(const S&, F& f, Ss&... s)
+  {
+    f(s...);
+  }
+};
+
+// ----------------------------------------------------------------------
+// reverse_stepper_loop
+//
+// like stepper_loop, but visiting the index space in reverse order, starting
+// from steppers positioned at its last point. Steppers are moved back by
+// advance<D>(-1), and forward again by a full sweep once one is done.
+
+template <size_type D>
+struct reverse_stepper_loop
+{
+  template <typename S, typename F, typename... Ss>
+  static void run(const S& shape, F& f, Ss&... s)
+  {
+    const int n = get<D - 1>(shape);
+    for (int i = 0; i < n; i++) {
+      reverse_stepper_loop<D - 1>::run(shape, f, s...);
+      int dummy[] = {(s.template advance<D - 1>(-1), 0)...};
+      (void)dummy;
+    }
+    int dummy[] = {(s.template advance<D - 1>(n), 0)...};
+    (void)dummy;
+  }
+};
+
+template <>
+struct reverse_stepper_loop<0>
+{
+  template <typename S, typename F, typename... Ss>
+  static void run(const S&, F& f, Ss&... s)
+  {
+    f(s...);
+  }
+};
+
+template <typename S, typename St, size_type... I>
+inline void stepper_to_last(const S& shape, St& s, std::index_sequence<I...>)
+{
+  int dummy[] = {(s.template advance<I>(get<I>(shape) - 1), 0)..., 0};
+  (void)dummy;
+}
+
+template <typename S, typename F, typename... Ss>
+inline void for_each_stepper(const S& shape, F&& f, Ss&... s)
+{
+  stepper_loop<S::size()>::run(shape, f, s...);
+}
+
+template <typename S, typename F, typename... Ss>
+inline void for_each_stepper_reverse(const S& shape, F&& f, Ss&... s)
+{
+  int dummy[] = {
+    (stepper_to_last(shape, s, std::make_index_sequence<S::size()>()), 0)...};
+  (void)dummy;
+  reverse_stepper_loop<S::size()>::run(shape, f, s...);
+}
+
+template <typename S, typename F, typename... Ss>
+inline void for_each_stepper_noalias(const S& shape, F&& f, Ss&... s)
+{
+  stepper_loop<S::size(), true>::run(shape, f, s...);
+}
+
+} // namespace detail
+
+} // namespace gt
+
+#endif
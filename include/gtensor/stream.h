@@ -0,0 +1,259 @@
+
+#ifndef GTENSOR_STREAM_H
+#define GTENSOR_STREAM_H
+
+#include "gtensor.h"
+
+#include <algorithm>
+#include <fstream>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+namespace gt
+{
+
+// ======================================================================
+// file_source
+//
+// read access to a binary file holding a col-major array of the given shape.
+// Data is read one chunk (range of the outermost dimension) at a time, which
+// is a contiguous slab in the file.
+
+template <typename T, int N>
+class file_source
+{
+public:
+  using value_type = T;
+  using shape_type = gt::shape_type<N>;
+
+  constexpr static size_type dimension() { return N; }
+
+  file_source(const std::string& filename, const shape_type& shape);
+
+  const shape_type& shape() const { return shape_; }
+
+  void read(int begin, int end, gtensor<T, N>& chunk);
+
+private:
+  std::ifstream file_;
+  shape_type shape_;
+};
+
+// ======================================================================
+// file_sink
+//
+// write access to a binary file holding a col-major array of the given
+// shape, one chunk at a time
+
+template <typename T, int N>
+class file_sink
+{
+public:
+  using value_type = T;
+  using shape_type = gt::shape_type<N>;
+
+  constexpr static size_type dimension() { return N; }
+
+  file_sink(const std::string& filename, const shape_type& shape);
+
+  const shape_type& shape() const { return shape_; }
+
+  void write(int begin, int end, const gtensor<T, N>& chunk);
+
+private:
+  std::ofstream file_;
+  shape_type shape_;
+};
+
+// ----------------------------------------------------------------------
+// file_source, file_sink implementation
+
+namespace detail
+{
+
+// number of elements in one slice of the outermost dimension
+template <typename S>
+inline size_type slab_size(const S& shape)
+{
+  size_type size = 1;
+  for (int d = 0; d < int(shape.size()) - 1; d++) {
+    size *= shape[d];
+  }
+  return size;
+}
+
+template <typename S>
+inline S chunk_shape(S shape, int begin, int end)
+{
+  shape[shape.size() - 1] = end - begin;
+  return shape;
+}
+
+} // namespace detail
+
+template <typename T, int N>
+inline file_source<T, N>::file_source(const std::string& filename,
+                                      const shape_type& shape)
+  : file_(filename, std::ios::binary), shape_(shape)
+{
+  if (!file_) {
+    throw std::runtime_error("file_source: cannot open " + filename);
+  }
+}
+
+template <typename T, int N>
+inline void file_source<T, N>::read(int begin, int end, gtensor<T, N>& chunk)
+{
+  auto shape = detail::chunk_shape(shape_, begin, end);
+  if (chunk.shape() != shape) {
+    chunk.resize(shape);
+  }
+
+  size_type slab = detail::slab_size(shape_);
+  file_.seekg(begin * slab * sizeof(T));
+  file_.read(reinterpret_cast<char*>(chunk.data()), chunk.size() * sizeof(T));
+  if (!file_) {
+    throw std::runtime_error("file_source: read failed");
+  }
+}
+
+template <typename T, int N>
+inline file_sink<T, N>::file_sink(const std::string& filename,
+                                  const shape_type& shape)
+  : file_(filename, std::ios::binary), shape_(shape)
+{
+  if (!file_) {
+    throw std::runtime_error("file_sink: cannot open " + filename);
+  }
+}
+
+template <typename T, int N>
+inline void file_sink<T, N>::write(int begin, int end,
+                                   const gtensor<T, N>& chunk)
+{
+  if (chunk.shape() != detail::chunk_shape(shape_, begin, end)) {
+    throw std::runtime_error("file_sink: chunk shape " +
+                             to_string(chunk.shape()) +
+                             " does not match sink shape " +
+                             to_string(shape_));
+  }
+
+  size_type slab = detail::slab_size(shape_);
+  file_.seekp(begin * slab * sizeof(T));
+  file_.write(reinterpret_cast<const char*>(chunk.data()),
+              chunk.size() * sizeof(T));
+  if (!file_) {
+    throw std::runtime_error("file_sink: write failed");
+  }
+}
+
+// ======================================================================
+// stream_eval
+//
+// Evaluates an elementwise expression over inputs that are too large to hold
+// in memory. `f` is called with one in-memory chunk per source and returns
+// the expression to evaluate for that chunk, e.g.
+//
+//   gt::stream_eval(sink, 64, [](auto& a, auto& b) { return a + 2. * b; },
+//                   src_a, src_b);
+//
+// Sources provide `shape()` and `read(begin, end, chunk)`, the sink provides
+// `shape()` and `write(begin, end, chunk)`, where [begin, end) is a range of
+// the outermost dimension. While chunk k is computed, chunk k+1 is read and
+// chunk k-1 is written asynchronously, so at most two chunks of each input
+// and of the output are held in memory at any time.
+
+namespace detail
+{
+
+template <typename... Sources, size_type... I>
+inline void stream_read(std::tuple<Sources&...>& sources,
+                        std::tuple<gtensor<expr_value_type<Sources>,
+                                           Sources::dimension()>...>& chunks,
+                        int begin, int end, std::index_sequence<I...>)
+{
+  int dummy[] = {(std::get<I>(sources).read(begin, end, std::get<I>(chunks)),
+                  0)...};
+  (void)dummy;
+}
+
+template <typename F, typename C, size_type... I>
+inline auto stream_apply(F& f, C& chunks, std::index_sequence<I...>)
+{
+  return f(std::get<I>(chunks)...);
+}
+
+} // namespace detail
+
+template <typename Sink, typename F, typename... Sources>
+void stream_eval(Sink& sink, int chunk_size, F&& f, Sources&... _sources)
+{
+  using chunks_type =
+    std::tuple<gtensor<expr_value_type<Sources>, Sources::dimension()>...>;
+  using out_type = gtensor<expr_value_type<Sink>, Sink::dimension()>;
+  using indices = std::make_index_sequence<sizeof...(Sources)>;
+
+  if (chunk_size <= 0) {
+    throw std::runtime_error("stream_eval: chunk_size must be positive");
+  }
+  const int n = sink.shape()[Sink::dimension() - 1];
+  int outer[] = {n, _sources.shape()[Sources::dimension() - 1]...};
+  for (auto n_src : outer) {
+    if (n_src != n) {
+      throw std::runtime_error(
+        "stream_eval: outermost dimension of sources and sink must match");
+    }
+  }
+
+  // the chunks are handed to other threads right after being assigned, so
+  // the assignments must not be deferred by a fusion_scope
+  detail::deferred_assign<space::host>::flush();
+  fusion_suspend suspend;
+
+  std::tuple<Sources&...> sources(_sources...);
+  auto read_chunk = [&sources](chunks_type& chunks, int begin, int end) {
+    detail::stream_read(sources, chunks, begin, end, indices());
+  };
+
+  chunks_type cur, next;
+  out_type out[2];
+  // declared after the buffers, so that they are waited for before the
+  // buffers go away
+  std::future<void> pending_read, pending_write;
+
+  if (n > 0) {
+    read_chunk(cur, 0, std::min(chunk_size, n));
+  }
+  for (int begin = 0, k = 0; begin < n; begin += chunk_size, k++) {
+    int end = std::min(begin + chunk_size, n);
+    if (end < n) {
+      pending_read =
+        std::async(std::launch::async, read_chunk, std::ref(next), end,
+                   std::min(end + chunk_size, n));
+    }
+
+    auto& o = out[k % 2];
+    o = detail::stream_apply(f, cur, indices());
+
+    if (pending_write.valid()) {
+      pending_write.get();
+    }
+    pending_write = std::async(std::launch::async, [&sink, &o, begin, end]() {
+      sink.write(begin, end, o);
+    });
+
+    if (pending_read.valid()) {
+      pending_read.get();
+    }
+    std::swap(cur, next);
+  }
+  if (pending_write.valid()) {
+    pending_write.get();
+  }
+}
+
+} // namespace gt
+
+#endif
@@ -2,6 +2,9 @@
 #ifndef GTENSOR_STRIDES_H
 #define GTENSOR_STRIDES_H
 
+#include "defs.h"
+#include "extents.h"
+
 namespace gt
 {
 
@@ -11,11 +14,11 @@ namespace gt
 // calculates strides corresponding to col-major layout of given shape
 
 template <typename S>
-GT_INLINE S calc_strides(const S& shape)
+GT_INLINE strides_t<S> calc_strides(const S& shape)
 {
-  S strides;
+  sarray<int, S::size()> strides;
   int stride = 1;
-  for (int i = 0; i < shape.size(); i++) {
+  for (int i = 0; i < int(shape.size()); i++) {
     if (shape[i] == 1) {
       strides[i] = 0;
     } else {
@@ -23,7 +26,7 @@ GT_INLINE S calc_strides(const S& shape)
     }
     stride *= shape[i];
   }
-  return strides;
+  return strides_t<S>(strides);
 }
 
 // ======================================================================
@@ -59,7 +62,7 @@ GT_INLINE size_type calc_index(const S&)
 template <size_type dim, typename S, typename Arg, typename... Args>
 GT_INLINE size_type calc_index(const S& strides, Arg arg, Args... args)
 {
-  return strides[dim] * arg + calc_index<dim + 1>(strides, args...);
+  return get<dim>(strides) * arg + calc_index<dim + 1>(strides, args...);
 }
 
 } // namespace detail
@@ -81,6 +84,28 @@ GT_INLINE constexpr size_type calc_size(const S& shape, size_type i = 0)
   return (i < S::size()) ? shape[i] * calc_size(shape, i + 1) : size_type(1);
 }
 
+// ======================================================================
+// calc_extent
+//
+// number of elements of storage spanned by the given shape and strides,
+// going forward from the first element, which is more than calc_size(shape)
+// if they are not contiguous
+
+template <typename S, typename St>
+GT_INLINE size_type calc_extent(const S& shape, const St& strides)
+{
+  size_type extent = 1;
+  for (int d = 0; d < int(S::size()); d++) {
+    if (shape[d] == 0) {
+      return 0;
+    }
+    if (strides[d] > 0) {
+      extent += size_type(shape[d] - 1) * strides[d];
+    }
+  }
+  return extent;
+}
+
 // ======================================================================
 // bounds_check
 //
@@ -96,9 +121,9 @@ GT_INLINE void bounds_check(const S&)
 template <size_type dim, typename S, class Arg, class... Args>
 GT_INLINE void bounds_check(const S& shape, Arg arg, Args... args)
 {
-  if (shape[dim] != 1 && (arg < 0 || arg >= shape[dim])) {
+  if (get<dim>(shape) != 1 && (arg < 0 || arg >= get<dim>(shape))) {
     printf("out-of-bounds error: dim = %d, arg = %d, shape = %d\n", int(dim),
-           int(arg), int(shape[dim]));
+           int(arg), int(get<dim>(shape)));
     assert(0);
   }
   bounds_check<dim + 1>(shape, args...);
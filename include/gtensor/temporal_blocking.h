@@ -0,0 +1,169 @@
+
+// ======================================================================
+// temporal_blocking.h
+//
+// temporal_sweep : repeated stencil updates, several time steps per tile
+
+#ifndef GTENSOR_TEMPORAL_BLOCKING_H
+#define GTENSOR_TEMPORAL_BLOCKING_H
+
+#include "defs.h"
+#include "fusion.h"
+#include "gtensor.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace gt
+{
+
+namespace detail
+{
+
+// cache footprint aimed for by the two tile buffers of temporal_sweep
+constexpr const size_type TEMPORAL_TILE_BYTES = 512 * 1024;
+
+// k plain sweeps over the whole array, for where tiles can't be staged
+// through host buffers
+
+template <typename SP>
+struct temporal_sweeper
+{
+  template <typename T, int N, typename F>
+  static void run(gtensor<T, N, SP>& u, int steps, int radius, F& update,
+                  int block_steps, int tile)
+  {
+    gtensor<T, N, SP> v = u;
+    auto in = u.to_kernel();
+    auto out = v.to_kernel();
+    for (int s = 0; s < steps; s++) {
+      update(out, in);
+      std::swap(in, out);
+    }
+    if (steps % 2 == 1) {
+      u = v;
+    }
+  }
+};
+
+template <>
+struct temporal_sweeper<space::host>
+{
+  template <typename T, int N, typename F>
+  static void run(gtensor<T, N>& u, int steps, int radius, F& update,
+                  int block_steps, int tile)
+  {
+    const auto shape = u.shape();
+    const int n = shape[N - 1];
+    size_type slab = 1;
+    for (int d = 0; d < N - 1; d++) {
+      slab *= shape[d];
+    }
+    if (n == 0 || slab == 0 || steps == 0) {
+      return;
+    }
+
+    const int max_halo = std::min(steps, block_steps) * radius;
+    if (tile == 0) {
+      int slices = TEMPORAL_TILE_BYTES / (2 * slab * sizeof(T));
+      // keep the redundant work on the halo at most about that on the tile
+      tile = std::max({slices - 2 * max_halo, 2 * max_halo, 1});
+    }
+
+    const int min_slices = 2 * radius + 1;
+    auto buf_shape = shape;
+    buf_shape[N - 1] = std::min(n, std::max(tile + 2 * max_halo, min_slices));
+    gtensor<T, N> buf0(buf_shape), buf1(buf_shape);
+    gtensor<T, N> v(shape);
+
+    // the time blocks alternate between u -> v and v -> u
+    T* src = u.data();
+    T* dst = v.data();
+    for (int done = 0; done < steps; done += block_steps) {
+      const int ks = std::min(block_steps, steps - done);
+      const int halo = ks * radius;
+      for (int a = 0; a < n; a += tile) {
+        const int b = std::min(a + tile, n);
+        int lo = std::max(0, a - halo);
+        int hi = std::min(n, b + halo);
+        // at the boundaries, the tile may need more context to have an
+        // interior for update() at all, which is harmless
+        if (hi - lo < min_slices) {
+          hi = std::min(n, lo + min_slices);
+          lo = std::max(0, hi - min_slices);
+        }
+
+        auto tile_shape = shape;
+        tile_shape[N - 1] = hi - lo;
+        auto strides = calc_strides(tile_shape);
+        gtensor_view<T, N> in(buf0.data(), tile_shape, strides);
+        gtensor_view<T, N> out(buf1.data(), tile_shape, strides);
+
+        // both buffers start out with the tile, since update() leaves the
+        // boundary points alone
+        std::copy(src + lo * slab, src + hi * slab, in.data());
+        std::copy(in.data(), in.data() + (hi - lo) * slab, out.data());
+        for (int s = 0; s < ks; s++) {
+          update(out, in);
+          std::swap(in, out);
+        }
+        std::copy(in.data() + (a - lo) * slab, in.data() + (b - lo) * slab,
+                  dst + a * slab);
+      }
+      std::swap(src, dst);
+    }
+    if (src != u.data()) {
+      std::copy(src, src + n * slab, u.data());
+    }
+  }
+};
+
+} // namespace detail
+
+// ======================================================================
+// temporal_sweep
+//
+// Applies `steps` time steps of the stencil update
+//
+//   update(out, in)
+//
+// to u. `update` gets two gtensor_views of the same shape, and sets the
+// points of `out` that are at least `radius` away from the edges (along the
+// last dimension) from the points of `in` within `radius`, using views,
+// expressions or launch_host(). Points it doesn't set must keep their
+// values, like a fixed boundary. For example, for 1-d diffusion,
+//
+//   gt::temporal_sweep(u, 100, 1, [](auto& out, const auto& in) {
+//     out.view(_s(1, -1)) = .25 * in.view(_s(_, -2)) +
+//                           .5 * in.view(_s(1, -1)) + .25 * in.view(_s(2, _));
+//   });
+//
+// The result is identical to `steps` separate sweeps over u. On the host,
+// however, u is split into tiles along the last dimension, and
+// `block_steps` time steps are done per tile while it's in cache: each tile
+// is copied into a buffer together with a halo of block_steps * radius
+// slices on either side, which neighbouring tiles recompute redundantly,
+// and only its own slices are written back. That way, u is streamed from
+// memory once per block_steps time steps rather than once per step. `tile`
+// is the number of slices per tile; by default, it's chosen so that the
+// buffers fit in cache. On the device, the steps are done as plain sweeps.
+
+template <typename T, int N, typename S, typename F>
+void temporal_sweep(gtensor<T, N, S>& u, int steps, int radius, F&& update,
+                    int block_steps = 4, int tile = 0)
+{
+  if (steps < 0 || radius < 0 || block_steps < 1 || tile < 0) {
+    throw std::runtime_error("temporal_sweep: invalid arguments");
+  }
+  // the updates need to see each other's results right away
+  detail::deferred_assign<S>::flush();
+  fusion_suspend suspend;
+
+  detail::temporal_sweeper<S>::run(u, steps, radius, update, block_steps,
+                                   tile);
+}
+
+} // namespace gt
+
+#endif
@@ -0,0 +1,81 @@
+
+#include <gtest/gtest.h>
+
+#include <gtensor/gtensor.h>
+
+#include <tuple>
+
+using namespace gt::placeholders;
+
+TEST(assign_all, two_outputs)
+{
+  gt::gtensor<double, 2> a{{1., 2., 3.}, {4., 5., 6.}};
+  gt::gtensor<double, 2> b{{6., 5., 4.}, {3., 2., 1.}};
+  gt::gtensor<double, 2> sum(a.shape()), diff(a.shape());
+
+  gt::assign_all(std::tie(sum, diff), std::make_tuple(a + b, a - b));
+  EXPECT_EQ(sum, (gt::gtensor<double, 2>{{7., 7., 7.}, {7., 7., 7.}}));
+  EXPECT_EQ(diff, (gt::gtensor<double, 2>{{-5., -3., -1.}, {1., 3., 5.}}));
+}
+
+TEST(assign_all, views_and_broadcast)
+{
+  gt::gtensor<double, 2> a{{1., 2.}, {3., 4.}};
+  gt::gtensor<double, 1> c{10., 20.};
+  gt::gtensor<double, 2> out(gt::shape(2, 4));
+
+  auto lo = out.view(_all, _s(_, 2));
+  auto hi = out.view(_all, _s(2, _));
+  gt::assign_all(std::tie(lo, hi),
+                 std::make_tuple(a * c.view(_all, _newaxis), 2. * a));
+  EXPECT_EQ(out, (gt::gtensor<double, 2>{
+                   {10., 40.}, {30., 80.}, {2., 4.}, {6., 8.}}));
+}
+
+TEST(assign_all, in_place)
+{
+  // outputs read at the same index are evaluated before being overwritten
+  gt::gtensor<double, 1> re{1., 2.};
+  gt::gtensor<double, 1> im{3., 4.};
+
+  gt::assign_all(std::tie(re, im), std::make_tuple(-im, re));
+  EXPECT_EQ(re, (gt::gtensor<double, 1>{-3., -4.}));
+  EXPECT_EQ(im, (gt::gtensor<double, 1>{1., 2.}));
+}
+
+TEST(assign_all, overlap)
+{
+  gt::gtensor<double, 1> a{1., 2., 3., 4.};
+  gt::gtensor<double, 1> b(gt::shape(3));
+
+  auto a_hi = a.view(_s(1, _));
+  gt::assign_all(std::tie(a_hi, b),
+                 std::make_tuple(a.view(_s(_, -1)), a.view(_s(1, _))));
+  EXPECT_EQ(a, (gt::gtensor<double, 1>{1., 1., 2., 3.}));
+  EXPECT_EQ(b, (gt::gtensor<double, 1>{2., 3., 4.}));
+}
+
+TEST(assign_all, shape_mismatch)
+{
+  gt::gtensor<double, 1> a(gt::shape(3)), b(gt::shape(4));
+
+  EXPECT_THROW(gt::assign_all(std::tie(a, b), std::make_tuple(a, b)),
+               std::runtime_error);
+}
+
+#ifdef GTENSOR_HAVE_DEVICE
+
+TEST(assign_all, device)
+{
+  gt::gtensor_device<double, 2> a{{1., 2., 3.}, {4., 5., 6.}};
+  gt::gtensor_device<double, 2> sum(a.shape()), prod(a.shape());
+
+  gt::assign_all(std::tie(sum, prod), std::make_tuple(a + a, a * a));
+
+  EXPECT_EQ(sum,
+            (gt::gtensor_device<double, 2>{{2., 4., 6.}, {8., 10., 12.}}));
+  EXPECT_EQ(prod,
+            (gt::gtensor_device<double, 2>{{1., 4., 9.}, {16., 25., 36.}}));
+}
+
+#endif
@@ -0,0 +1,213 @@
+
+#include <gtest/gtest.h>
+
+#include <gtensor/banded.h>
+#include <gtensor/gtensor.h>
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+// reference: dense Gaussian elimination with partial pivoting of A x = d
+inline std::vector<double> dense_solve(std::vector<std::vector<double>> A,
+                                       std::vector<double> d)
+{
+  const int n = d.size();
+  for (int k = 0; k < n; k++) {
+    int p = k;
+    for (int i = k + 1; i < n; i++) {
+      if (std::abs(A[i][k]) > std::abs(A[p][k])) {
+        p = i;
+      }
+    }
+    std::swap(A[k], A[p]);
+    std::swap(d[k], d[p]);
+    for (int i = k + 1; i < n; i++) {
+      double m = A[i][k] / A[k][k];
+      for (int j = k; j < n; j++) {
+        A[i][j] -= m * A[k][j];
+      }
+      d[i] -= m * d[k];
+    }
+  }
+  for (int i = n - 1; i >= 0; i--) {
+    for (int j = i + 1; j < n; j++) {
+      d[i] -= A[i][j] * d[j];
+    }
+    d[i] /= A[i][i];
+  }
+  return d;
+}
+
+gt::gtensor<double, 3> make_rhs(const gt::shape_type<3>& shape)
+{
+  gt::gtensor<double, 3> d(shape);
+  for (int i = 0; i < int(d.size()); i++) {
+    d.data()[i] = (i * 37 % 23) - 11.;
+  }
+  return d;
+}
+
+// checks x against the dense solution of every system along axis, with
+// A(i, j) = coef(i, j, flat index of the system's first point)
+template <typename F>
+void check_systems(const gt::gtensor<double, 3>& d0,
+                   const gt::gtensor<double, 3>& x, int axis, F&& coef)
+{
+  auto shape = d0.shape();
+  const int n = shape[axis];
+  int idx[3];
+  for (idx[2] = 0; idx[2] < (axis == 2 ? 1 : shape[2]); idx[2]++) {
+    for (idx[1] = 0; idx[1] < (axis == 1 ? 1 : shape[1]); idx[1]++) {
+      for (idx[0] = 0; idx[0] < (axis == 0 ? 1 : shape[0]); idx[0]++) {
+        auto at = [&](int i) {
+          int j[3] = {idx[0], idx[1], idx[2]};
+          j[axis] = i;
+          return j[0] + shape[0] * (j[1] + shape[1] * j[2]);
+        };
+        std::vector<std::vector<double>> A(n, std::vector<double>(n, 0.));
+        std::vector<double> d(n);
+        for (int i = 0; i < n; i++) {
+          d[i] = d0.data()[at(i)];
+          for (int j = 0; j < n; j++) {
+            A[i][j] = coef(i, j, at(i));
+          }
+        }
+        auto ref = dense_solve(A, d);
+        for (int i = 0; i < n; i++) {
+          ASSERT_NEAR(x.data()[at(i)], ref[i], 1e-12) << "axis " << axis;
+        }
+      }
+    }
+  }
+}
+
+TEST(banded, tridiagonal_shared)
+{
+  for (int axis = 0; axis < 3; axis++) {
+    auto shape = gt::shape(5, 6, 7);
+    const int n = shape[axis];
+    gt::gtensor<double, 1> a(gt::shape(n)), b(gt::shape(n)), c(gt::shape(n));
+    for (int i = 0; i < n; i++) {
+      a(i) = -1. - .1 * i;
+      b(i) = 4. + .5 * (i % 3);
+      c(i) = -1.5 + .2 * i;
+    }
+
+    auto d0 = make_rhs(shape);
+    auto x = d0;
+    gt::solve_tridiagonal(a, b, c, x, axis);
+    check_systems(d0, x, axis, [&](int i, int j, int) {
+      return j == i - 1 ? a(i) : j == i ? b(i) : j == i + 1 ? c(i) : 0.;
+    });
+  }
+}
+
+TEST(banded, tridiagonal_per_system)
+{
+  for (int axis = 0; axis < 3; axis++) {
+    auto shape = gt::shape(4, 9, 5);
+    gt::gtensor<double, 3> a(shape), b(shape), c(shape);
+    for (int k = 0; k < int(a.size()); k++) {
+      a.data()[k] = -1. + .01 * (k % 7);
+      b.data()[k] = 3. + .1 * (k % 5);
+      c.data()[k] = -.5 - .02 * (k % 3);
+    }
+
+    auto d0 = make_rhs(shape);
+    auto x = d0;
+    gt::solve_tridiagonal(a, b, c, x, axis);
+    check_systems(d0, x, axis, [&](int i, int j, int k) {
+      return j == i - 1   ? a.data()[k]
+             : j == i     ? b.data()[k]
+             : j == i + 1 ? c.data()[k]
+                          : 0.;
+    });
+  }
+
+  gt::gtensor<double, 3> d(gt::shape(2, 3, 4)), e(gt::shape(2, 3, 5));
+  EXPECT_THROW(gt::solve_tridiagonal(e, e, e, d, 0), std::runtime_error);
+  EXPECT_THROW(gt::solve_tridiagonal(d, d, d, d, 3), std::runtime_error);
+}
+
+TEST(banded, banded)
+{
+  const int kl = 2, ku = 1;
+  for (int axis = 0; axis < 3; axis++) {
+    auto shape = gt::shape(6, 5, 7);
+    const int n = shape[axis];
+    auto A = [](int i, int j) {
+      return i == j ? 6. + .1 * i : (i - j) * .5 + .1 * (i + j) - 1.;
+    };
+    gt::gtensor<double, 2> ab(gt::shape(kl + ku + 1, n));
+    for (int j = 0; j < n; j++) {
+      for (int i = std::max(0, j - ku); i <= std::min(n - 1, j + kl); i++) {
+        ab(ku + i - j, j) = A(i, j);
+      }
+    }
+
+    auto d0 = make_rhs(shape);
+    auto x = d0;
+    gt::solve_banded(ab, kl, ku, x, axis);
+    check_systems(d0, x, axis, [&](int i, int j, int) {
+      return (j - i <= ku && i - j <= kl) ? A(i, j) : 0.;
+    });
+  }
+
+  gt::gtensor<double, 2> ab(gt::shape(3, 4));
+  ab.view() = 1.;
+  ab.view(1, gt::placeholders::_all) = 4.;
+  gt::gtensor<double, 3> d(gt::shape(5, 2, 4));
+  d.view() = 1.;
+  // length mismatch, wrong number of diagonals
+  EXPECT_THROW(gt::solve_banded(ab, 1, 1, d), std::runtime_error);
+  EXPECT_THROW(gt::solve_banded(ab, 2, 1, d, 2), std::runtime_error);
+  // zero pivot
+  gt::solve_banded(ab, 1, 1, d, 2);
+  ab(1, 0) = 0.;
+  EXPECT_THROW(gt::solve_banded(ab, 1, 1, d, 2), std::runtime_error);
+}
+
+TEST(banded, many_systems)
+{
+  // more systems than fit in one block, along axis 0 and 2
+  gt::gtensor<double, 1> a(gt::shape(8)), b(gt::shape(8)), c(gt::shape(8));
+  for (int i = 0; i < 8; i++) {
+    a(i) = -1.;
+    b(i) = 2.5;
+    c(i) = -1.;
+  }
+  for (int axis : {0, 2}) {
+    auto shape = axis == 0 ? gt::shape(8, 30, 40) : gt::shape(30, 40, 8);
+    auto d0 = make_rhs(shape);
+    auto x = d0;
+    gt::solve_tridiagonal(a, b, c, x, axis);
+    check_systems(d0, x, axis, [&](int i, int j, int) {
+      return j == i ? 2.5 : (j == i - 1 || j == i + 1) ? -1. : 0.;
+    });
+  }
+}
+
+TEST(banded, fusion_scope)
+{
+  // pending updates of the coefficients are seen by the solvers
+  gt::gtensor<double, 1> a(gt::shape(4)), b(gt::shape(4)), c(gt::shape(4));
+  gt::gtensor<double, 1> d(gt::shape(4));
+  a.view() = 0.;
+  b.view() = 1.;
+  c.view() = 0.;
+  d.view() = 1.;
+  gt::gtensor<double, 2> ab(gt::shape(1, 4));
+  ab.view() = 1.;
+  gt::gtensor<double, 1> e = d;
+
+  {
+    gt::fusion_scope fs;
+    b = b + 1.;
+    gt::solve_tridiagonal(a, b, c, d);
+    ab = 4. * ab;
+    gt::solve_banded(ab, 0, 0, e);
+  }
+  EXPECT_EQ(d, (gt::gtensor<double, 1>{.5, .5, .5, .5}));
+  EXPECT_EQ(e, (gt::gtensor<double, 1>{.25, .25, .25, .25}));
+}
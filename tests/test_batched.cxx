@@ -0,0 +1,140 @@
+
+#include <gtest/gtest.h>
+
+#include <gtensor/batched.h>
+#include <gtensor/gtensor.h>
+
+#include <stdexcept>
+
+using gt::batch_layout;
+
+// entry (i, j) of matrix b, well-conditioned for square ones, where every
+// third matrix is dominated by a permutation rather than the diagonal, so
+// that it needs pivoting
+inline double entry(int i, int j, int b, int n)
+{
+  double v = ((i * 5 + j * 3 + b * 7) % 11) - 5.;
+  if (i == (b % 3 == 0 ? (j + 1) % n : j)) {
+    v += 20.;
+  }
+  return v;
+}
+
+gt::gtensor<double, 3> make_batch(int m, int n, int nb, batch_layout layout,
+                                  int seed = 0)
+{
+  bool tr = layout == batch_layout::trailing;
+  gt::gtensor<double, 3> a(tr ? gt::shape(m, n, nb) : gt::shape(nb, m, n));
+  for (int b = 0; b < nb; b++) {
+    for (int j = 0; j < n; j++) {
+      for (int i = 0; i < m; i++) {
+        (tr ? a(i, j, b) : a(b, i, j)) = entry(i + seed, j, b, n);
+      }
+    }
+  }
+  return a;
+}
+
+gt::gtensor<double, 2> make_vectors(int n, int nb, batch_layout layout)
+{
+  bool tr = layout == batch_layout::trailing;
+  gt::gtensor<double, 2> x(tr ? gt::shape(n, nb) : gt::shape(nb, n));
+  for (int b = 0; b < nb; b++) {
+    for (int i = 0; i < n; i++) {
+      (tr ? x(i, b) : x(b, i)) = 1. + i - .5 * b;
+    }
+  }
+  return x;
+}
+
+template <typename A>
+double at(const A& a, int i, int j, int b, batch_layout layout)
+{
+  return layout == batch_layout::trailing ? a(i, j, b) : a(b, i, j);
+}
+
+template <typename X>
+double at(const X& x, int i, int b, batch_layout layout)
+{
+  return layout == batch_layout::trailing ? x(i, b) : x(b, i);
+}
+
+const batch_layout layouts[] = {batch_layout::trailing,
+                                batch_layout::interleaved};
+
+TEST(batched, matmul)
+{
+  for (auto layout : layouts) {
+    const int m = 5, k = 7, n = 3, nb = 150;
+    auto a = make_batch(m, k, nb, layout);
+    auto b = make_batch(k, n, nb, layout, 1);
+
+    auto c = gt::batched_matmul(a, b, layout);
+    for (int e = 0; e < nb; e++) {
+      for (int j = 0; j < n; j++) {
+        for (int i = 0; i < m; i++) {
+          double ref = 0.;
+          for (int p = 0; p < k; p++) {
+            ref += at(a, i, p, e, layout) * at(b, p, j, e, layout);
+          }
+          EXPECT_DOUBLE_EQ(at(c, i, j, e, layout), ref);
+        }
+      }
+    }
+
+    EXPECT_THROW(gt::batched_matmul(a, a, layout), std::runtime_error);
+  }
+}
+
+TEST(batched, matvec)
+{
+  for (auto layout : layouts) {
+    const int m = 4, n = 6, nb = 70;
+    auto a = make_batch(m, n, nb, layout);
+    auto x = make_vectors(n, nb, layout);
+
+    auto y = gt::batched_matvec(a, x, layout);
+    for (int e = 0; e < nb; e++) {
+      for (int i = 0; i < m; i++) {
+        double ref = 0.;
+        for (int j = 0; j < n; j++) {
+          ref += at(a, i, j, e, layout) * at(x, j, e, layout);
+        }
+        EXPECT_DOUBLE_EQ(at(y, i, e, layout), ref);
+      }
+    }
+  }
+}
+
+TEST(batched, lu_solve)
+{
+  for (auto layout : layouts) {
+    for (int n : {1, 4, 17}) {
+      const int nb = 130;
+      auto a = make_batch(n, n, nb, layout);
+      auto x_ref = make_vectors(n, nb, layout);
+      auto rhs = gt::batched_matvec(a, x_ref, layout);
+
+      gt::gtensor<double, 3> lu = a;
+      auto piv = gt::batched_lu_factor(lu, layout);
+      auto x = rhs;
+      gt::batched_lu_solve(lu, piv, x, layout);
+      for (int e = 0; e < nb; e++) {
+        for (int i = 0; i < n; i++) {
+          EXPECT_NEAR(at(x, i, e, layout), at(x_ref, i, e, layout), 1e-10);
+        }
+      }
+    }
+  }
+}
+
+TEST(batched, lu_singular)
+{
+  for (auto layout : layouts) {
+    auto a = make_batch(3, 3, 4, layout);
+    for (int i = 0; i < 3; i++) {
+      (layout == batch_layout::trailing ? a(i, 1, 2) : a(2, i, 1)) = 0.;
+    }
+    EXPECT_THROW(gt::batched_lu_factor(a, layout), std::runtime_error);
+  }
+}
@@ -0,0 +1,184 @@
+
+#include <gtest/gtest.h>
+
+#include <gtensor/contract.h>
+#include <gtensor/gtensor.h>
+
+#include <stdexcept>
+
+using namespace gt::placeholders;
+
+template <typename T, int N>
+gt::gtensor<T, N> make_data(const gt::shape_type<N>& shape, int seed = 0)
+{
+  gt::gtensor<T, N> x(shape);
+  for (int i = 0; i < int(x.size()); i++) {
+    x.data()[i] = T((i * 7 + seed) % 13 - 6) / T(4);
+  }
+  return x;
+}
+
+template <typename E1, typename E2>
+void expect_near_2d(const E1& x, const E2& y, double tol = 1e-10)
+{
+  ASSERT_EQ(x.shape(), y.shape());
+  for (int j = 0; j < x.shape(1); j++) {
+    for (int i = 0; i < x.shape(0); i++) {
+      EXPECT_NEAR(x(i, j), y(i, j), tol) << "at " << i << ", " << j;
+    }
+  }
+}
+
+TEST(contract, tensordot_matmul)
+{
+  auto a = make_data<double, 2>(gt::shape(7, 5), 1);
+  auto b = make_data<double, 2>(gt::shape(5, 3), 2);
+  auto ref = gt::matmul(a, b);
+  expect_near_2d(gt::tensordot<1>(a, b), ref);
+  expect_near_2d(gt::tensordot(a, b, gt::shape(1), gt::shape(0)), ref);
+
+  // transposed operands, read in place
+  gt::gtensor<double, 2> at = gt::transpose(a, gt::shape(1, 0));
+  expect_near_2d(gt::tensordot(at, b, gt::shape(0), gt::shape(0)), ref);
+
+  // outer product
+  auto o = gt::tensordot<0>(make_data<double, 1>(gt::shape(3)),
+                            make_data<double, 1>(gt::shape(4), 1));
+  EXPECT_EQ(o.shape(), gt::shape(3, 4));
+  EXPECT_EQ(o(2, 3), (make_data<double, 1>(gt::shape(3))(2) *
+                      make_data<double, 1>(gt::shape(4), 1)(3)));
+}
+
+// c(i, l) = sum_jk a(j, i, k) b(l, k, j), for any way of getting there
+template <typename EA, typename EB>
+gt::gtensor<double, 2> ref_mixed(const EA& a, const EB& b)
+{
+  gt::gtensor<double, 2> c(gt::shape(a.shape(1), b.shape(0)));
+  for (int l = 0; l < c.shape(1); l++) {
+    for (int i = 0; i < c.shape(0); i++) {
+      double sum = 0.;
+      for (int k = 0; k < a.shape(2); k++) {
+        for (int j = 0; j < a.shape(0); j++) {
+          sum += a(j, i, k) * b(l, k, j);
+        }
+      }
+      c(i, l) = sum;
+    }
+  }
+  return c;
+}
+
+TEST(contract, tensordot_mixed_axes)
+{
+  // small, by the loop nest, and big, by copying for gemm
+  for (auto s : {gt::shape(3, 4, 5, 6), gt::shape(20, 30, 40, 50)}) {
+    auto a = make_data<double, 3>(gt::shape(s[0], s[1], s[2]), 1);
+    auto b = make_data<double, 3>(gt::shape(s[3], s[2], s[0]), 2);
+    auto c = gt::tensordot(a, b, gt::shape(0, 2), gt::shape(2, 1));
+    expect_near_2d(c, ref_mixed(a, b), 1e-9);
+  }
+}
+
+TEST(contract, tensordot_views_and_expressions)
+{
+  auto a_full = make_data<double, 3>(gt::shape(8, 9, 10), 1);
+  auto b = make_data<double, 3>(gt::shape(5, 4, 4), 2);
+  auto a = a_full.view(_s(1, _, 2), _s(_, 5), _s(_, _, 3));
+  auto c = gt::tensordot(a, b, gt::shape(0, 2), gt::shape(2, 1));
+  expect_near_2d(c, ref_mixed(a, b));
+
+  gt::gtensor<double, 3> a2 = 2. * a;
+  expect_near_2d(gt::tensordot(2. * a, b, gt::shape(0, 2), gt::shape(2, 1)),
+                 ref_mixed(a2, b));
+
+  EXPECT_THROW(gt::tensordot(a, b, gt::shape(0), gt::shape(0)),
+               std::runtime_error);
+  EXPECT_THROW(gt::tensordot(a, b, gt::shape(0, 0), gt::shape(2, 2)),
+               std::runtime_error);
+  EXPECT_THROW(gt::tensordot(a, b, gt::shape(3), gt::shape(2)),
+               std::runtime_error);
+}
+
+TEST(contract, einsum)
+{
+  auto a = make_data<double, 2>(gt::shape(6, 4), 1);
+  auto b = make_data<double, 2>(gt::shape(4, 5), 2);
+  expect_near_2d(gt::einsum<2>("ij,jk->ik", a, b), gt::matmul(a, b));
+  expect_near_2d(gt::einsum<2>("ij,jk", a, b), gt::matmul(a, b));
+  // result transposed
+  gt::gtensor<double, 2> ref_t =
+    gt::transpose(gt::matmul(a, b), gt::shape(1, 0));
+  expect_near_2d(gt::einsum<2>("ij,jk->ki", a, b), ref_t);
+
+  // transpose, diagonal, row sums
+  gt::gtensor<double, 2> at = gt::transpose(a, gt::shape(1, 0));
+  expect_near_2d(gt::einsum<2>("ij->ji", a), at);
+  auto sq = make_data<double, 2>(gt::shape(5, 5));
+  auto diag = gt::einsum<1>("ii->i", sq);
+  auto sums = gt::einsum<1>("ij->i", a);
+  for (int i = 0; i < 5; i++) {
+    EXPECT_EQ(diag(i), sq(i, i));
+  }
+  for (int i = 0; i < 6; i++) {
+    double ref = 0.;
+    for (int j = 0; j < 4; j++) {
+      ref += a(i, j);
+    }
+    EXPECT_NEAR(sums(i), ref, 1e-12);
+  }
+}
+
+TEST(contract, einsum_batched)
+{
+  // a batch index, shared by both operands and the result
+  auto a = make_data<double, 3>(gt::shape(3, 4, 7), 1);
+  auto b = make_data<double, 3>(gt::shape(4, 2, 7), 2);
+  auto c = gt::einsum<3>("ijb,jkb->ikb", a, b);
+  ASSERT_EQ(c.shape(), gt::shape(3, 2, 7));
+  for (int e = 0; e < 7; e++) {
+    expect_near_2d(c.view(_all, _all, e),
+                   gt::matmul(a.view(_all, _all, e), b.view(_all, _all, e)));
+  }
+
+  // moments: m(i, q) = sum_v f(v, i) v^q
+  auto f = make_data<double, 2>(gt::shape(16, 5));
+  gt::gtensor<double, 2> vq(gt::shape(16, 3));
+  for (int v = 0; v < 16; v++) {
+    for (int q = 0; q < 3; q++) {
+      vq(v, q) = std::pow(v - 7.5, q);
+    }
+  }
+  gt::gtensor<double, 2> ft = gt::transpose(f, gt::shape(1, 0));
+  expect_near_2d(gt::einsum<2>("vi,vq->iq", f, vq), gt::matmul(ft, vq));
+}
+
+TEST(contract, einsum_errors)
+{
+  auto a = make_data<double, 2>(gt::shape(6, 4));
+  auto b = make_data<double, 2>(gt::shape(5, 3));
+  EXPECT_THROW(gt::einsum<2>("ij,jk->ik", a, b), std::runtime_error);
+  EXPECT_THROW(gt::einsum<2>("ijk,kl->il", a, a), std::runtime_error);
+  EXPECT_THROW(gt::einsum<1>("ij,jk->ik", a, a), std::runtime_error);
+  EXPECT_THROW(gt::einsum<2>("ij,jk->iz", a, a), std::runtime_error);
+  EXPECT_THROW(gt::einsum<2>("ij,jk->ii", a, a), std::runtime_error);
+  EXPECT_THROW(gt::einsum<2>("ij->i1", a), std::runtime_error);
+  EXPECT_THROW(gt::einsum<2>("ij", a, b), std::runtime_error);
+}
+
+TEST(contract, fusion_scope)
+{
+  auto a = make_data<double, 2>(gt::shape(6, 4), 1);
+  auto b = make_data<double, 2>(gt::shape(4, 5), 2);
+  gt::gtensor<double, 2> a2 = a + a;
+  auto ref = gt::matmul(a2, b);
+  gt::gtensor<double, 1> sums_ref = gt::einsum<1>("ij->i", a2);
+
+  // operand expressions are evaluated right away, not deferred
+  gt::fusion_scope fs;
+  expect_near_2d(gt::tensordot<1>(a + a, b), ref);
+  expect_near_2d(gt::einsum<2>("ij,jk->ik", a + a, b), ref);
+  auto sums = gt::einsum<1>("ij->i", a + a);
+  for (int i = 0; i < 6; i++) {
+    EXPECT_NEAR(sums(i), sums_ref(i), 1e-12);
+  }
+}
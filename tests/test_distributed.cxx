@@ -0,0 +1,193 @@
+
+#include <gtest/gtest.h>
+
+#include <gtensor/distributed.h>
+#include <gtensor/gtensor.h>
+
+#include <stdexcept>
+
+// global index (i, j) -> value, with -1 for outside of the global domain
+inline double global_value(int i, int j, int nx, int ny)
+{
+  if (i < 0 || i >= nx || j < 0 || j >= ny) {
+    return -1.;
+  }
+  return i + 100. * j;
+}
+
+template <typename D>
+void init_2d(D& u)
+{
+  u.for_each_local([&](int l) {
+    auto&& s = u.local(l).storage();
+    for (int j = 0; j < s.shape(1); j++) {
+      for (int i = 0; i < s.shape(0); i++) {
+        s(i, j) = -1.;
+      }
+    }
+    auto in = u.local(l).interior();
+    for (int j = 0; j < in.shape(1); j++) {
+      for (int i = 0; i < in.shape(0); i++) {
+        in(i, j) = global_value(u.offset(l)[0] + i, u.offset(l)[1] + j,
+                                u.shape(0), u.shape(1));
+      }
+    }
+  });
+}
+
+// checks all ghost and interior points against the global array
+template <typename D>
+void check_2d(const D& u, bool periodic_x, bool periodic_y)
+{
+  const int nx = u.shape()[0], ny = u.shape()[1];
+  for (int l = 0; l < u.n_local(); l++) {
+    const auto& s = u.local(l).storage();
+    const auto& g = u.ghosts();
+    for (int j = 0; j < s.shape(1); j++) {
+      for (int i = 0; i < s.shape(0); i++) {
+        int gi = u.offset(l)[0] + i - g[0];
+        int gj = u.offset(l)[1] + j - g[1];
+        if (periodic_x) {
+          gi = (gi + nx) % nx;
+        }
+        if (periodic_y) {
+          gj = (gj + ny) % ny;
+        }
+        EXPECT_EQ(s(i, j), global_value(gi, gj, nx, ny))
+          << "rank " << u.rank(l) << " at " << i << ", " << j;
+      }
+    }
+  }
+}
+
+// the same in 3-d, with global index (i, j, k) -> i + 100 j + 10000 k
+inline double global_value(int i, int j, int k, const gt::shape_type<3>& n)
+{
+  if (k < 0 || k >= n[2]) {
+    return -1.;
+  }
+  double v = global_value(i, j, n[0], n[1]);
+  return v < 0. ? v : v + 10000. * k;
+}
+
+template <typename D>
+void init_3d(D& u)
+{
+  u.for_each_local([&](int l) {
+    auto&& s = u.local(l).storage();
+    for (int n = 0; n < int(s.size()); n++) {
+      s.data()[n] = -1.;
+    }
+    auto in = u.local(l).interior();
+    const auto& o = u.offset(l);
+    for (int k = 0; k < in.shape(2); k++) {
+      for (int j = 0; j < in.shape(1); j++) {
+        for (int i = 0; i < in.shape(0); i++) {
+          in(i, j, k) = global_value(o[0] + i, o[1] + j, o[2] + k, u.shape());
+        }
+      }
+    }
+  });
+}
+
+// checks all points against the global array, periodic along the first
+// dimension
+template <typename D>
+void check_3d(const D& u)
+{
+  const auto& g = u.ghosts();
+  for (int l = 0; l < u.n_local(); l++) {
+    const auto& s = u.local(l).storage();
+    const auto& o = u.offset(l);
+    for (int k = 0; k < s.shape(2); k++) {
+      for (int j = 0; j < s.shape(1); j++) {
+        for (int i = 0; i < s.shape(0); i++) {
+          int gi = (o[0] + i - g[0] + u.shape(0)) % u.shape(0);
+          EXPECT_EQ(s(i, j, k), global_value(gi, o[1] + j - g[1],
+                                             o[2] + k - g[2], u.shape()))
+            << "rank " << u.rank(l) << " at " << i << ", " << j << ", " << k;
+        }
+      }
+    }
+  }
+}
+
+TEST(distributed, decomposition)
+{
+  gt::distributed_gtensor<double, 2> u(gt::shape(10, 7), gt::shape(3, 2),
+                                       gt::shape(1, 2));
+  EXPECT_EQ(u.n_ranks(), 6);
+  EXPECT_EQ(u.n_local(), 6);
+  EXPECT_EQ(u.local(0).shape(), gt::shape(4, 4));
+  EXPECT_EQ(u.local(2).shape(), gt::shape(3, 4));
+  EXPECT_EQ(u.offset(2), gt::shape(7, 0));
+  EXPECT_EQ(u.local(5).shape(), gt::shape(3, 3));
+  EXPECT_EQ(u.offset(5), gt::shape(7, 4));
+  EXPECT_EQ(u.core(0).shape(), gt::shape(2, 0));
+
+  EXPECT_THROW((gt::distributed_gtensor<double, 1>(gt::shape(3), gt::shape(4),
+                                                   gt::shape(0))),
+               std::runtime_error);
+  EXPECT_THROW((gt::distributed_gtensor<double, 1>(gt::shape(6), gt::shape(3),
+                                                   gt::shape(3))),
+               std::runtime_error);
+}
+
+TEST(distributed, exchange_halos)
+{
+  gt::distributed_gtensor<double, 2> u(gt::shape(10, 7), gt::shape(3, 2),
+                                       gt::shape(1, 2));
+  init_2d(u);
+  u.exchange_halos();
+  check_2d(u, false, false);
+}
+
+TEST(distributed, exchange_halos_periodic)
+{
+  for (int px : {1, 2, 3}) {
+    gt::sarray<bool, 2> periodic(true, true);
+    gt::distributed_gtensor<double, 2> u(gt::shape(9, 8), gt::shape(px, 2),
+                                         gt::shape(2, 1), periodic);
+    init_2d(u);
+    u.exchange_halos();
+    check_2d(u, true, true);
+  }
+}
+
+TEST(distributed, exchange_halos_async)
+{
+  gt::sarray<bool, 2> periodic(true, false);
+  gt::distributed_gtensor<double, 2> u(gt::shape(12, 6), gt::shape(2, 2),
+                                       gt::shape(1, 1), periodic);
+  init_2d(u);
+
+  // sum over the points that don't need halos while they are exchanged
+  gt::gtensor<double, 1> core_sum(gt::shape(u.n_local()));
+  auto pending = u.exchange_halos_async();
+  u.for_each_local([&](int l) {
+    auto core = u.core(l);
+    double sum = 0.;
+    for (int j = 0; j < core.shape(1); j++) {
+      for (int i = 0; i < core.shape(0); i++) {
+        sum += core(i, j);
+      }
+    }
+    core_sum(l) = sum;
+  });
+  pending.get();
+
+  check_2d(u, true, false);
+  // rank 0's core is (1..4) x (1..1)
+  EXPECT_EQ(core_sum(0), 1. + 2. + 3. + 4. + 4 * 100.);
+}
+
+TEST(distributed, exchange_halos_3d)
+{
+  // the middle dimension has extent 1, and so stride 0
+  gt::sarray<bool, 3> periodic(true, false, false);
+  gt::distributed_gtensor<double, 3> u(gt::shape(6, 1, 8), gt::shape(2, 1, 2),
+                                       gt::shape(1, 0, 2), periodic);
+  init_3d(u);
+  u.exchange_halos();
+  check_3d(u);
+}
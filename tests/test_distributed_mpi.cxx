@@ -0,0 +1,56 @@
+
+#include <gtest/gtest.h>
+
+#include <gtensor/gtensor.h>
+#include <gtensor/mpi_transport.h>
+
+// runs on 4 processes, one subdomain each
+
+using distributed = gt::distributed_gtensor<double, 2, gt::mpi_transport>;
+
+inline double global_value(int i, int j) { return i + 100. * j; }
+
+TEST(distributed_mpi, exchange_halos)
+{
+  gt::sarray<bool, 2> periodic(true, false);
+  distributed u(gt::shape(9, 6), gt::shape(2, 2), gt::shape(1, 2), periodic);
+  ASSERT_EQ(u.n_local(), 1);
+
+  auto&& s = u.local(0).storage();
+  for (int j = 0; j < s.shape(1); j++) {
+    for (int i = 0; i < s.shape(0); i++) {
+      s(i, j) = -1.;
+    }
+  }
+  auto in = u.local(0).interior();
+  const auto& off = u.offset(0);
+  for (int j = 0; j < in.shape(1); j++) {
+    for (int i = 0; i < in.shape(0); i++) {
+      in(i, j) = global_value(off[0] + i, off[1] + j);
+    }
+  }
+
+  u.exchange_halos_async().get();
+
+  for (int j = 0; j < s.shape(1); j++) {
+    for (int i = 0; i < s.shape(0); i++) {
+      int gi = (off[0] + i - 1 + 9) % 9;
+      int gj = off[1] + j - 2;
+      double ref = (gj < 0 || gj >= 6) ? -1. : global_value(gi, gj);
+      EXPECT_EQ(s(i, j), ref) << "rank " << u.rank(0) << " at " << i << ", "
+                              << j;
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  int provided;
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
+  ::testing::InitGoogleTest(&argc, argv);
+  int rc = RUN_ALL_TESTS();
+  int rc_all;
+  MPI_Allreduce(&rc, &rc_all, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+  MPI_Finalize();
+  return rc_all;
+}
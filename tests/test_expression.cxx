@@ -143,7 +143,7 @@ TEST(expression, shape_same)
 
   auto e1 = -t1;
   auto shape1 = e1.shape();
-  EXPECT_EQ(e1.shape(), (S3{2, 3, 4}));
+  EXPECT_EQ(shape1, (S3{2, 3, 4}));
 
   auto e2 = t1 + t2;
   EXPECT_EQ(e2.shape(), (S3{2, 3, 4}));
@@ -170,3 +170,25 @@ TEST(expression, shape_second)
   auto e = t1 + t2;
   EXPECT_EQ(e.shape(), (S3{2, 3, 4}));
 }
+
+TEST(expression, shape_nested)
+{
+  using S3 = gt::sarray<int, 3>;
+
+  gt::gtensor<double, 3> t1({2, 3, 4});
+  gt::gtensor<double, 1> t2(gt::shape(1));
+
+  auto e = -(t1 + t2) * t2;
+  EXPECT_EQ(e.shape(), (S3{2, 3, 4}));
+  EXPECT_EQ(e.shape(1), 3);
+  EXPECT_EQ(e.to_kernel().shape(), (S3{2, 3, 4}));
+}
+
+TEST(expression, shape_broadcast_error)
+{
+  gt::gtensor<double, 2> t1({2, 3});
+  gt::gtensor<double, 2> t2({3, 3});
+
+  // incompatible shapes are detected when building the expression
+  EXPECT_THROW(t1 + t2, std::runtime_error);
+}
@@ -0,0 +1,82 @@
+
+#include <gtest/gtest.h>
+
+#include <gtensor/gtensor.h>
+
+using namespace gt::placeholders;
+
+using X23 = gt::extents<2, 3>;
+using X2d = gt::extents<2, gt::dynamic_extent>;
+
+TEST(extents, ctor)
+{
+  X2d x(2, 5);
+  EXPECT_EQ(x.size(), 2);
+  EXPECT_EQ(x[0], 2);
+  EXPECT_EQ(x[1], 5);
+  EXPECT_EQ(x, gt::shape(2, 5));
+  EXPECT_EQ(gt::shape(2, 5), x);
+
+  X2d x2;
+  EXPECT_EQ(x2, gt::shape(2, 0));
+
+  X23 x3 = gt::shape(2, 3);
+  EXPECT_EQ(x3, gt::shape(2, 3));
+}
+
+TEST(extents, static_extent)
+{
+  static_assert(X2d::is_static(0), "");
+  static_assert(!X2d::is_static(1), "");
+  static_assert(X2d::static_extent(0) == 2, "");
+
+  X23 x;
+  EXPECT_EQ(gt::get<1>(x), 3);
+}
+
+TEST(extents, strides)
+{
+  gt::assert_is_same<gt::strides_t<X23>, gt::extents<1, 2>>();
+  gt::assert_is_same<
+    gt::strides_t<gt::extents<2, 3, gt::dynamic_extent, 4>>,
+    gt::extents<1, 2, gt::dynamic_extent, gt::dynamic_extent>>();
+  gt::assert_is_same<gt::strides_t<gt::extents<1, 3>>, gt::extents<0, 1>>();
+
+  EXPECT_EQ(gt::calc_strides(X2d(2, 5)), gt::shape(1, 2));
+  EXPECT_EQ(gt::calc_index(gt::calc_strides(X23()), 1, 2), 5);
+}
+
+TEST(extents, gtensor)
+{
+  using gtensor_type = gt::gtensor<double, 2, gt::space::host, X2d>;
+
+  gtensor_type a({2, 3});
+  EXPECT_EQ(a.shape(), gt::shape(2, 3));
+  gt::assert_is_same<gtensor_type::shape_type, X2d>();
+  gt::assert_is_same<gtensor_type::strides_type,
+                     gt::extents<1, gt::dynamic_extent>>();
+
+  gt::gtensor<double, 2> b{{11., 12.}, {21., 22.}, {31., 32.}};
+  a = b + b;
+  EXPECT_EQ(a, (gt::gtensor<double, 2>{{22., 24.}, {42., 44.}, {62., 64.}}));
+
+  gtensor_type c = a.view(_all, _s(1, 3));
+  EXPECT_EQ(c, (gt::gtensor<double, 2>{{42., 44.}, {62., 64.}}));
+
+  c(1, 1) = 1.;
+  EXPECT_EQ(c(1, 1), 1.);
+}
+
+TEST(extents, gtensor_view)
+{
+  gt::gtensor<double, 2, gt::space::host, X23> a{
+    {11., 12.}, {21., 22.}, {31., 32.}};
+
+  auto k_a = a.to_kernel();
+  gt::assert_is_same<decltype(k_a),
+                     gt::gtensor_view<double, 2, gt::space::host, X23>>();
+  EXPECT_EQ(k_a, a);
+
+  k_a = 2. * a;
+  EXPECT_EQ(a, (gt::gtensor<double, 2>{{22., 24.}, {42., 44.}, {62., 64.}}));
+}
@@ -0,0 +1,182 @@
+
+#include <gtest/gtest.h>
+
+#include <gtensor/fft.h>
+#include <gtensor/gtensor.h>
+
+#include <cmath>
+#include <stdexcept>
+
+using namespace gt::placeholders;
+
+using cdouble = gt::complex<double>;
+
+template <typename T>
+gt::gtensor<T, 3> make_data(const gt::shape_type<3>& shape)
+{
+  gt::gtensor<T, 3> x(shape);
+  for (int i = 0; i < int(x.size()); i++) {
+    x.data()[i] = T((i * 37 % 23) - 11.) / T(8);
+  }
+  return x;
+}
+
+template <>
+gt::gtensor<cdouble, 3> make_data(const gt::shape_type<3>& shape)
+{
+  gt::gtensor<cdouble, 3> x(shape);
+  for (int i = 0; i < int(x.size()); i++) {
+    x.data()[i] = cdouble((i * 37 % 23) - 11., (i * 13 % 17) - 8.) / 8.;
+  }
+  return x;
+}
+
+// reference: the DFT along axis, term by term
+template <typename E>
+gt::gtensor<cdouble, 3> ref_dft(const E& x, int axis, int sign = -1)
+{
+  auto shape = x.shape();
+  const int n = shape[axis];
+  gt::gtensor<cdouble, 3> r(shape);
+  for (int c = 0; c < shape[2]; c++) {
+    for (int b = 0; b < shape[1]; b++) {
+      for (int a = 0; a < shape[0]; a++) {
+        int idx[3] = {a, b, c};
+        const int k = idx[axis];
+        cdouble sum = 0.;
+        for (int j = 0; j < n; j++) {
+          idx[axis] = j;
+          const double phi = sign * 2. * M_PI * double(j) * k / n;
+          sum += cdouble(x(idx[0], idx[1], idx[2])) *
+                 cdouble(std::cos(phi), std::sin(phi));
+        }
+        r(a, b, c) = sum;
+      }
+    }
+  }
+  return r;
+}
+
+template <typename E1, typename E2>
+void expect_near(const E1& x, const E2& y, double tol = 1e-10)
+{
+  ASSERT_EQ(x.shape(), y.shape());
+  for (int c = 0; c < x.shape(2); c++) {
+    for (int b = 0; b < x.shape(1); b++) {
+      for (int a = 0; a < x.shape(0); a++) {
+        ASSERT_LT(std::abs(cdouble(x(a, b, c)) - cdouble(y(a, b, c))), tol)
+          << "at " << a << ", " << b << ", " << c;
+      }
+    }
+  }
+}
+
+TEST(fft, lengths)
+{
+  // radices 2, 3, 4 and generic primes, mixed
+  for (int n : {1, 2, 3, 4, 5, 6, 7, 8, 12, 15, 16, 30, 49, 64, 97, 100}) {
+    for (int axis = 0; axis < 3; axis++) {
+      auto shape = gt::shape(3, 4, 2);
+      shape[axis] = n;
+      auto x = make_data<cdouble>(shape);
+      auto y = gt::fft(x, axis);
+      expect_near(y, ref_dft(x, axis), 1e-10 * n);
+      expect_near(gt::ifft(y, axis), x, 1e-10 * n);
+    }
+  }
+}
+
+TEST(fft, many_lines)
+{
+  // more lines than fit in one block
+  auto x = make_data<cdouble>(gt::shape(70, 20, 64));
+  for (int axis = 0; axis < 3; axis++) {
+    expect_near(gt::fft(x, axis), ref_dft(x, axis), 1e-9);
+  }
+}
+
+TEST(fft, views_and_expressions)
+{
+  auto x = make_data<cdouble>(gt::shape(12, 10, 9));
+  auto v = x.view(_s(1, _, 2), _all, _s(_, _, -2));
+  gt::gtensor<cdouble, 3> vc = v;
+  for (int axis = 0; axis < 3; axis++) {
+    expect_near(gt::fft(v, axis), ref_dft(vc, axis));
+  }
+
+  gt::gtensor<cdouble, 3> e = 2. * x;
+  expect_near(gt::fft(2. * x, 1), ref_dft(e, 1));
+
+  // real input
+  auto xr = make_data<double>(gt::shape(6, 5, 4));
+  expect_near(gt::fft(xr, 2), ref_dft(xr, 2));
+
+  EXPECT_THROW(gt::fft(x, 3), std::runtime_error);
+  EXPECT_THROW(gt::fft(x, -1), std::runtime_error);
+}
+
+TEST(fft, fusion_scope)
+{
+  auto x = make_data<cdouble>(gt::shape(8, 3, 2));
+  gt::gtensor<cdouble, 3> e = x + x;
+  auto ref = ref_dft(e, 0);
+
+  // the input expression is evaluated right away, not deferred
+  gt::fusion_scope fs;
+  expect_near(gt::fft(x + x, 0), ref);
+}
+
+TEST(fft, rfft)
+{
+  for (int n : {1, 2, 5, 8, 9, 12, 30, 64}) {
+    for (int axis = 0; axis < 3; axis++) {
+      auto shape = gt::shape(5, 3, 4);
+      shape[axis] = n;
+      auto x = make_data<double>(shape);
+      auto y = gt::rfft(x, axis);
+      auto ref = ref_dft(x, axis);
+      auto ref_half = gt::gtensor<cdouble, 3>(
+        ref.view(axis == 0 ? _s(_, n / 2 + 1) : _all,
+                 axis == 1 ? _s(_, n / 2 + 1) : _all,
+                 axis == 2 ? _s(_, n / 2 + 1) : _all));
+      expect_near(y, ref_half, 1e-10 * n);
+
+      auto xi = gt::irfft(y, n, axis);
+      expect_near(xi, x, 1e-10 * n);
+    }
+  }
+
+  auto y = gt::rfft(make_data<double>(gt::shape(8, 2, 2)));
+  EXPECT_THROW(gt::irfft(y, 6), std::runtime_error);
+  EXPECT_EQ(gt::irfft(y, 9).shape(), gt::shape(9, 2, 2));
+}
+
+TEST(fft, float_type)
+{
+  auto x = make_data<float>(gt::shape(24, 3, 5));
+  auto y = gt::fft(x, 0);
+  using V = decltype(y)::value_type;
+  static_assert(std::is_same<V, gt::complex<float>>::value, "");
+  expect_near(y, ref_dft(x, 0), 1e-4);
+  expect_near(gt::irfft(gt::rfft(x, 0), 24, 0), x, 1e-5);
+}
+
+TEST(fft, higher_dimensions)
+{
+  // 5-d, transformed along two axes in turn
+  gt::gtensor<cdouble, 5> x(gt::shape(4, 3, 6, 2, 5));
+  for (int i = 0; i < int(x.size()); i++) {
+    x.data()[i] = cdouble(i % 7, i % 3);
+  }
+  auto y = gt::ifft(gt::ifft(gt::fft(gt::fft(x, 2), 4), 2), 4);
+  for (int i = 0; i < int(x.size()); i++) {
+    EXPECT_LT(std::abs(y.data()[i] - x.data()[i]), 1e-12);
+  }
+
+  // a constant transforms to a spike
+  gt::gtensor<cdouble, 5> c(x.shape());
+  c.view() = cdouble(1.);
+  auto f = gt::fft(c, 2);
+  EXPECT_LT(std::abs(f(1, 2, 0, 1, 3) - 6.), 1e-12);
+  EXPECT_LT(std::abs(f(1, 2, 3, 1, 3)), 1e-12);
+}
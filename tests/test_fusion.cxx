@@ -0,0 +1,176 @@
+
+#include <gtest/gtest.h>
+
+#include <gtensor/gtensor.h>
+
+#include <stdexcept>
+
+TEST(fusion, deferred)
+{
+  gt::gtensor<double, 1> a{1., 2., 3.};
+  gt::gtensor<double, 1> b(a.shape());
+
+  {
+    gt::fusion_scope fs;
+    b = 2. * a;
+    EXPECT_EQ(b.shape(), gt::shape(3));
+    a *= 0.;
+  }
+  EXPECT_EQ(b, (gt::gtensor<double, 1>{2., 4., 6.}));
+  EXPECT_EQ(a, (gt::gtensor<double, 1>{0., 0., 0.}));
+}
+
+TEST(fusion, sequence)
+{
+  gt::gtensor<double, 2> a{{1., 2., 3.}, {4., 5., 6.}};
+  gt::gtensor<double, 2> b{{10., 20., 30.}, {40., 50., 60.}};
+  gt::gtensor<double, 2> c(a.shape()), d(a.shape());
+
+  {
+    gt::fusion_scope fs;
+    c = a + b;
+    d = c * a;
+    c -= a;
+    a = d - c;
+  }
+  EXPECT_EQ(c, b);
+  EXPECT_EQ(d, (gt::gtensor<double, 2>{{11., 44., 99.}, {176., 275., 396.}}));
+  EXPECT_EQ(a, (gt::gtensor<double, 2>{{1., 24., 69.}, {136., 225., 336.}}));
+}
+
+TEST(fusion, shifted)
+{
+  using namespace gt::placeholders;
+
+  gt::gtensor<double, 1> a{1., 2., 3., 4.};
+  gt::gtensor<double, 1> b(a.shape());
+
+  // the second statement reads what the first one wrote at a different
+  // index, so they can't be interleaved
+  {
+    gt::fusion_scope fs;
+    b = 10. * a;
+    a.view(_s(1, _)) = b.view(_s(_, -1));
+    a.view(_s(1, _)) += a.view(_s(_, -1));
+  }
+  EXPECT_EQ(a, (gt::gtensor<double, 1>{1., 11., 30., 50.}));
+}
+
+TEST(fusion, temporary)
+{
+  gt::gtensor<double, 2> a{{1., 2., 3.}, {4., 5., 6.}};
+  gt::gtensor<double, 2> b{{10., 20., 30.}, {40., 50., 60.}};
+  gt::gtensor<double, 2> c(a.shape()), d(a.shape());
+
+  {
+    gt::fusion_scope fs;
+    auto tmp = fs.temporary<double>(a.shape());
+    tmp = a * b;
+    c = tmp + a;
+    d = 2. * tmp - c;
+  }
+  EXPECT_EQ(c, (gt::gtensor<double, 2>{{11., 42., 93.}, {164., 255., 366.}}));
+  EXPECT_EQ(d, (gt::gtensor<double, 2>{{9., 38., 87.}, {156., 245., 354.}}));
+}
+
+TEST(fusion, temporary_not_fusable)
+{
+  using namespace gt::placeholders;
+
+  gt::gtensor<double, 1> a{1., 2., 3., 4.};
+  gt::gtensor<double, 1> b(a.shape());
+
+  gt::fusion_scope fs;
+  auto tmp = fs.temporary<double>(a.shape());
+  tmp = 2. * a;
+  EXPECT_THROW(b.view(_s(1, _)) = tmp.view(_s(_, -1)), std::runtime_error);
+}
+
+TEST(fusion, construct)
+{
+  gt::gtensor<double, 1> a{1., 2., 3.};
+
+  gt::fusion_scope fs;
+  a = 2. * a;
+  // creating a new array runs right away, after what's pending
+  gt::gtensor<double, 1> b = a + 1.;
+  EXPECT_EQ(b, (gt::gtensor<double, 1>{3., 5., 7.}));
+}
+
+TEST(fusion, flush)
+{
+  gt::gtensor<double, 2> a(gt::shape(3, 4));
+  gt::gtensor<double, 2> b(a.shape());
+  gt::gtensor<double, 2> c(a.shape());
+
+  gt::fusion_scope fs;
+  a.view() = 1.;
+  b = a + 1.;
+  b *= a + b;
+  fs.flush();
+  c.view() = 6.;
+  fs.flush();
+  EXPECT_EQ(b, c);
+  c -= a;
+  fs.flush();
+  EXPECT_EQ(c, (gt::gtensor<double, 2>(5. * a)));
+}
+
+TEST(fusion, flush_throws)
+{
+  gt::gtensor<double, 1> a{1., 2., 3.};
+  auto fail = [](double, double) -> double {
+    throw std::runtime_error("fail");
+  };
+
+  {
+    gt::fusion_scope fs;
+    gt::compound_assign(a, a, fail);
+    EXPECT_THROW(fs.flush(), std::runtime_error);
+  }
+  // an error when flushing at the end of the scope is dropped, rather than
+  // terminating from the destructor
+  {
+    gt::fusion_scope fs;
+    gt::compound_assign(a, a, fail);
+  }
+  EXPECT_EQ(a, (gt::gtensor<double, 1>{1., 2., 3.}));
+}
+
+gt::gtensor<double, 1> make_ramp(int n)
+{
+  gt::gtensor<double, 1> r(gt::shape(n));
+  for (int i = 0; i < n; i++) {
+    r(i) = i;
+  }
+  return r;
+}
+
+TEST(fusion, owned_operand)
+{
+  using namespace gt::placeholders;
+
+  const int n = 1000;
+  gt::gtensor<double, 1> a(gt::shape(n)), c(gt::shape(n)), d(gt::shape(n));
+  for (int i = 0; i < n; i++) {
+    a(i) = 1.;
+  }
+
+  {
+    gt::fusion_scope fs;
+    a = 2. * a;
+    // the temporaries are gone by the end of the scope, so these run right
+    // away, after what's pending
+    c = a + make_ramp(n);
+    d = make_ramp(n).view(_s(_, _, -1));
+    // memory that the temporaries' storage is likely reused for
+    gt::gtensor<double, 1> junk(gt::shape(n));
+    for (int i = 0; i < n; i++) {
+      junk(i) = -1.;
+    }
+  }
+  for (int i = 0; i < n; i++) {
+    EXPECT_EQ(c(i), 2. + i) << i;
+    EXPECT_EQ(d(i), n - 1. - i) << i;
+  }
+}
@@ -0,0 +1,158 @@
+
+#include <gtest/gtest.h>
+
+#include <gtensor/gemm.h>
+#include <gtensor/gtensor.h>
+
+#include <cmath>
+#include <stdexcept>
+
+using namespace gt::placeholders;
+
+template <typename T>
+gt::gtensor<T, 2> make_matrix(int m, int n, int seed)
+{
+  gt::gtensor<T, 2> a(gt::shape(m, n));
+  for (int j = 0; j < n; j++) {
+    for (int i = 0; i < m; i++) {
+      a(i, j) = T((i * 7 + j * 13 + seed) % 17 - 8) / T(4);
+    }
+  }
+  return a;
+}
+
+// reference: plain triple loop
+template <typename T, typename EA, typename EB, typename EC>
+gt::gtensor<T, 2> ref_gemm(T alpha, const EA& a, const EB& b, T beta,
+                           const EC& c)
+{
+  gt::gtensor<T, 2> r(c.shape());
+  for (int j = 0; j < c.shape(1); j++) {
+    for (int i = 0; i < c.shape(0); i++) {
+      T sum = 0;
+      for (int p = 0; p < a.shape(1); p++) {
+        sum += a(i, p) * b(p, j);
+      }
+      r(i, j) = alpha * sum + beta * c(i, j);
+    }
+  }
+  return r;
+}
+
+template <typename E1, typename E2>
+void expect_near(const E1& x, const E2& y, double tol = 1e-10)
+{
+  ASSERT_EQ(x.shape(), y.shape());
+  for (int j = 0; j < x.shape(1); j++) {
+    for (int i = 0; i < x.shape(0); i++) {
+      EXPECT_NEAR(x(i, j), y(i, j), tol) << "at " << i << ", " << j;
+    }
+  }
+}
+
+TEST(gemm, matmul)
+{
+  gt::gtensor<double, 2> a{{1., 2.}, {3., 4.}, {5., 6.}};
+  gt::gtensor<double, 2> b{{1., 0., 2.}, {0., 1., 1.}};
+
+  // a is 2 x 3, b is 3 x 2
+  auto c = gt::matmul(a, b);
+  EXPECT_EQ(c, (gt::gtensor<double, 2>{{11., 14.}, {8., 10.}}));
+
+  EXPECT_THROW(gt::matmul(a, a), std::runtime_error);
+}
+
+TEST(gemm, alpha_beta)
+{
+  for (auto mnk : {gt::shape(1, 1, 1), gt::shape(7, 5, 3),
+                   gt::shape(133, 70, 300), gt::shape(9, 2100, 20)}) {
+    auto a = make_matrix<double>(mnk[0], mnk[2], 1);
+    auto b = make_matrix<double>(mnk[2], mnk[1], 2);
+    auto c = make_matrix<double>(mnk[0], mnk[1], 3);
+    auto ref = ref_gemm(2., a, b, -.5, c);
+    gt::gemm(2., a, b, -.5, c);
+    expect_near(c, ref);
+  }
+}
+
+TEST(gemm, strided_views)
+{
+  // strides that rule out BLAS, which exercises the blocked kernel
+  auto a_full = make_matrix<double>(2 * 133, 300, 1);
+  auto b_full = make_matrix<double>(300, 3 * 70, 2);
+  auto c_full = make_matrix<double>(2 * 133, 2 * 70, 3);
+  auto a = a_full.view(_s(_, _, 2), _all);
+  auto b = b_full.view(_all, _s(_, _, 3));
+  auto c = c_full.view(_s(1, _, 2), _s(_, _, 2));
+
+  auto ref = ref_gemm(1.5, a, b, 2., c);
+  gt::gemm(1.5, a, b, 2., c);
+  expect_near(c, ref);
+  // the points in between are left alone
+  EXPECT_EQ(c_full(0, 0), make_matrix<double>(1, 1, 3)(0, 0));
+}
+
+TEST(gemm, transposed)
+{
+  auto a = make_matrix<double>(40, 30, 1);
+  auto b = make_matrix<double>(40, 20, 2);
+  gt::gtensor<double, 2> c(gt::shape(30, 20));
+
+  auto at = gt::transpose(a, gt::shape(1, 0));
+  auto ref = ref_gemm(1., at, b, 0., c);
+  gt::gemm(1., at, b, 0., c);
+  expect_near(c, ref);
+
+  // the result transposed, into a transposed view
+  gt::gtensor<double, 2> ct(gt::shape(20, 30));
+  gt::gemm(1., at, b, 0., gt::transpose(ct, gt::shape(1, 0)));
+  expect_near(gt::transpose(ct, gt::shape(1, 0)), ref);
+}
+
+TEST(gemm, expressions)
+{
+  auto a = make_matrix<double>(10, 12, 1);
+  auto b = make_matrix<double>(12, 9, 2);
+
+  gt::gtensor<double, 2> a2 = 2. * a + 1.;
+  auto c = gt::matmul(2. * a + 1., b);
+  expect_near(c, gt::matmul(a2, b));
+
+  gt::gtensor<float, 2> af = a;
+  auto cf = gt::matmul(af, b);
+  expect_near(cf, gt::matmul(a, b));
+}
+
+TEST(gemm, float_type)
+{
+  auto a = make_matrix<float>(67, 45, 1);
+  auto b = make_matrix<float>(45, 33, 2);
+  gt::gtensor<float, 2> c(gt::shape(67, 33));
+  auto ref = ref_gemm(1.f, a, b, 0.f, c);
+  gt::gemm(1.f, a, b, 0.f, c);
+  expect_near(c, ref, 1e-4);
+}
+
+TEST(gemm, aliasing)
+{
+  // c = c * b with c overlapping an operand
+  auto c = make_matrix<double>(6, 6, 1);
+  auto b = make_matrix<double>(6, 6, 2);
+  auto ref = ref_gemm(1., c, b, 0., c);
+  gt::gemm(1., c, b, 0., c);
+  expect_near(c, ref);
+}
+
+TEST(gemm, fusion_scope)
+{
+  auto a = make_matrix<double>(5, 4, 1);
+  auto b = make_matrix<double>(4, 3, 2);
+  gt::gtensor<double, 2> c(gt::shape(5, 3));
+  gt::gtensor<double, 2> a2 = a + a;
+  auto ref = ref_gemm(1., a2, b, 0., c);
+
+  // the operand expression is evaluated right away, not deferred
+  gt::fusion_scope fs;
+  gt::gemm(1., a + a, b, 0., c);
+  expect_near(c, ref);
+}
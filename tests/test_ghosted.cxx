@@ -0,0 +1,129 @@
+
+#include <gtest/gtest.h>
+
+#include <gtensor/ghosted.h>
+#include <gtensor/gtensor.h>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace gt::placeholders;
+
+TEST(ghosted, shapes)
+{
+  gt::ghosted_gtensor<double, 2> a(gt::shape(4, 3), gt::shape(2, 1));
+  EXPECT_EQ(a.shape(), gt::shape(4, 3));
+  EXPECT_EQ(a.ghosts(), gt::shape(2, 1));
+  EXPECT_EQ(a.storage().shape(), gt::shape(8, 5));
+  EXPECT_EQ(a.interior().shape(), gt::shape(4, 3));
+  EXPECT_EQ(a.halo(0, 0).shape(), gt::shape(2, 5));
+  EXPECT_EQ(a.halo(1, 1).shape(), gt::shape(8, 1));
+  EXPECT_EQ(a.face(1, 0).shape(), gt::shape(8, 1));
+  EXPECT_EQ(a.face_size(0), 10);
+  EXPECT_EQ(a.face_size(1), 8);
+
+  EXPECT_THROW(a.halo(2, 0), std::runtime_error);
+  EXPECT_THROW((gt::ghosted_gtensor<double, 1>(gt::shape(4), gt::shape(-1))),
+               std::runtime_error);
+}
+
+TEST(ghosted, interior_halo)
+{
+  gt::ghosted_gtensor<double, 2> a(gt::shape(3, 2), gt::shape(1, 2));
+  auto&& s = a.storage();
+  for (int j = 0; j < s.shape(1); j++) {
+    for (int i = 0; i < s.shape(0); i++) {
+      s(i, j) = 10 * i + j;
+    }
+  }
+
+  auto in = a.interior();
+  EXPECT_EQ(in(0, 0), 12.);
+  EXPECT_EQ(in(2, 1), 33.);
+
+  EXPECT_EQ(a.halo(0, 0)(0, 0), 0.);
+  EXPECT_EQ(a.halo(0, 1)(0, 3), 43.);
+  EXPECT_EQ(a.halo(1, 0)(2, 1), 21.);
+  EXPECT_EQ(a.halo(1, 1)(2, 0), 24.);
+  EXPECT_EQ(a.face(0, 0)(0, 2), 12.);
+  EXPECT_EQ(a.face(0, 1)(0, 2), 32.);
+  EXPECT_EQ(a.face(1, 0)(1, 1), 13.);
+  EXPECT_EQ(a.face(1, 1)(1, 0), 12.);
+
+  // writes through the views land in the storage
+  a.interior().view() = 0.;
+  EXPECT_EQ(s(1, 2), 0.);
+  EXPECT_EQ(s(0, 2), 2.);
+  EXPECT_EQ(s(1, 4), 14.);
+}
+
+void check_pack_unpack(const gt::shape_type<3>& shape,
+                       const gt::shape_type<3>& ghosts)
+{
+  gt::ghosted_gtensor<double, 3> a(shape, ghosts);
+  auto&& s = a.storage();
+  for (int k = 0; k < s.shape(2); k++) {
+    for (int j = 0; j < s.shape(1); j++) {
+      for (int i = 0; i < s.shape(0); i++) {
+        s(i, j, k) = i + 10 * j + 100 * k;
+      }
+    }
+  }
+
+  for (int d = 0; d < 3; d++) {
+    for (int side = 0; side < 2; side++) {
+      std::vector<double> buf(a.face_size(d));
+      a.pack(d, side, buf.data());
+
+      // the packed buffer is the face, in col-major order
+      auto face = a.face(d, side);
+      auto packed = a.packed(buf.data(), d);
+      EXPECT_EQ(packed.shape(), face.shape());
+      gt::gtensor<double, 3> ref = face;
+      for (int n = 0; n < int(buf.size()); n++) {
+        EXPECT_EQ(buf[n], ref.data()[n]);
+      }
+
+      // and unpacks into the halo
+      gt::ghosted_gtensor<double, 3> b(a.shape(), a.ghosts());
+      b.unpack(d, side, buf.data());
+      gt::gtensor<double, 3> halo = b.halo(d, side);
+      for (int n = 0; n < int(buf.size()); n++) {
+        EXPECT_EQ(halo.data()[n], buf[n]);
+      }
+    }
+  }
+}
+
+TEST(ghosted, pack_unpack)
+{
+  check_pack_unpack(gt::shape(4, 3, 5), gt::shape(1, 2, 2));
+  // a dimension of extent 1, which has stride 0
+  check_pack_unpack(gt::shape(4, 1, 5), gt::shape(1, 0, 2));
+  check_pack_unpack(gt::shape(1, 3, 5), gt::shape(0, 1, 1));
+}
+
+TEST(ghosted, periodic_exchange)
+{
+  const int n = 5, nghost = 2;
+  gt::ghosted_gtensor<double, 2> a(gt::shape(n, 3), gt::shape(nghost, 1));
+  auto in = a.interior();
+  for (int j = 0; j < 3; j++) {
+    for (int i = 0; i < n; i++) {
+      in(i, j) = i + 10 * j;
+    }
+  }
+
+  std::vector<double> buf(a.face_size(0));
+  a.pack(0, 0, buf.data());
+  a.unpack(0, 1, buf.data());
+  a.pack(0, 1, buf.data());
+  a.unpack(0, 0, buf.data());
+
+  auto&& s = a.storage();
+  for (int j = 0; j < 3; j++) {
+    for (int i = 0; i < n + 2 * nghost; i++) {
+      EXPECT_EQ(s(i, j + 1), (i - nghost + n) % n + 10 * j);
+    }
+  }
+}
@@ -0,0 +1,369 @@
+
+#include <gtest/gtest.h>
+
+// the double kernels, even where they wouldn't be used by default
+#define GTENSOR_MATH_DOUBLE_KERNELS 1
+#include <gtensor/gmath.h>
+#include <gtensor/gtensor.h>
+
+#include <cmath>
+#include <limits>
+
+using cdouble = gt::complex<double>;
+using cfloat = gt::complex<float>;
+
+template <typename T>
+gt::gtensor<T, 1> make_range(T lo, T hi, int n = 1001)
+{
+  gt::gtensor<T, 1> x(gt::shape(n));
+  for (int i = 0; i < n; i++) {
+    x(i) = lo + (hi - lo) * T(i) / T(n - 1);
+  }
+  return x;
+}
+
+// error of x in ulp of the reference, computed in long double
+template <typename T>
+double ulp_error(T x, long double ref)
+{
+  const T r = T(ref);
+  if (std::isinf(r) || std::isnan(r)) {
+    return (x == r || (std::isnan(x) && std::isnan(r))) ? 0. : 1e30;
+  }
+  const T ar = std::abs(r);
+  const T ulp = std::nextafter(ar, std::numeric_limits<T>::infinity()) - ar;
+  return double(std::abs((long double)x - ref) / ulp);
+}
+
+template <typename T, typename E, typename F>
+void expect_ulp(const gt::gtensor<T, 1>& x, const E& e, F&& ref, double tol)
+{
+  gt::gtensor<T, 1> y = e;
+  for (int i = 0; i < x.shape(0); i++) {
+    EXPECT_LE(ulp_error(y(i), ref((long double)x(i))), tol)
+      << "at " << x(i) << ": " << y(i);
+  }
+}
+
+TEST(gmath, lazy)
+{
+  auto x = make_range<double>(0., 1., 4);
+  auto e = gt::sqrt(gt::exp(x) + 1.);
+  static_assert(gt::is_expression<decltype(e)>::value, "");
+  static_assert(!std::is_same<decltype(e), gt::gtensor<double, 1>>::value,
+                "");
+  x(1) = 2.;
+  EXPECT_NEAR(e(1), std::sqrt(std::exp(2.) + 1.), 1e-15);
+  EXPECT_EQ(e.shape(), gt::shape(4));
+}
+
+TEST(gmath, real_double)
+{
+  auto x = make_range<double>(-700., 700.);
+  expect_ulp(x, gt::exp(x), [](long double v) { return std::exp(v); }, 1.5);
+  auto s = make_range<double>(-1e5, 1e5, 10001);
+  expect_ulp(s, gt::sin(s), [](long double v) { return std::sin(v); }, 2.5);
+  expect_ulp(s, gt::cos(s), [](long double v) { return std::cos(v); }, 2.5);
+  auto p = make_range<double>(1e-300, 1e300, 10001);
+  expect_ulp(p, gt::log(p), [](long double v) { return std::log(v); }, 1.);
+  expect_ulp(p, gt::sqrt(p), [](long double v) { return std::sqrt(v); },
+             1.);
+  auto q = make_range<double>(.25, 4.);
+  expect_ulp(q, gt::log(q), [](long double v) { return std::log(v); }, 1.);
+  expect_ulp(x, gt::abs(x), [](long double v) { return std::abs(v); }, 0.);
+}
+
+TEST(gmath, real_float)
+{
+  auto x = make_range<float>(-87.f, 88.f);
+  expect_ulp(x, gt::exp(x), [](long double v) { return std::exp(v); }, 1.5);
+  auto s = make_range<float>(-1e4f, 1e4f, 10001);
+  expect_ulp(s, gt::sin(s), [](long double v) { return std::sin(v); }, 1.);
+  expect_ulp(s, gt::cos(s), [](long double v) { return std::cos(v); }, 1.);
+  auto p = make_range<float>(1e-30f, 1e30f, 10001);
+  expect_ulp(p, gt::log(p), [](long double v) { return std::log(v); }, 1.);
+  expect_ulp(p, gt::sqrt(p), [](long double v) { return std::sqrt(v); },
+             1.);
+  expect_ulp(p, gt::pow(p, 1.3f),
+             [](long double v) { return std::pow(v, (long double)1.3f); },
+             1.);
+  using V = decltype(gt::exp(p))::value_type;
+  static_assert(std::is_same<V, float>::value, "");
+}
+
+TEST(gmath, special_values)
+{
+  const double inf = std::numeric_limits<double>::infinity();
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  gt::gtensor<double, 1> x{0., -0., inf, -inf, nan, -1.};
+  gt::gtensor<double, 1> ex = gt::exp(x), lg = gt::log(x), sq = gt::sqrt(x),
+                         sn = gt::sin(x), cs = gt::cos(x);
+  auto same = [](double a, double b) {
+    return (std::isnan(a) && std::isnan(b)) ||
+           (a == b && std::signbit(a) == std::signbit(b));
+  };
+  for (int i = 0; i < x.shape(0); i++) {
+    const double v = x(i);
+    EXPECT_TRUE(same(ex(i), std::exp(v))) << v;
+    EXPECT_TRUE(same(lg(i), std::log(v))) << v;
+    EXPECT_TRUE(same(sq(i), std::sqrt(v))) << v;
+    EXPECT_TRUE(same(sn(i), std::sin(v))) << v;
+    EXPECT_TRUE(same(cs(i), std::cos(v))) << v;
+  }
+
+  // over- and underflow, subnormal arguments and results
+  gt::gtensor<double, 1> big{800., -740., -745.};
+  gt::gtensor<double, 1> e = gt::exp(big);
+  EXPECT_EQ(e(0), inf);
+  EXPECT_LE(ulp_error(e(1), std::exp(-740.L)), 1.);
+  EXPECT_EQ(e(2), std::exp(-745.));
+  gt::gtensor<double, 1> d{1e-310};
+  gt::gtensor<double, 1> ld = gt::log(d), sd = gt::sqrt(d);
+  EXPECT_LE(ulp_error(ld(0), std::log((long double)1e-310)), 1.);
+  EXPECT_LE(ulp_error(sd(0), std::sqrt((long double)1e-310)), 1.);
+}
+
+TEST(gmath, sin_cos_large)
+{
+  auto sin_ref = [](long double v) { return std::sin(v); };
+  auto cos_ref = [](long double v) { return std::cos(v); };
+  // around where the reductions switch over, and beyond
+  auto l = make_range<double>(1e6, 1.1e6, 10001);
+  expect_ulp(l, gt::sin(l), sin_ref, 2.5);
+  expect_ulp(l, gt::cos(l), cos_ref, 2.5);
+  auto m = make_range<double>(-1e15, 1e15, 10001);
+  expect_ulp(m, gt::sin(m), sin_ref, 2.5);
+  expect_ulp(m, gt::cos(m), cos_ref, 2.5);
+  gt::gtensor<double, 1> h{1e20,  -1e20, 1e22, 1e100, 1e300,
+                           -1e300, std::numeric_limits<double>::max()};
+  expect_ulp(h, gt::sin(h), sin_ref, 2.5);
+  expect_ulp(h, gt::cos(h), cos_ref, 2.5);
+
+  const double inf = std::numeric_limits<double>::infinity();
+  gt::gtensor<double, 1> i{inf, -inf};
+  gt::gtensor<double, 1> si = gt::sin(i), ci = gt::cos(i);
+  for (int k = 0; k < 2; k++) {
+    EXPECT_TRUE(std::isnan(si(k)));
+    EXPECT_TRUE(std::isnan(ci(k)));
+  }
+
+  auto f = make_range<float>(-3e38f, 3e38f, 10001);
+  expect_ulp(f, gt::sin(f), sin_ref, 1.);
+  expect_ulp(f, gt::cos(f), cos_ref, 1.);
+
+  gt::gtensor<cdouble, 1> z{cdouble(0., 1e20), cdouble(1., -1e300)};
+  gt::gtensor<cdouble, 1> e = gt::exp(z);
+  for (int k = 0; k < 2; k++) {
+    const cdouble r = std::exp(z(k));
+    EXPECT_LE(std::abs(e(k) - r),
+              4 * std::numeric_limits<double>::epsilon() * std::abs(r));
+  }
+}
+
+TEST(gmath, pow)
+{
+  gt::gtensor<double, 1> x{2., -2., -2., -8., 0., 0., -0., 1., 4.};
+  gt::gtensor<double, 1> y{3., 3., -2., 1. / 3, -1., 0., 3., 1e300, .5};
+  gt::gtensor<double, 1> r = gt::pow(x, y);
+  for (int i = 0; i < x.shape(0); i++) {
+    const double ref = std::pow(x(i), y(i));
+    if (std::isnan(ref)) {
+      EXPECT_TRUE(std::isnan(r(i))) << i;
+    } else {
+      EXPECT_LE(ulp_error(r(i), std::pow((long double)x(i), y(i))), 4.) << i;
+      EXPECT_EQ(std::signbit(r(i)), std::signbit(ref)) << i;
+    }
+  }
+
+  auto b = make_range<double>(.01, 100.);
+  expect_ulp(b, gt::pow(b, 2.5),
+             [](long double v) { return std::pow(v, 2.5L); }, 20.);
+  expect_ulp(b, gt::pow(1.5, b),
+             [](long double v) { return std::pow(1.5L, v); }, 80.);
+  // int exponent
+  gt::gtensor<double, 1> sq = gt::pow(b, 2);
+  EXPECT_LE(ulp_error(sq(500), (long double)b(500) * b(500)), 4.);
+
+  // x in e^+-50, |y| < 10, and bases near 1 with |y log(x)| up to 700,
+  // against the documented bound
+  const int n = 2001;
+  gt::gtensor<double, 1> wx(gt::shape(2 * n)), wy(gt::shape(2 * n));
+  for (int i = 0; i < n; i++) {
+    wx(i) = std::exp(50. * std::sin(1.7 * i));
+    wy(i) = 10. * std::cos(2.3 * i);
+    wx(n + i) = 1. + .4 * std::sin(1.3 * i + .5);
+    wy(n + i) = 700. * std::cos(2.9 * i) / std::log(wx(n + i));
+  }
+  wx(0) = 88.994834037379434;
+  wy(0) = 3.7;
+  gt::gtensor<double, 1> wr = gt::pow(wx, wy);
+  for (int i = 0; i < 2 * n; i++) {
+    const long double ref = std::pow((long double)wx(i), (long double)wy(i));
+    const double t = std::abs(wy(i) * std::log(wx(i)));
+    EXPECT_LE(ulp_error(wr(i), ref), 1.3 + .002 * t)
+      << wx(i) << " ^ " << wy(i);
+  }
+}
+
+TEST(gmath, pow_int)
+{
+  gt::gtensor<double, 1> x{-3., -.5, 0., .5, 1.25, 2.};
+  gt::gtensor<double, 1> p3 = gt::pow<3>(x), p0 = gt::pow<0>(x),
+                         p1 = gt::pow<1>(x);
+  for (int i = 0; i < x.shape(0); i++) {
+    EXPECT_EQ(p3(i), x(i) * x(i) * x(i));
+    EXPECT_EQ(p0(i), 1.);
+    EXPECT_EQ(p1(i), x(i));
+  }
+  // all the ways through the power tree, and beyond it
+  gt::gtensor<double, 1> p15 = gt::pow<15>(x), p23 = gt::pow<23>(x),
+                         p100 = gt::pow<100>(x), pm2 = gt::pow<-2>(x);
+  for (int i = 0; i < x.shape(0); i++) {
+    const long double v = x(i);
+    EXPECT_LE(ulp_error(p15(i), std::pow(v, 15)), 8.) << x(i);
+    EXPECT_LE(ulp_error(p23(i), std::pow(v, 23)), 8.) << x(i);
+    EXPECT_LE(ulp_error(p100(i), std::pow(v, 100)), 16.) << x(i);
+    EXPECT_LE(ulp_error(pm2(i), std::pow(v, -2)), 2.) << x(i);
+  }
+
+  // exact for integers
+  gt::gtensor<int, 1> k{-3, 2, 7};
+  gt::gtensor<int, 1> k5 = gt::pow<5>(k);
+  EXPECT_EQ(k5, (gt::gtensor<int, 1>{-243, 32, 16807}));
+
+  gt::gtensor<cdouble, 1> z{cdouble(0., 1.), cdouble(1., 1.)};
+  gt::gtensor<cdouble, 1> z4 = gt::pow<4>(z);
+  EXPECT_EQ(z4(0), cdouble(1., 0.));
+  EXPECT_EQ(z4(1), cdouble(-4., 0.));
+
+  // lazy, a single node
+  auto e = gt::pow<2>(x + 1.);
+  x(0) = 1.;
+  EXPECT_EQ(e(0), 4.);
+}
+
+template <std::size_t N>
+void expect_polyval(const double (&c)[N])
+{
+  auto x = make_range<double>(-2., 2., 101);
+  gt::gtensor<double, 1> y = gt::polyval(c, x);
+  for (int i = 0; i < x.shape(0); i++) {
+    double ref = 0.;
+    for (std::size_t k = 0; k < N; k++) {
+      ref = ref * x(i) + c[k];
+    }
+    EXPECT_NEAR(y(i), ref, 1e-12 * std::max(std::abs(ref), 1.))
+      << N << " at " << x(i);
+  }
+}
+
+TEST(gmath, polyval)
+{
+  // Horner and Estrin, with degrees that split unevenly
+  expect_polyval({1.});
+  expect_polyval({1., -.5});
+  expect_polyval({1., -.5, .25});
+  expect_polyval({1., -.5, .25, 3.});
+  expect_polyval({1., -.5, .25, 3., -2.});
+  expect_polyval({1., -.5, .25, 3., -2., .125, 4.});
+  expect_polyval({1., -.5, .25, 3., -2., .125, 4., -1., .75});
+  expect_polyval({1., -.5, .25, 3., -2., .125, 4., -1., .75, 2., -3., .5});
+
+  auto x = make_range<double>(-1., 1., 11);
+  gt::gtensor<double, 1> ys =
+    gt::polyval(gt::sarray<double, 3>(2., 0., -1.), x);
+  gt::gtensor<double, 1> ref = 2. * x * x - 1.;
+  EXPECT_EQ(ys, ref);
+
+  // float argument, double coefficients: double result
+  gt::gtensor<float, 1> f{2.f};
+  auto pf = gt::polyval({1., 0., -1.}, f);
+  using V = decltype(pf)::value_type;
+  static_assert(std::is_same<V, double>::value, "");
+  EXPECT_EQ(pf(0), 3.);
+
+  // complex argument
+  gt::gtensor<cdouble, 1> z{cdouble(0., 1.)};
+  gt::gtensor<cdouble, 1> pz = gt::polyval({1., 0., 1.}, z);
+  EXPECT_EQ(pz(0), cdouble(0., 0.));
+}
+
+TEST(gmath, complex)
+{
+  gt::gtensor<cdouble, 1> z(gt::shape(400));
+  for (int i = 0; i < 400; i++) {
+    z(i) = cdouble(-10. + .05 * i, 7. - .035 * i);
+  }
+  auto check = [&](const gt::gtensor<cdouble, 1>& y, auto&& ref, double tol) {
+    for (int i = 0; i < 400; i++) {
+      const cdouble r = ref(z(i));
+      EXPECT_LE(std::abs(y(i) - r), tol * std::max(std::abs(r), 1.))
+        << "at " << z(i) << ": " << y(i) << " " << r;
+    }
+  };
+  const double eps = std::numeric_limits<double>::epsilon();
+  check(gt::exp(z), [](cdouble v) { return std::exp(v); }, 4 * eps);
+  check(gt::log(z), [](cdouble v) { return std::log(v); }, 4 * eps);
+  check(gt::sqrt(z), [](cdouble v) { return std::sqrt(v); }, 4 * eps);
+  check(gt::sin(z), [](cdouble v) { return std::sin(v); }, 8 * eps);
+  check(gt::cos(z), [](cdouble v) { return std::cos(v); }, 8 * eps);
+  check(gt::pow(z, cdouble(1.5, -.5)),
+        [](cdouble v) { return std::pow(v, cdouble(1.5, -.5)); }, 64 * eps);
+  // real exponent, complex result
+  check(gt::pow(z, 2.), [](cdouble v) { return v * v; }, 64 * eps);
+
+  gt::gtensor<double, 1> a = gt::abs(z), re = gt::real(z), im = gt::imag(z);
+  gt::gtensor<cdouble, 1> c = gt::conj(z);
+  for (int i = 0; i < 400; i++) {
+    EXPECT_LE(ulp_error(a(i), std::abs(std::complex<long double>(z(i)))), 3.);
+    EXPECT_EQ(re(i), z(i).real());
+    EXPECT_EQ(im(i), z(i).imag());
+    EXPECT_EQ(c(i), std::conj(z(i)));
+  }
+
+  // a negative real base, by way of the complex log
+  gt::gtensor<cdouble, 1> n{-4.};
+  gt::gtensor<cdouble, 1> rn = gt::sqrt(n);
+  EXPECT_EQ(rn(0), cdouble(0., 2.));
+  const cdouble p = gt::pow(gt::gtensor<double, 1>{-4.}, cdouble(.5))(0);
+  EXPECT_NEAR(p.real(), 0., 1e-15);
+  EXPECT_NEAR(p.imag(), 2., 1e-15);
+}
+
+TEST(gmath, real_imag_conj_of_real)
+{
+  gt::gtensor<float, 1> x{1.f, -2.f, 3.f};
+  gt::gtensor<float, 1> re = gt::real(x), im = gt::imag(x),
+                        c = gt::conj(x);
+  EXPECT_EQ(re, x);
+  EXPECT_EQ(c, x);
+  EXPECT_EQ(im, (gt::gtensor<float, 1>{0.f, 0.f, 0.f}));
+
+  gt::gtensor<cfloat, 1> z{cfloat(3.f, 4.f), cfloat(-1.f, 0.f)};
+  gt::gtensor<float, 1> az = gt::abs(z);
+  EXPECT_EQ(az, (gt::gtensor<float, 1>{5.f, 1.f}));
+}
+
+TEST(gmath, views_and_generic_types)
+{
+  gt::gtensor<double, 2> x(gt::shape(4, 3));
+  for (int i = 0; i < 12; i++) {
+    x.data()[i] = .25 * i;
+  }
+  auto v = x.view(gt::placeholders::_s(1, 3), gt::placeholders::_all);
+  gt::gtensor<double, 2> y = gt::exp(-v) * gt::cos(2. * v);
+  for (int j = 0; j < 3; j++) {
+    for (int i = 0; i < 2; i++) {
+      EXPECT_NEAR(y(i, j), std::exp(-v(i, j)) * std::cos(2. * v(i, j)),
+                  1e-15);
+    }
+  }
+
+  // non-float types go through the std:: functions
+  gt::gtensor<long double, 1> l{2.L};
+  gt::gtensor<long double, 1> el = gt::exp(l);
+  EXPECT_EQ(el(0), std::exp(2.L));
+  gt::gtensor<int, 1> k{-3, 4};
+  gt::gtensor<int, 1> ak = gt::abs(k);
+  EXPECT_EQ(ak, (gt::gtensor<int, 1>{3, 4}));
+}
@@ -151,6 +151,39 @@ TEST(gtensor, assign_expression_2d_resize)
   EXPECT_EQ(b, (gt::gtensor<double, 2>{{22., 24., 26.}, {42., 44., 46.}}));
 }
 
+TEST(gtensor, compound_assign)
+{
+  gt::gtensor<double, 2> a{{11., 12., 13.}, {21., 22., 23.}};
+  gt::gtensor<double, 2> b{{1., 2., 3.}, {4., 5., 6.}};
+
+  a += b;
+  EXPECT_EQ(a, (gt::gtensor<double, 2>{{12., 14., 16.}, {25., 27., 29.}}));
+  a -= 2. * b;
+  EXPECT_EQ(a, (gt::gtensor<double, 2>{{10., 10., 10.}, {17., 17., 17.}}));
+  a *= 2.;
+  EXPECT_EQ(a, (gt::gtensor<double, 2>{{20., 20., 20.}, {34., 34., 34.}}));
+  a /= 2;
+  EXPECT_EQ(a, (gt::gtensor<double, 2>{{10., 10., 10.}, {17., 17., 17.}}));
+  a -= 10.;
+  EXPECT_EQ(a, (gt::gtensor<double, 2>{{0., 0., 0.}, {7., 7., 7.}}));
+}
+
+TEST(gtensor, compound_assign_view)
+{
+  using namespace gt::placeholders;
+
+  gt::gtensor<double, 2> a{{11., 12., 13.}, {21., 22., 23.}};
+  gt::gtensor<double, 1> b{1., 2.};
+
+  // broadcast b along the row
+  a.view(_s(1, _), _all) *= b.view(_newaxis, _all);
+  EXPECT_EQ(a, (gt::gtensor<double, 2>{{11., 12., 13.}, {21., 44., 46.}}));
+
+  auto v = gt::adapt<1>(a.data(), gt::shape(3));
+  v += 1.;
+  EXPECT_EQ(a, (gt::gtensor<double, 2>{{12., 13., 14.}, {21., 44., 46.}}));
+}
+
 #ifdef GTENSOR_HAVE_DEVICE
 
 TEST(gtensor, device_assign_gtensor)
@@ -21,3 +21,32 @@ TEST(helper, tuple_max)
   EXPECT_EQ(gt::helper::max(id, t3), 15);
   EXPECT_EQ(gt::helper::max(id, t3a), 25);
 }
+
+TEST(helper, fast_divider)
+{
+  const std::uint32_t divisors[] = {1, 2, 3, 5, 7, 16, 17, 100, 641, 65536,
+                                    65537, 123456789, 0x7fffffff, 0x80000000,
+                                    0x80000001, 0xffffffff};
+  const std::uint32_t numerators[] = {0,          1,          2,
+                                      3,          99,         100,
+                                      101,        65535,      65536,
+                                      1234567891, 0x7fffffff, 0x80000000,
+                                      0xfffffffe, 0xffffffff};
+  for (auto d : divisors) {
+    gt::fast_divider div(d);
+    for (auto n : numerators) {
+      EXPECT_EQ(n / div, n / d) << "n = " << n << " d = " << d;
+    }
+  }
+  EXPECT_EQ(42u / gt::fast_divider(0), 0u);
+}
+
+TEST(helper, unravel_fast_divider)
+{
+  auto shape = gt::shape(3, 1, 4, 5);
+  auto strides = gt::calc_strides(shape);
+  auto div = gt::make_dividers<4>(strides);
+  for (int i = 0; i < int(gt::calc_size(shape)); i++) {
+    EXPECT_EQ(gt::unravel<gt::shape_type<4>>(i, div), gt::unravel(i, strides));
+  }
+}
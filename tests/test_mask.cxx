@@ -0,0 +1,355 @@
+
+#include <gtest/gtest.h>
+
+#include <gtensor/gtensor.h>
+#include <gtensor/mask.h>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace gt::placeholders;
+
+TEST(mask, comparisons)
+{
+  gt::gtensor<double, 1> x{-2., -1., 0., 1., 2.};
+  gt::gtensor<double, 1> y{2., -1., 1., 1., -2.};
+
+  auto lt = x < y;
+  static_assert(gt::is_expression<decltype(lt)>::value, "");
+  using V = decltype(lt)::value_type;
+  static_assert(std::is_same<V, bool>::value, "");
+
+  // masks are stored as char or int: gtensor<bool> would be std::vector<bool>
+  gt::gtensor<char, 1> m = x < y;
+  EXPECT_EQ(m, (gt::gtensor<char, 1>{1, 0, 1, 0, 0}));
+  m = x <= y;
+  EXPECT_EQ(m, (gt::gtensor<char, 1>{1, 1, 1, 1, 0}));
+  m = x > 0.;
+  EXPECT_EQ(m, (gt::gtensor<char, 1>{0, 0, 0, 1, 1}));
+  m = 0. >= x;
+  EXPECT_EQ(m, (gt::gtensor<char, 1>{1, 1, 1, 0, 0}));
+  m = gt::equal(x, y);
+  EXPECT_EQ(m, (gt::gtensor<char, 1>{0, 1, 0, 1, 0}));
+  m = gt::not_equal(x, 0.);
+  EXPECT_EQ(m, (gt::gtensor<char, 1>{1, 1, 0, 1, 1}));
+
+  // == and != still compare whole arrays
+  EXPECT_TRUE(x == x);
+  EXPECT_TRUE(x != y);
+
+  // lazy
+  x(0) = 5.;
+  EXPECT_FALSE(lt(0));
+}
+
+TEST(mask, logical)
+{
+  gt::gtensor<int, 1> x{-2, -1, 0, 1, 2};
+  gt::gtensor<int, 1> m = (x > -2) && (x < 2);
+  EXPECT_EQ(m, (gt::gtensor<int, 1>{0, 1, 1, 1, 0}));
+  m = (x < -1) || (x > 1);
+  EXPECT_EQ(m, (gt::gtensor<int, 1>{1, 0, 0, 0, 1}));
+  m = !(x < 0);
+  EXPECT_EQ(m, (gt::gtensor<int, 1>{0, 0, 1, 1, 1}));
+  // non-bool operands count as true when nonzero
+  m = gt::logical_and(x, true);
+  EXPECT_EQ(m, (gt::gtensor<int, 1>{1, 1, 0, 1, 1}));
+  m = gt::logical_or(x, x > 5);
+  EXPECT_EQ(m, (gt::gtensor<int, 1>{1, 1, 0, 1, 1}));
+}
+
+TEST(mask, where)
+{
+  gt::gtensor<double, 2> x(gt::shape(3, 2));
+  for (int i = 0; i < 6; i++) {
+    x.data()[i] = i - 2.5;
+  }
+  // a limiter: clip to [-1, 1]
+  gt::gtensor<double, 2> y =
+    gt::where(x < -1., -1., gt::where(x > 1., 1., x));
+  for (int j = 0; j < 2; j++) {
+    for (int i = 0; i < 3; i++) {
+      EXPECT_EQ(y(i, j), std::max(-1., std::min(1., x(i, j))));
+    }
+  }
+
+  // with a stored mask, broadcasting
+  gt::gtensor<char, 2> m{{1, 0, 1}};
+  gt::gtensor<double, 2> z = gt::where(m, x, 2. * x);
+  for (int j = 0; j < 2; j++) {
+    for (int i = 0; i < 3; i++) {
+      EXPECT_EQ(z(i, j), m(i, 0) ? x(i, j) : 2. * x(i, j));
+    }
+  }
+
+  // common type of the two branches
+  gt::gtensor<int, 1> k{1, -2, 3};
+  auto w = gt::where(k > 0, k, 0.5);
+  using V = decltype(w)::value_type;
+  static_assert(std::is_same<V, double>::value, "");
+  EXPECT_EQ(w(1), .5);
+  EXPECT_EQ(w(2), 3.);
+
+  // a boundary treatment on a view
+  gt::gtensor<double, 1> f{1., 2., 3., 4., 5.};
+  auto inner = f.view(_s(1, -1));
+  inner = gt::where(inner > 2.5, inner - 10., inner);
+  EXPECT_EQ(f, (gt::gtensor<double, 1>{1., 2., -7., -6., 5.}));
+}
+
+TEST(mask, any_all)
+{
+  gt::gtensor<double, 1> x{-2., -1., 0., 1., 2.};
+  EXPECT_TRUE(gt::any(x > 1.));
+  EXPECT_FALSE(gt::any(x > 2.));
+  EXPECT_TRUE(gt::all(x >= -2.));
+  EXPECT_FALSE(gt::all(x > -2.));
+  EXPECT_TRUE(gt::any(x));
+  EXPECT_FALSE(gt::all(x));
+
+  // empty
+  gt::gtensor<double, 1> e(gt::shape(0));
+  EXPECT_FALSE(gt::any(e > 0.));
+  EXPECT_TRUE(gt::all(e > 0.));
+}
+
+TEST(mask, any_all_big)
+{
+  // enough to be split across threads, and multi-d, on a view
+  gt::gtensor<double, 3> x(gt::shape(129, 70, 65));
+  for (int i = 0; i < int(x.size()); i++) {
+    x.data()[i] = i % 1000;
+  }
+  EXPECT_TRUE(gt::all(x >= 0.));
+  EXPECT_FALSE(gt::any(x < 0.));
+  x(128, 3, 64) = -1.;
+  EXPECT_TRUE(gt::any(x < 0.));
+  EXPECT_FALSE(gt::all(x >= 0.));
+  x(128, 3, 64) = 0.;
+  x(0, 0, 0) = -1.;
+  EXPECT_TRUE(gt::any(x < 0.));
+
+  auto v = x.view(_s(1, _), _all, _s(_, _, 2));
+  EXPECT_TRUE(gt::all(v >= 0.));
+  x(5, 69, 64) = -3.;
+  EXPECT_FALSE(gt::all(v >= 0.));
+  EXPECT_TRUE(gt::any(gt::equal(v, v) && v < -2.));
+}
+
+TEST(mask, compress)
+{
+  gt::gtensor<double, 2> x(gt::shape(3, 4));
+  for (int i = 0; i < 12; i++) {
+    x.data()[i] = (i * 7) % 12 - 5.5;
+  }
+  auto c = gt::compress(x > 0., x);
+  std::vector<double> r;
+  for (int i = 0; i < 12; i++) {
+    if (x.data()[i] > 0.) {
+      r.push_back(x.data()[i]);
+    }
+  }
+  ASSERT_EQ(c.shape(), gt::shape(int(r.size())));
+  for (int i = 0; i < int(r.size()); i++) {
+    EXPECT_EQ(c(i), r[i]);
+  }
+
+  // a stored mask, an expression to select from
+  gt::gtensor<char, 2> m = x < -4.;
+  auto c2 = gt::compress(m, 2. * x);
+  EXPECT_EQ(c2, (gt::gtensor<double, 1>{-11., -9.}));
+
+  // none selected
+  EXPECT_EQ(gt::compress(x > 10., x).shape(), gt::shape(0));
+
+  EXPECT_THROW(gt::compress(m.view(_s(0, 2), _all), x), std::runtime_error);
+}
+
+TEST(mask, nonzero)
+{
+  gt::gtensor<int, 2> m(gt::shape(3, 4));
+  m.view() = 0;
+  m(1, 0) = 1;
+  m(2, 2) = 5;
+  m(0, 3) = -1;
+  auto idx = gt::nonzero(m);
+  EXPECT_EQ(idx[0], (gt::gtensor<int, 1>{1, 2, 0}));
+  EXPECT_EQ(idx[1], (gt::gtensor<int, 1>{0, 2, 3}));
+
+  gt::gtensor<double, 1> x{0., 1., 0., 2.};
+  auto i1 = gt::nonzero(x);
+  EXPECT_EQ(i1[0], (gt::gtensor<int, 1>{1, 3}));
+}
+
+TEST(mask, masked)
+{
+  gt::gtensor<double, 1> x{-2., -1., 0., 1., 2.};
+  gt::masked(x, x < 0.) = 0.;
+  EXPECT_EQ(x, (gt::gtensor<double, 1>{0., 0., 0., 1., 2.}));
+
+  // elementwise from a same-shaped rhs
+  gt::gtensor<double, 1> y{10., 20., 30., 40., 50.};
+  gt::masked(x, x > 0.) = y + 1.;
+  EXPECT_EQ(x, (gt::gtensor<double, 1>{0., 0., 0., 41., 51.}));
+
+  // scattered from a packed rhs
+  gt::gtensor<char, 1> m{1, 0, 1, 0, 0};
+  gt::masked(x, m) = gt::gtensor<double, 1>{7., 8.};
+  EXPECT_EQ(x, (gt::gtensor<double, 1>{7., 0., 8., 41., 51.}));
+  EXPECT_THROW(gt::masked(x, m) = (gt::gtensor<double, 1>{1., 2., 3.}),
+               std::runtime_error);
+
+  // on a view, 2-d, and round trip through compress
+  gt::gtensor<double, 2> a(gt::shape(4, 3));
+  for (int i = 0; i < 12; i++) {
+    a.data()[i] = i;
+  }
+  auto v = a.view(_s(1, _), _all);
+  gt::gtensor<char, 2> even(v.shape());
+  for (int j = 0; j < 3; j++) {
+    for (int i = 0; i < 3; i++) {
+      even(i, j) = int(v(i, j)) % 2 == 0;
+    }
+  }
+  gt::masked(v, even) = -gt::compress(even, v);
+  for (int j = 0; j < 3; j++) {
+    for (int i = 0; i < 4; i++) {
+      const double ref = i + 4 * j;
+      const double expect = (i > 0 && int(ref) % 2 == 0) ? -ref : ref;
+      EXPECT_EQ(a(i, j), expect) << i << ", " << j;
+    }
+  }
+  // 2-d lhs, broadcast rhs
+  // a(_all, 1) is now {4, 5, -6, 7}, a(_all, 2) {8, 9, -10, 11}
+  gt::masked(a, a > 6.) = gt::gtensor<double, 2>{{100., 200., 300., 400.}};
+  EXPECT_EQ(a.view(_all, 1), (gt::gtensor<double, 1>{4., 5., -6., 400.}));
+  EXPECT_EQ(a.view(_all, 2), (gt::gtensor<double, 1>{100., 200., -10., 400.}));
+}
+
+TEST(mask, big)
+{
+  // enough to be split into many slabs
+  gt::gtensor<double, 3> x(gt::shape(100, 50, 40));
+  for (int i = 0; i < int(x.size()); i++) {
+    x.data()[i] = (i * 7919) % 1000;
+  }
+  auto m = x < 100.;
+  auto c = gt::compress(m, x);
+  auto idx = gt::nonzero(m);
+  int n = 0;
+  for (int i = 0; i < int(x.size()); i++) {
+    n += x.data()[i] < 100.;
+  }
+  ASSERT_EQ(c.shape(0), n);
+  for (int i = 0; i < n; i++) {
+    ASSERT_EQ(c(i), x(idx[0](i), idx[1](i), idx[2](i)));
+    ASSERT_LT(c(i), 100.);
+  }
+  for (int i = 1; i < n; i++) {
+    const int l0 = idx[0](i - 1) + 100 * (idx[1](i - 1) + 50 * idx[2](i - 1));
+    const int l1 = idx[0](i) + 100 * (idx[1](i) + 50 * idx[2](i));
+    ASSERT_LT(l0, l1);
+  }
+
+  gt::masked(x, m) = c + 1000.;
+  EXPECT_TRUE(gt::all(x >= 100.));
+  EXPECT_EQ(gt::compress(x >= 1000., x), c + 1000.);
+}
+
+// compress, nonzero and masked of x < 100., checked against a plain loop
+template <typename S>
+void check_mask_shape(const S& shape)
+{
+  gt::gtensor<double, 3> x(shape);
+  for (int i = 0; i < int(x.size()); i++) {
+    x.data()[i] = (i * 7919) % 1000;
+  }
+  auto m = x < 100.;
+  std::vector<double> ref;
+  for (int i = 0; i < int(x.size()); i++) {
+    if (x.data()[i] < 100.) {
+      ref.push_back(x.data()[i]);
+    }
+  }
+  auto c = gt::compress(m, x);
+  auto idx = gt::nonzero(m);
+  ASSERT_EQ(c.shape(0), int(ref.size()));
+  for (int i = 0; i < int(ref.size()); i++) {
+    ASSERT_EQ(c(i), ref[i]) << i;
+    ASSERT_EQ(x(idx[0](i), idx[1](i), idx[2](i)), ref[i]) << i;
+  }
+  EXPECT_TRUE(gt::any(gt::equal(x, 999.)));
+  EXPECT_FALSE(gt::all(x < 999.));
+
+  gt::masked(x, m) = c + 1000.;
+  EXPECT_TRUE(gt::all(x >= 100.));
+  EXPECT_EQ(gt::compress(x >= 1000., x), c + 1000.);
+}
+
+TEST(mask, thin_outer)
+{
+  // a small outermost dimension doesn't keep the work from being split
+  // into many slabs, whose runs may cross into the next column
+  EXPECT_GE(gt::detail::mask_slabs(gt::shape(100000, 1)).n, 24);
+  EXPECT_GE(gt::detail::mask_slabs(gt::shape(100000, 2)).n, 48);
+  EXPECT_EQ(gt::detail::mask_slabs(gt::shape(64, 64, 64)).dim, 2);
+
+  check_mask_shape(gt::shape(20001, 1, 1));
+  check_mask_shape(gt::shape(5000, 3, 2));
+  check_mask_shape(gt::shape(1000, 7, 3));
+  check_mask_shape(gt::shape(1, 30000, 1));
+
+  gt::gtensor<double, 2> y(gt::shape(20000, 3));
+  for (int i = 0; i < int(y.size()); i++) {
+    y.data()[i] = (i * 7919) % 1000;
+  }
+  auto v = y.view(_s(1, _), _s(_, _, 2));
+  std::vector<double> ref;
+  for (int j = 0; j < v.shape(1); j++) {
+    for (int i = 0; i < v.shape(0); i++) {
+      if (v(i, j) < 100.) {
+        ref.push_back(v(i, j));
+      }
+    }
+  }
+  auto c = gt::compress(v < 100., v);
+  ASSERT_EQ(c.shape(0), int(ref.size()));
+  for (int i = 0; i < int(ref.size()); i++) {
+    ASSERT_EQ(c(i), ref[i]) << i;
+  }
+}
+
+gt::gtensor<char, 1> make_mask(int n)
+{
+  gt::gtensor<char, 1> m(gt::shape(n));
+  for (int i = 0; i < n; i++) {
+    m(i) = i % 3 == 0;
+  }
+  return m;
+}
+
+TEST(mask, masked_fusion_scope)
+{
+  // the mask is held by the proxy, which is gone by the end of the scope
+  const int n = 1000;
+  gt::gtensor<double, 1> x(gt::shape(n)), y(gt::shape(n));
+  for (int i = 0; i < n; i++) {
+    x(i) = 1.;
+    y(i) = i;
+  }
+  {
+    gt::fusion_scope fs;
+    x = 2. * x;
+    gt::masked(x, make_mask(n)) = 5.;
+    gt::masked(y, make_mask(n)) = x + 1.;
+    // memory that the masks' storage is likely reused for
+    gt::gtensor<char, 1> junk(gt::shape(n));
+    for (int i = 0; i < n; i++) {
+      junk(i) = 0;
+    }
+  }
+  for (int i = 0; i < n; i++) {
+    EXPECT_EQ(x(i), i % 3 == 0 ? 5. : 2.) << i;
+    EXPECT_EQ(y(i), i % 3 == 0 ? 6. : double(i)) << i;
+  }
+}
@@ -0,0 +1,113 @@
+
+#include <gtest/gtest.h>
+
+#include <gtensor/gtensor.h>
+
+#include <stdexcept>
+
+using namespace gt::placeholders;
+
+TEST(stencil, stencil_1d)
+{
+  gt::gtensor<double, 1> y{1., 4., 9., 16., 25.};
+  gt::sarray<double, 3> c(-.5, 0., .5);
+
+  auto s = gt::stencil(y, c);
+  EXPECT_EQ(s.shape(), gt::shape(3));
+  EXPECT_EQ(s(0), 4.);
+
+  gt::gtensor<double, 1> dydx = s / .5;
+  EXPECT_EQ(dydx, (gt::gtensor<double, 1>{8., 12., 16.}));
+  gt::gtensor<double, 1> ref = c[0] * y.view(_s(0, -2)) +
+                               c[1] * y.view(_s(1, -1)) +
+                               c[2] * y.view(_s(2, _));
+  EXPECT_EQ((gt::gtensor<double, 1>(gt::stencil(y, c))), ref);
+}
+
+TEST(stencil, coeffs_array)
+{
+  gt::gtensor<double, 1> y{1., 4., 9., 16., 25.};
+  gt::gtensor<double, 1> c{1., -2., 1.};
+
+  gt::gtensor<double, 1> d2y = gt::stencil<3>(y, c);
+  EXPECT_EQ(d2y, (gt::gtensor<double, 1>{2., 2., 2.}));
+  EXPECT_THROW(gt::stencil<5>(y, c), std::runtime_error);
+}
+
+TEST(stencil, stencil_2d_axis)
+{
+  gt::gtensor<double, 2> a{{11., 12., 13.}, {21., 22., 23.}, {31., 32., 33.}};
+  gt::sarray<double, 2> c(-1., 1.);
+
+  gt::gtensor<double, 2> d0 = gt::stencil(a, c, 0);
+  EXPECT_EQ(d0, (gt::gtensor<double, 2>{{1., 1.}, {1., 1.}, {1., 1.}}));
+  gt::gtensor<double, 2> d1 = gt::stencil(a, c, 1);
+  EXPECT_EQ(d1, (gt::gtensor<double, 2>{{10., 10., 10.}, {10., 10., 10.}}));
+
+  EXPECT_THROW(gt::stencil(a, c, 2), std::runtime_error);
+  EXPECT_THROW(gt::stencil(a, gt::sarray<double, 4>(1., 1., 1., 1.), 1),
+               std::runtime_error);
+}
+
+TEST(stencil, stencil_4d)
+{
+  gt::gtensor<double, 4> a(gt::shape(3, 4, 5, 6));
+  for (int l = 0; l < 6; l++) {
+    for (int k = 0; k < 5; k++) {
+      for (int j = 0; j < 4; j++) {
+        for (int i = 0; i < 3; i++) {
+          a(i, j, k, l) = i + 10 * j + 100 * k * k + 1000 * l;
+        }
+      }
+    }
+  }
+
+  // second derivative of 100 k^2 along axis 2, strided and through the
+  // generic (index) path
+  gt::sarray<double, 3> c(1., -2., 1.);
+  gt::gtensor<double, 4> d2 = gt::stencil(a, c, 2);
+  gt::gtensor<double, 4> d2_expr = gt::stencil(a + 0., c, 2);
+  EXPECT_EQ(d2.shape(), gt::shape(3, 4, 3, 6));
+  for (int l = 0; l < 6; l++) {
+    for (int k = 0; k < 3; k++) {
+      for (int j = 0; j < 4; j++) {
+        for (int i = 0; i < 3; i++) {
+          EXPECT_EQ(d2(i, j, k, l), 200.);
+          EXPECT_EQ(d2_expr(i, j, k, l), 200.);
+        }
+      }
+    }
+  }
+}
+
+TEST(stencil, view)
+{
+  gt::gtensor<double, 2> a{{11., 12., 13.}, {21., 22., 23.}, {31., 32., 33.}};
+  gt::sarray<double, 2> c(.5, .5);
+
+  gt::gtensor<double, 1> avg = gt::stencil(a.view(1, _all), c);
+  EXPECT_EQ(avg, (gt::gtensor<double, 1>{17., 27.}));
+}
+
+TEST(stencil, broadcast)
+{
+  gt::gtensor<double, 2> e{
+    {1., 2., 3.}, {4., 5., 6.}, {7., 8., 9.}, {1., 0., 1.}};
+  gt::gtensor<double, 2> x(gt::shape(5, 4));
+  for (int j = 0; j < 4; j++) {
+    for (int i = 0; i < 5; i++) {
+      x(i, j) = 10. * i;
+    }
+  }
+
+  // shape (1, 4), broadcast along the first dimension
+  auto s = gt::stencil(e, gt::sarray<double, 3>(1., 1., 1.), 0);
+  EXPECT_EQ(s.shape(), gt::shape(1, 4));
+  gt::gtensor<double, 2> y = x + s;
+  for (int j = 0; j < 4; j++) {
+    for (int i = 0; i < 5; i++) {
+      EXPECT_EQ(y(i, j), 10. * i + e(0, j) + e(1, j) + e(2, j));
+    }
+  }
+  EXPECT_EQ(s(3, 1), s(0, 1));
+}
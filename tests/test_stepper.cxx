@@ -0,0 +1,116 @@
+
+#include <gtest/gtest.h>
+
+#include <gtensor/gtensor.h>
+
+using namespace gt::placeholders;
+
+TEST(stepper, strided)
+{
+  gt::gtensor<double, 2> a{{11., 12., 13.}, {21., 22., 23.}};
+  auto shape = a.shape();
+
+  auto st = gt::detail::make_stepper(a, shape);
+  EXPECT_EQ(*st, 11.);
+  st.step<0>();
+  EXPECT_EQ(*st, 12.);
+  st.step<1>();
+  EXPECT_EQ(*st, 22.);
+  st.step<0>();
+  st.step<0>();
+  st.reset<0>();
+  EXPECT_EQ(*st, 21.);
+}
+
+TEST(stepper, boundscheck_level)
+{
+  gt::gtensor<double, 2> a(gt::shape(2, 3));
+  using stepper_type = decltype(gt::detail::make_stepper(a, a.shape()));
+  using index_stepper_type =
+    gt::detail::index_stepper<gt::gtensor<double, 2>, 2>;
+
+  // at level 2, every access goes through the checked a(i, j)
+  EXPECT_EQ((std::is_same<stepper_type, index_stepper_type>::value),
+            GTENSOR_BOUNDSCHECK_LEVEL >= 2);
+}
+
+TEST(stepper, function)
+{
+  gt::gtensor<double, 2> a{{11., 12., 13.}, {21., 22., 23.}};
+  auto e = 2. * a.view(_s(1, _), _all);
+
+  auto st = gt::detail::make_stepper(e, e.shape());
+  EXPECT_EQ(*st, 24.);
+  st.step<1>();
+  EXPECT_EQ(*st, 44.);
+}
+
+TEST(stepper, advance)
+{
+  gt::gtensor<double, 2> a{{11., 12., 13.}, {21., 22., 23.}};
+  auto e = a + 1.;
+
+  auto st = gt::detail::make_stepper(e, e.shape());
+  st.advance<0>(2);
+  EXPECT_EQ(*st, 14.);
+  st.advance<1>(1);
+  EXPECT_EQ(*st, 24.);
+  // past the end of the sweep, and back
+  st.advance<0>(1);
+  st.reset<0>();
+  EXPECT_EQ(*st, 22.);
+}
+
+TEST(stepper, assign_4d)
+{
+  auto shape = gt::shape(2, 3, 4, 5);
+  auto a = gt::generator<4, double>(
+    shape, [](int i, int j, int k, int l) { return i + 10 * j + 100 * k + 1000 * l; });
+  gt::gtensor<double, 4> b = a;
+  EXPECT_EQ(b.shape(), shape);
+  EXPECT_EQ(b(1, 2, 3, 4), 4321.);
+}
+
+TEST(stepper, assign_5d)
+{
+  gt::gtensor<double, 5> a(gt::shape(2, 3, 4, 5, 6));
+  a.view(_all, _all, _all, _all, _all) = 3.;
+  gt::gtensor<double, 5> b = a + a;
+  EXPECT_EQ(b(1, 2, 3, 4, 5), 6.);
+}
+
+TEST(stepper, assign_6d_view)
+{
+  gt::gtensor<double, 6> a(gt::shape(4, 3, 2, 3, 2, 3));
+  auto gen = gt::generator<6, double>(
+    a.shape(), [](int i, int j, int k, int l, int m, int n) {
+      return i + 10 * j + 100 * k + 1000 * l + 10000 * m + 100000 * n;
+    });
+  a = gen;
+
+  gt::gtensor<double, 6> b(gt::shape(2, 3, 2, 3, 2, 1));
+  b = a.view(_s(1, _, 2), _all, _all, _all, _all, _s(2, 3)) +
+      a.view(_s(0, 2), _s(_, _, -1), _all, _all, _all, _s(0, 1));
+  for (int m = 0; m < 2; m++) {
+    for (int l = 0; l < 3; l++) {
+      for (int k = 0; k < 2; k++) {
+        for (int j = 0; j < 3; j++) {
+          for (int i = 0; i < 2; i++) {
+            EXPECT_EQ(b(i, j, k, l, m, 0),
+                      a(1 + 2 * i, j, k, l, m, 2) + a(i, 2 - j, k, l, m, 0));
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(stepper, assign_broadcast)
+{
+  gt::gtensor<double, 2> a{{11., 12., 13.}, {21., 22., 23.}};
+  gt::gtensor<double, 1> b = {100., 101., 102.};
+  gt::gtensor<double, 2> c(a.shape());
+
+  c = a + b.view(_all, _newaxis);
+  EXPECT_EQ(c, (gt::gtensor<double, 2>{{111., 113., 115.}, {121., 123., 125.}}));
+}
@@ -0,0 +1,131 @@
+
+#include <gtest/gtest.h>
+
+#include <gtensor/gtensor.h>
+#include <gtensor/stream.h>
+
+#include <cstdio>
+
+namespace
+{
+
+std::string temp_filename(const std::string& name)
+{
+  return ::testing::TempDir() + "gtensor_test_stream_" + name;
+}
+
+template <typename T, int N>
+void write_file(const std::string& filename, const gt::gtensor<T, N>& a)
+{
+  gt::file_sink<T, N> sink(filename, a.shape());
+  sink.write(0, a.shape(N - 1), a);
+}
+
+template <typename T, int N>
+gt::gtensor<T, N> read_file(const std::string& filename,
+                            const gt::shape_type<N>& shape)
+{
+  gt::gtensor<T, N> a;
+  gt::file_source<T, N> source(filename, shape);
+  source.read(0, shape[N - 1], a);
+  return a;
+}
+
+} // namespace
+
+TEST(stream, file_roundtrip)
+{
+  gt::gtensor<double, 2> a{{11., 12., 13.}, {21., 22., 23.}};
+  auto filename = temp_filename("roundtrip");
+
+  write_file(filename, a);
+  EXPECT_EQ((read_file<double, 2>(filename, a.shape())), a);
+
+  gt::gtensor<double, 2> chunk;
+  gt::file_source<double, 2> source(filename, a.shape());
+  source.read(1, 2, chunk);
+  EXPECT_EQ(chunk, (gt::gtensor<double, 2>{{21., 22., 23.}}));
+
+  std::remove(filename.c_str());
+}
+
+TEST(stream, stream_eval)
+{
+  auto shape = gt::shape(3, 4, 10);
+  gt::gtensor<double, 3> a(shape), b(shape);
+  for (int k = 0; k < shape[2]; k++) {
+    for (int j = 0; j < shape[1]; j++) {
+      for (int i = 0; i < shape[0]; i++) {
+        a(i, j, k) = i + 10 * j + 100 * k;
+        b(i, j, k) = -k;
+      }
+    }
+  }
+  auto filename_a = temp_filename("a");
+  auto filename_b = temp_filename("b");
+  auto filename_c = temp_filename("c");
+  write_file(filename_a, a);
+  write_file(filename_b, b);
+
+  {
+    gt::file_source<double, 3> src_a(filename_a, shape);
+    gt::file_source<double, 3> src_b(filename_b, shape);
+    gt::file_sink<double, 3> sink(filename_c, shape);
+
+    // chunk size does not evenly divide the outermost dimension
+    gt::stream_eval(
+      sink, 3, [](auto& a, auto& b) { return a + 2. * b; }, src_a, src_b);
+  }
+
+  gt::gtensor<double, 3> c_ref = a + 2. * b;
+  auto c = read_file<double, 3>(filename_c, shape);
+  EXPECT_EQ(c.shape(), c_ref.shape());
+  for (int k = 0; k < shape[2]; k++) {
+    for (int j = 0; j < shape[1]; j++) {
+      for (int i = 0; i < shape[0]; i++) {
+        EXPECT_EQ(c(i, j, k), c_ref(i, j, k));
+      }
+    }
+  }
+
+  std::remove(filename_a.c_str());
+  std::remove(filename_b.c_str());
+  std::remove(filename_c.c_str());
+}
+
+TEST(stream, shape_mismatch)
+{
+  auto filename = temp_filename("mismatch");
+  write_file(filename, gt::gtensor<double, 1>{1., 2., 3.});
+
+  gt::file_source<double, 1> src(filename, gt::shape(3));
+  gt::file_sink<double, 1> sink(temp_filename("mismatch_out"), gt::shape(4));
+  EXPECT_THROW(gt::stream_eval(
+                 sink, 2, [](auto& a) { return 2. * a; }, src),
+               std::runtime_error);
+
+  std::remove(filename.c_str());
+  std::remove(temp_filename("mismatch_out").c_str());
+}
+
+TEST(stream, stream_eval_in_fusion_scope)
+{
+  gt::gtensor<double, 1> a{1., 2., 3., 4., 5.};
+  auto filename_a = temp_filename("fused_a");
+  auto filename_b = temp_filename("fused_b");
+  write_file(filename_a, a);
+
+  {
+    gt::fusion_scope fs;
+    gt::file_source<double, 1> src(filename_a, a.shape());
+    gt::file_sink<double, 1> sink(filename_b, a.shape());
+    // the chunks are evaluated right away, rather than being deferred
+    gt::stream_eval(
+      sink, 2, [](auto& a) { return 2. * a; }, src);
+  }
+  EXPECT_EQ((read_file<double, 1>(filename_b, a.shape())),
+            (gt::gtensor<double, 1>{2., 4., 6., 8., 10.}));
+
+  std::remove(filename_a.c_str());
+  std::remove(filename_b.c_str());
+}
@@ -0,0 +1,88 @@
+
+#include <gtest/gtest.h>
+
+#include <gtensor/gtensor.h>
+#include <gtensor/temporal_blocking.h>
+
+#include <cmath>
+#include <utility>
+
+using namespace gt::placeholders;
+
+// reference: one full sweep per step
+template <typename T, int N, typename F>
+gt::gtensor<T, N> plain_sweeps(gt::gtensor<T, N> u, int steps, F update)
+{
+  gt::gtensor<T, N> v = u;
+  for (int s = 0; s < steps; s++) {
+    auto in = u.to_kernel();
+    auto out = v.to_kernel();
+    update(out, in);
+    std::swap(u, v);
+  }
+  return u;
+}
+
+TEST(temporal_blocking, diffusion_1d)
+{
+  auto diffuse = [](auto& out, const auto& in) {
+    out.view(_s(1, -1)) = .25 * in.view(_s(_, -2)) + .5 * in.view(_s(1, -1)) +
+                          .25 * in.view(_s(2, _));
+  };
+
+  gt::gtensor<double, 1> u0(gt::shape(50));
+  for (int i = 0; i < u0.shape(0); i++) {
+    u0(i) = std::sin(.3 * i) + (i % 7);
+  }
+  auto ref = plain_sweeps(u0, 13, diffuse);
+
+  for (int tile : {0, 1, 7, 50}) {
+    for (int block_steps : {1, 4, 13, 20}) {
+      gt::gtensor<double, 1> u = u0;
+      gt::temporal_sweep(u, 13, 1, diffuse, block_steps, tile);
+      EXPECT_EQ(u, ref) << "tile " << tile << " block_steps " << block_steps;
+    }
+  }
+}
+
+TEST(temporal_blocking, stencil_radius_2)
+{
+  gt::sarray<double, 5> c(.1, .2, .4, .2, .1);
+  auto smooth = [&](auto& out, const auto& in) {
+    out.view(_s(2, -2)) = gt::stencil(in, c);
+  };
+
+  gt::gtensor<double, 1> u0(gt::shape(40));
+  for (int i = 0; i < u0.shape(0); i++) {
+    u0(i) = i * i % 11;
+  }
+  auto ref = plain_sweeps(u0, 9, smooth);
+
+  gt::gtensor<double, 1> u = u0;
+  gt::temporal_sweep(u, 9, 2, smooth, 3, 6);
+  EXPECT_EQ(u, ref);
+}
+
+TEST(temporal_blocking, jacobi_2d_launch)
+{
+  auto jacobi = [](auto& out, const auto& in) {
+    gt::launch_host<2>(gt::shape(in.shape(0) - 2, in.shape(1) - 2),
+                       [&](int i, int j) {
+                         out(i + 1, j + 1) =
+                           .25 * (in(i, j + 1) + in(i + 2, j + 1) +
+                                  in(i + 1, j) + in(i + 1, j + 2));
+                       });
+  };
+
+  gt::gtensor<double, 2> u0(gt::shape(6, 30));
+  for (int j = 0; j < u0.shape(1); j++) {
+    for (int i = 0; i < u0.shape(0); i++) {
+      u0(i, j) = (i == 0 || j == 0) ? 1. : .1 * ((i * 3 + j * 5) % 4);
+    }
+  }
+  auto ref = plain_sweeps(u0, 10, jacobi);
+
+  gt::gtensor<double, 2> u = u0;
+  gt::temporal_sweep(u, 10, 1, jacobi, 3, 5);
+  EXPECT_EQ(u, ref);
+}
@@ -15,6 +15,20 @@ TEST(view, slice_all)
   EXPECT_EQ(b2, a);
 }
 
+TEST(view, slice_descs)
+{
+  gt::gtensor<double, 2> a = {{11., 12., 13.}, {21., 22., 23.}};
+
+  // runtime descriptors and per-argument dispatch give the same view
+  std::vector<gt::gdesc> descs = {gt::all(), gt::newaxis(), 1};
+  auto b = gt::view<2>(a, descs);
+  auto b2 = a.view(gt::all(), _newaxis, 1);
+  EXPECT_EQ(b.shape(), gt::shape(3, 1));
+  EXPECT_EQ(b2.shape(), gt::shape(3, 1));
+  EXPECT_EQ(b, (gt::gtensor<double, 2>{{21., 22., 23.}}));
+  EXPECT_EQ(b2, (gt::gtensor<double, 2>{{21., 22., 23.}}));
+}
+
 TEST(view, slice_value)
 {
   gt::gtensor<double, 2> a = {{11., 12., 13.}, {21., 22., 23.}};
@@ -63,6 +77,54 @@ TEST(view, slice_range)
   EXPECT_EQ(a1.view(_s(_, _, -2)), (gt::gtensor<double, 1>{4., 2., 0.}));
 }
 
+TEST(view, slice_single_broadcast)
+{
+  gt::gtensor<double, 2> a = {{11., 12., 13.}, {21., 22., 23.}};
+
+  // a slice with a single element has stride 0, as calc_strides gives an
+  // extent 1 dimension, so that it broadcasts like one
+  auto row = a.view(_s(1, 2), _all);
+  EXPECT_EQ(row.shape(), gt::shape(1, 2));
+  EXPECT_EQ(row.strides(), gt::shape(0, 3));
+  EXPECT_EQ(a.view(_s(2, 1, -1), _s(1, 2)).strides(), gt::shape(0, 0));
+
+  gt::gtensor<double, 2> z(gt::shape(3, 2));
+  EXPECT_EQ(row + z,
+            (gt::gtensor<double, 2>{{12., 12., 12.}, {22., 22., 22.}}));
+  gt::gtensor<double, 2> b = {{1., 2., 3.}, {4., 5., 6.}};
+  EXPECT_EQ(a.view(_s(1, 2), _s(0, 1)) + b,
+            (gt::gtensor<double, 2>{{13., 14., 15.}, {16., 17., 18.}}));
+
+  // writes through the view reach the one element
+  row = gt::gtensor<double, 2>{{-12.}, {-22.}};
+  EXPECT_EQ(a, (gt::gtensor<double, 2>{{11., -12., 13.}, {21., -22., 23.}}));
+}
+
+#if GTENSOR_BOUNDSCHECK_LEVEL >= 1
+
+TEST(view, slice_out_of_range)
+{
+  gt::gtensor<double, 1> a1 = {0., 1., 2., 3., 4.};
+
+  EXPECT_THROW(a1.view(5), std::runtime_error);
+  EXPECT_THROW(a1.view(-1), std::runtime_error);
+  EXPECT_THROW(a1.view(_s(-7, 2)), std::runtime_error);
+  EXPECT_THROW(a1.view(_s(5, 1, -1)), std::runtime_error);
+  EXPECT_THROW(a1.view(_s(4, -7, -1)), std::runtime_error);
+}
+
+TEST(view, assign_shape_mismatch)
+{
+  gt::gtensor<double, 2> a(gt::shape(3, 2));
+  gt::gtensor<double, 2> b(gt::shape(2, 2));
+  gt::gtensor<double, 2> c(gt::shape(1, 2));
+
+  EXPECT_THROW(a.view(_all, _all) = b, std::runtime_error);
+  EXPECT_NO_THROW(a.view(_all, _all) = c);
+}
+
+#endif
+
 TEST(view, slice_missing)
 {
   gt::gtensor<double, 2> a = {{11., 12., 13.}, {21., 22., 23.}};
@@ -90,6 +152,16 @@ TEST(view, reshape_view)
   EXPECT_EQ(b, (gt::gtensor<double, 2>{{11., 12.}, {13., 21.}, {22., 23.}}));
 }
 
+TEST(view, reshape_expression)
+{
+  gt::gtensor<double, 2> a = {{11., 12., 13.}, {21., 22., 23.}};
+
+  auto b = gt::reshape<2>(a + a, {2, 3});
+  EXPECT_EQ(b, (gt::gtensor<double, 2>{{22., 24.}, {26., 42.}, {44., 46.}}));
+  auto c = gt::view(a + a, _s(1, 3), 1);
+  EXPECT_EQ(c, (gt::gtensor<double, 1>{44., 46.}));
+}
+
 TEST(gview, ownership)
 {
   gt::gtensor<double, 2> a = {{11., 12., 13.}, {21., 22., 23.}};
@@ -98,6 +170,103 @@ TEST(gview, ownership)
   EXPECT_EQ(b, (gt::gtensor<double, 2>{{11., 12., 13.}, {21., 22., 23.}}));
 }
 
+TEST(gview, view_of_view)
+{
+  gt::gtensor<double, 2> a = {{11., 12., 13.}, {21., 22., 23.}};
+
+  auto b = a.view(_s(1, 3), _all);
+  auto c = b.view(_all, 1);
+  // folded into a single view of a
+  gt::assert_is_same<decltype(c), gt::gview<gt::gtensor<double, 2>&, 1>>();
+  EXPECT_EQ(c, (gt::gtensor<double, 1>{22., 23.}));
+
+  c(1) = 99.;
+  EXPECT_EQ(a, (gt::gtensor<double, 2>{{11., 12., 13.}, {21., 22., 99.}}));
+
+  auto d = a.view(_s(_, _, -1), _newaxis, _all).view(_s(1, _), 0, 1);
+  gt::assert_is_same<decltype(d), gt::gview<gt::gtensor<double, 2>&, 1>>();
+  EXPECT_EQ(d, (gt::gtensor<double, 1>{22., 21.}));
+}
+
+TEST(gview, view_of_view_ownership)
+{
+  gt::gtensor<double, 2> a = {{11., 12., 13.}, {21., 22., 23.}};
+
+  auto b = std::move(a).view(_all, 1).view(_s(1, _));
+  gt::assert_is_same<decltype(b), gt::gview<gt::gtensor<double, 2>, 1>>();
+  EXPECT_EQ(b, (gt::gtensor<double, 1>{22., 23.}));
+
+  auto c = b.view(1);
+  gt::assert_is_same<decltype(c), gt::gview<gt::gtensor<double, 2>&, 0>>();
+}
+
+TEST(gview, assign_overlap)
+{
+  gt::gtensor<double, 1> a = {1., 2., 3., 4., 5.};
+
+  // reads behind the write position, needs reverse traversal
+  a.view(_s(1, _)) = a.view(_s(_, -1));
+  EXPECT_EQ(a, (gt::gtensor<double, 1>{1., 1., 2., 3., 4.}));
+
+  // reads ahead of the write position
+  a.view(_s(_, -1)) = a.view(_s(1, _));
+  EXPECT_EQ(a, (gt::gtensor<double, 1>{1., 2., 3., 4., 4.}));
+
+  // reads both behind and ahead, needs a temporary
+  a = {1., 2., 3., 4., 5.};
+  a.view(_s(1, -1)) = a.view(_s(_, -2)) + a.view(_s(2, _));
+  EXPECT_EQ(a, (gt::gtensor<double, 1>{1., 4., 6., 8., 5.}));
+
+  // reversed
+  a = {1., 2., 3., 4., 5.};
+  a.view(_all) = a.view(_s(_, _, -1));
+  EXPECT_EQ(a, (gt::gtensor<double, 1>{5., 4., 3., 2., 1.}));
+
+  a.view(_s(1, _)) += a.view(_s(_, -1));
+  EXPECT_EQ(a, (gt::gtensor<double, 1>{5., 9., 7., 5., 3.}));
+}
+
+TEST(gview, assign_overlap_2d)
+{
+  gt::gtensor<double, 2> a = {{11., 12.}, {21., 22.}};
+
+  a.view(_all, _all) = gt::transpose(a, {1, 0});
+  EXPECT_EQ(a, (gt::gtensor<double, 2>{{11., 21.}, {12., 22.}}));
+
+  a.view(_all, _s(1, _)) = a.view(_all, _s(_, -1));
+  EXPECT_EQ(a, (gt::gtensor<double, 2>{{11., 21.}, {11., 21.}}));
+}
+
+TEST(gview, assign_overlap_3d)
+{
+  gt::gtensor<double, 3> a(gt::shape(4, 3, 5));
+  for (int i = 0; i < int(a.size()); i++) {
+    a.data()[i] = i;
+  }
+  gt::gtensor<double, 3> ref = a;
+  gt::gtensor<double, 3> b = a;
+  ref.view(_s(1, _), _s(1, _), _s(1, _)) =
+    b.view(_s(_, -1), _s(_, -1), _s(_, -1)) + 1.;
+
+  // reads behind the write position along every dimension
+  a.view(_s(1, _), _s(1, _), _s(1, _)) =
+    a.view(_s(_, -1), _s(_, -1), _s(_, -1)) + 1.;
+  for (int i = 0; i < int(a.size()); i++) {
+    EXPECT_EQ(a.data()[i], ref.data()[i]) << "at " << i;
+  }
+}
+
+TEST(gview, noalias)
+{
+  gt::gtensor<double, 2> a = {{11., 12., 13.}, {21., 22., 23.}};
+  gt::gtensor<double, 2> b(a.shape());
+
+  gt::noalias(b) = 2. * a;
+  EXPECT_EQ(b, (gt::gtensor<double, 2>{{22., 24., 26.}, {42., 44., 46.}}));
+  gt::noalias(b.view(_all, 0)) = a.view(_all, 1);
+  EXPECT_EQ(b, (gt::gtensor<double, 2>{{21., 22., 23.}, {42., 44., 46.}}));
+}
+
 TEST(gview, assign_all)
 {
   gt::gtensor<double, 2> a{{11., 12., 13.}, {21., 22., 23.}};